@@ -0,0 +1,337 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <CCA/Components/DataArchiver/AsyncOutputWriter.h>
+
+#include <Core/DataArchive/DataArchive.h>
+#include <Core/Exceptions/ErrnoException.h>
+#include <Core/Parallel/Parallel.h>
+#include <Core/Util/DOUT.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <unistd.h>
+#include <vector>
+
+using namespace Uintah;
+
+namespace {
+  Dout g_async_output_dbg( "AsyncOutput", "DataArchiver", "report asynchronous output queue activity", false );
+}
+
+//______________________________________________________________________
+//
+AsyncOutputWriter::AsyncOutputWriter( size_t memoryBudget, MasterLock & xmlLock )
+  : m_memoryBudget( memoryBudget )
+  , m_xmlLock( xmlLock )
+{
+  m_thread = std::thread( &AsyncOutputWriter::run, this );
+}
+
+//______________________________________________________________________
+//
+AsyncOutputWriter::~AsyncOutputWriter()
+{
+  {
+    std::lock_guard<std::mutex> guard( m_mutex );
+    m_stop = true;
+  }
+  m_workReady.notify_all();
+
+  if( m_thread.joinable() ) {
+    m_thread.join();
+  }
+
+  if( m_error ) {
+    try {
+      std::rethrow_exception( m_error );
+    }
+    catch( const Exception & e ) {
+      std::cerr << "AsyncOutputWriter: output was not completely written: " << e.message() << "\n";
+    }
+    catch( ... ) {
+      std::cerr << "AsyncOutputWriter: output was not completely written.\n";
+    }
+  }
+}
+
+//______________________________________________________________________
+//
+void
+AsyncOutputWriter::enqueue( Job && job )
+{
+  const size_t bytes = job.data.size();
+
+  std::unique_lock<std::mutex> lock( m_mutex );
+
+  rethrowError();
+
+  if( m_bytesPending > 0 && m_bytesPending + bytes > m_memoryBudget ) {
+    DOUT( g_async_output_dbg, "Rank-" << Parallel::getMPIRank() << " AsyncOutputWriter: "
+          << m_bytesPending << " bytes pending, waiting to queue "
+          << bytes << " bytes for " << job.dataFilename );
+
+    m_spaceFreed.wait( lock, [&]{ return m_bytesPending == 0 ||
+                                         m_bytesPending + bytes <= m_memoryBudget || m_error; } );
+    rethrowError();
+  }
+
+  m_bytesPending += bytes;
+  m_queue.push_back( std::move( job ) );
+
+  lock.unlock();
+  m_workReady.notify_one();
+}
+
+//______________________________________________________________________
+//
+void
+AsyncOutputWriter::drain()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+
+  m_spaceFreed.wait( lock, [&]{ return m_bytesPending == 0; } );
+
+  rethrowError();
+}
+
+//______________________________________________________________________
+// Called with m_mutex held. The error is reported once.
+void
+AsyncOutputWriter::rethrowError()
+{
+  if( m_error ) {
+    std::exception_ptr error = m_error;
+    m_error = nullptr;
+    std::rethrow_exception( error );
+  }
+}
+
+//______________________________________________________________________
+//
+void
+AsyncOutputWriter::run()
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+
+  while( true ) {
+    m_workReady.wait( lock, [&]{ return m_stop || !m_queue.empty(); } );
+
+    if( m_queue.empty() ) {  // m_stop and nothing left to write
+      break;
+    }
+
+    Job job = std::move( m_queue.front() );
+    m_queue.pop_front();
+
+    const size_t bytes = job.data.size();
+
+    // Once a write failed, the remaining files are discarded so that
+    // the producers blocked on the budget are released.
+    if( !m_error ) {
+      lock.unlock();
+      try {
+        write( job, m_xmlLock );
+      }
+      catch( ... ) {
+        lock.lock();
+        m_error = std::current_exception();
+        lock.unlock();
+      }
+      lock.lock();
+    }
+
+    m_bytesPending -= bytes;
+    m_spaceFreed.notify_all();
+  }
+}
+
+//______________________________________________________________________
+//
+void
+AsyncOutputWriter::write( Job & job, MasterLock & xmlLock )
+{
+  // Same retry policy as the synchronous path, see
+  // DataArchiver::outputVariables.
+  const char * filename = job.dataFilename.c_str();
+  const int    flags    = O_WRONLY|O_CREAT|O_TRUNC;
+
+  int tries = 1;
+  int fd    = open( filename, flags, 0666 );
+
+  while( fd == -1 ) {
+    if( tries >= 50 ) {
+      std::ostringstream msg;
+      msg << "AsyncOutputWriter::write(): Failed to open file '" << job.dataFilename << "' (after 50 tries).";
+      throw ErrnoException( msg.str(), errno, __FILE__, __LINE__ );
+    }
+    fd = open( filename, flags, 0666 );
+    tries++;
+  }
+
+  const char * data      = job.data.data();
+  size_t       remaining = job.data.size();
+
+  while( remaining > 0 ) {
+    ssize_t s = ::write( fd, data, remaining );
+
+    if( s == -1 ) {
+      if( errno == EINTR ) {
+        continue;
+      }
+      int err = errno;
+      close( fd );
+      throw ErrnoException( "AsyncOutputWriter::write (write call) " + job.dataFilename, err, __FILE__, __LINE__ );
+    }
+    data      += s;
+    remaining -= s;
+  }
+
+  if( close( fd ) == -1 ) {
+    throw ErrnoException( "AsyncOutputWriter::write (close call) " + job.dataFilename, errno, __FILE__, __LINE__ );
+  }
+
+  // Release the data before the (slow) xml output.
+  std::string().swap( job.data );
+
+  std::lock_guard<MasterLock> guard( xmlLock );
+  job.doc->output( job.xmlFilename.c_str() );
+  if( job.binaryIndex ) {
+    writeIndex( job.doc, job.indexFilename );
+  }
+  else {
+    removeIndex( job.indexFilename );
+  }
+  job.doc = nullptr;
+}
+
+//______________________________________________________________________
+//
+void
+AsyncOutputWriter::removeIndex( const std::string & filename )
+{
+  if( !filename.empty() && unlink( filename.c_str() ) == -1 && errno != ENOENT ) {
+    throw ErrnoException( "AsyncOutputWriter::removeIndex (unlink call) " + filename, errno, __FILE__, __LINE__ );
+  }
+}
+
+//______________________________________________________________________
+//
+void
+AsyncOutputWriter::writeIndex( const ProblemSpecP & doc, const std::string & filename )
+{
+  std::map<std::string, int>            stringIds;
+  std::vector<const std::string*>       strings;
+  std::vector<DataArchive::IndexEntry>  entries;
+
+  auto intern = [&]( const std::string & str ) {
+    auto iter = stringIds.emplace( str, (int) strings.size() ).first;
+    if( iter->second == (int) strings.size() ) {
+      strings.push_back( &iter->first );
+    }
+    return iter->second;
+  };
+
+  for( ProblemSpecP vnode = doc->findBlock( "Variable" ); vnode != nullptr; vnode = vnode->findNextBlock( "Variable" ) ) {
+    std::string varname, type, compression, dataFilename;
+    int         matl, patch;
+    long        start, end;
+    int         numParticles = -1;
+    IntVector   boundary( 0, 0, 0 );
+
+    vnode->get( "variable", varname );
+    vnode->get( "index",    matl );
+    vnode->get( "patch",    patch );
+    vnode->get( "start",    start );
+    vnode->get( "end",      end );
+    vnode->get( "filename", dataFilename );
+    vnode->getAttribute( "type", type );
+
+    DataArchive::IndexEntry entry;
+    entry.variable     = intern( varname );
+    entry.type         = intern( type );
+    entry.compression  = vnode->get( "compression", compression ) && compression != "" ? intern( compression ) : -1;
+    entry.filename     = intern( dataFilename );
+    entry.matl         = matl;
+    entry.patch        = patch;
+    entry.start        = start;
+    entry.end          = end;
+
+    vnode->get( "numParticles",  numParticles );
+    vnode->get( "boundaryLayer", boundary );
+    entry.numParticles = numParticles;
+    for( int i = 0; i < 3; ++i ) {
+      entry.boundaryLayer[i] = boundary[i];
+    }
+
+    entries.push_back( entry );
+  }
+
+  // Assembled in memory and written with a single call.
+  std::string buffer;
+  auto putUInt = [&]( unsigned int value ) { buffer.append( (const char*) &value, sizeof(value) ); };
+
+  putUInt( DataArchive::INDEX_MAGIC_NUMBER );
+  putUInt( DataArchive::INDEX_VERSION );
+
+  putUInt( strings.size() );
+  for( const std::string * str : strings ) {
+    putUInt( str->size() );
+    buffer.append( *str );
+  }
+
+  putUInt( entries.size() );
+  buffer.append( (const char*) entries.data(), entries.size() * sizeof(DataArchive::IndexEntry) );
+
+  int fd = open( filename.c_str(), O_WRONLY|O_CREAT|O_TRUNC, 0666 );
+  if( fd == -1 ) {
+    throw ErrnoException( "AsyncOutputWriter::writeIndex (open call) " + filename, errno, __FILE__, __LINE__ );
+  }
+
+  const char * data      = buffer.data();
+  size_t       remaining = buffer.size();
+
+  while( remaining > 0 ) {
+    ssize_t s = ::write( fd, data, remaining );
+
+    if( s == -1 ) {
+      if( errno == EINTR ) {
+        continue;
+      }
+      int err = errno;
+      close( fd );
+      throw ErrnoException( "AsyncOutputWriter::writeIndex (write call) " + filename, err, __FILE__, __LINE__ );
+    }
+    data      += s;
+    remaining -= s;
+  }
+
+  if( close( fd ) == -1 ) {
+    throw ErrnoException( "AsyncOutputWriter::writeIndex (close call) " + filename, errno, __FILE__, __LINE__ );
+  }
+}
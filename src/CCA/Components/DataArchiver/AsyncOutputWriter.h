@@ -0,0 +1,136 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef UINTAH_HOMEBREW_AsyncOutputWriter_H
+#define UINTAH_HOMEBREW_AsyncOutputWriter_H
+
+#include <Core/Parallel/MasterLock.h>
+#include <Core/ProblemSpec/ProblemSpec.h>
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Uintah {
+
+  /**************************************
+
+     CLASS
+       AsyncOutputWriter
+
+       Drains serialized output and checkpoint files to disk from a
+       dedicated I/O thread.
+
+     DESCRIPTION
+       DataArchiver::outputVariables serializes the saved variables of
+       a level into memory, hands the bytes plus the matching per-rank
+       xml document to enqueue() and returns to the task graph. The
+       writer thread then writes the data file and the xml file while
+       the following time steps run.
+
+       The bytes held in the queue (including the file currently being
+       written) are bounded by the memory budget. enqueue() blocks
+       while adding a file would exceed it, so a simulation that
+       produces data faster than the file system absorbs it is slowed
+       down to the file system rate instead of running out of memory.
+       A single file larger than the budget is still accepted when the
+       queue is empty.
+
+     WARNING
+       The xml documents are written and released while holding the
+       lock handed to the constructor, the same lock DataArchiver
+       holds while building them.
+
+       An error on the writer thread is rethrown from the next call
+       to enqueue() or drain().
+
+  ****************************************/
+
+  class AsyncOutputWriter {
+
+  public:
+
+    struct Job {
+      std::string  dataFilename;  // full path of the pNNNNN.data file
+      std::string  data;          // file contents, padding included
+      std::string  xmlFilename;   // full path of the pNNNNN.xml file
+      ProblemSpecP doc;           // xml document describing 'data'
+      std::string  indexFilename; // full path of the pNNNNN.idx file
+      bool         binaryIndex {false};  // write it, else remove a stale one
+    };
+
+    AsyncOutputWriter( size_t memoryBudget, MasterLock & xmlLock );
+
+    // Writes everything still queued before joining the I/O thread.
+    ~AsyncOutputWriter();
+
+    // Queue a file for writing. Blocks while the queue is over budget.
+    void enqueue( Job && job );
+
+    // Block until every queued file is on disk.
+    void drain();
+
+    size_t getMemoryBudget() const { return m_memoryBudget; }
+
+    // Writes a job on the calling thread; the xml document is output
+    // and released while holding xmlLock.
+    static void write( Job & job, MasterLock & xmlLock );
+
+    // Writes the binary index (see DataArchive::INDEX_MAGIC_NUMBER)
+    // of the variables listed in doc. The caller holds the xml lock.
+    static void writeIndex( const ProblemSpecP & doc, const std::string & filename );
+
+    // Removes an index left by an earlier run with <binaryIndex>, which
+    // readers would otherwise prefer to the new xml file.
+    static void removeIndex( const std::string & filename );
+
+  private:
+
+    void run();
+    void rethrowError();
+
+    const size_t  m_memoryBudget;
+    MasterLock  & m_xmlLock;
+
+    std::mutex              m_mutex;
+    std::condition_variable m_workReady;   // signaled on enqueue and stop
+    std::condition_variable m_spaceFreed;  // signaled when a file is written
+
+    std::deque<Job>    m_queue;
+    size_t             m_bytesPending {0};  // queued plus being written
+    bool               m_stop {false};
+    std::exception_ptr m_error {nullptr};
+
+    std::thread m_thread;
+
+    AsyncOutputWriter( const AsyncOutputWriter & );
+    AsyncOutputWriter& operator=( const AsyncOutputWriter & );
+  };
+
+} // End namespace Uintah
+
+#endif
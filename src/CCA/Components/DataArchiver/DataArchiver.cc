@@ -41,6 +41,7 @@
 #include <Core/Grid/Patch.h>
 #include <Core/Grid/Task.h>
 #include <Core/Grid/Variables/VarTypes.h>
+#include <Core/Grid/Variables/VariableCodec.h>
 #include <Core/Parallel/Parallel.h>
 #include <Core/Parallel/ProcessorGroup.h>
 #include <Core/ProblemSpec/ProblemSpec.h>
@@ -55,7 +56,9 @@
 
 #include <sci_defs/visit_defs.h>
 
+#include <algorithm>
 #include <cerrno>
+#include <climits>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
@@ -77,12 +80,16 @@
 //       getMaterialSet(0)
 
 #define PADSIZE    1024L
+#define AGGREGATE_CHUNK  ( size_t(64) << 20 )
 #define ALL_LEVELS   99
 
 #define OUTPUT            0
 #define CHECKPOINT        1
 #define CHECKPOINT_GLOBAL 2
 
+// Messages of the output aggregation, see aggregateBegin.
+enum { AGGREGATE_BEGIN, AGGREGATE_DATA, AGGREGATE_DOC, AGGREGATE_DONE };
+
 #define XML_TEXTWRITER 1
 #undef  XML_TEXTWRITER
 
@@ -134,6 +141,13 @@ DataArchiver::DataArchiver(const ProcessorGroup* myworld, int udaSuffix)
 
 DataArchiver::~DataArchiver()
 {
+  // Flushes whatever is still queued.
+  delete m_asyncWriter;
+
+  if( m_aggregateComm != MPI_COMM_NULL ) {
+    Uintah::MPI::Comm_free( &m_aggregateComm );
+  }
+
   VarLabel::destroy( m_sync_io_label );
 
   if(m_tmpMatSubset && m_tmpMatSubset->removeReference()) {
@@ -294,10 +308,20 @@ DataArchiver::problemSetup( const ProblemSpecP    & params,
     m_outputLastTimeStep = false; // default
   }
 
-  // set default compression mode - can be "gzip" or ""
+  // set default compression mode - "" or a VariableCodec, e.g. "gzip"
   string defaultCompressionMode = "";
   if (p->get("compression", defaultCompressionMode)) {
+    VariableCodec::find(defaultCompressionMode);  // throws if unknown
     VarLabel::setDefaultCompressionMode(defaultCompressionMode);
+
+    // Threads each variable's chunks are (de)compressed with.
+    int compressionThreads = 1;
+    if (p->findBlock("compression")->getAttribute("threads", compressionThreads)) {
+      if (compressionThreads < 1) {
+        throw ProblemSetupException("<compression threads> must be positive", __FILE__, __LINE__);
+      }
+      VariableCodec::setNumThreads(compressionThreads);
+    }
   }
 
   if (params->findBlock("ParticlePosition")) {
@@ -326,6 +350,7 @@ DataArchiver::problemSetup( const ProblemSpecP    & params,
     save->getAttributes(attributes);
     saveItem.labelName       = attributes["label"];
     saveItem.compressionMode = attributes["compression"];
+    VariableCodec::find(saveItem.compressionMode);  // throws if unknown
     
     try {
       saveItem.matls = ConsecutiveRangeSet(attributes["material"]);
@@ -460,6 +485,112 @@ DataArchiver::problemSetup( const ProblemSpecP    & params,
                                 __FILE__, __LINE__);
   }
 
+  //__________________________________
+  // Write the output and checkpoint files from a background thread so
+  // the time steps that follow overlap the file system. The budget
+  // bounds the serialized bytes waiting to be written per rank.
+  ProblemSpecP async_ps = p->findBlock( "asyncOutput" );
+
+  if( async_ps != nullptr && m_asyncWriter == nullptr ) {
+    double budgetMB = 1024.0;
+    async_ps->getAttribute( "memoryBudgetMB", budgetMB );
+
+    if( budgetMB <= 0.0 ) {
+      throw ProblemSetupException( "<asyncOutput memoryBudgetMB> must be positive", __FILE__, __LINE__ );
+    }
+
+    if( m_outputFileFormat == PIDX ) {
+      proc0cout << "WARNING: <asyncOutput> is not supported with PIDX, "
+                << "only checkpoint global variables are written asynchronously.\n";
+    }
+
+    m_asyncWriter = scinew AsyncOutputWriter( (size_t) (budgetMB * 1024 * 1024), m_outputLock );
+
+    proc0cout << "Output:" << std::setw(23) << " Asynchronous, "
+              << budgetMB << " MB budget per rank.\n";
+  }
+
+  //__________________________________
+  // DataArchive reads the binary index instead of the xml, which
+  // dominates opening a time step with many patches.
+  m_binaryIndex = ( p->findBlock( "binaryIndex" ) != nullptr );
+
+  if( m_binaryIndex ) {
+    proc0cout << "Output:" << std::setw(23) << " Binary variable index.\n";
+  }
+
+  //__________________________________
+  // Group the ranks so that each group writes one data and one xml
+  // file per level instead of one per rank. The group's lowest rank
+  // writes the variables of the others as they are serialized.
+  ProblemSpecP agg_ps = p->findBlock( "outputAggregation" );
+
+  if( agg_ps != nullptr && m_aggregateComm == MPI_COMM_NULL ) {
+
+    if( m_outputFileFormat == PIDX ) {
+      throw ProblemSetupException( "<outputAggregation> is not supported with PIDX", __FILE__, __LINE__ );
+    }
+
+    if( m_asyncWriter != nullptr ) {
+      proc0cout << "WARNING: <asyncOutput> is not used with <outputAggregation>, the aggregators "
+                << "write the level files as the data arrives; only checkpoint global variables "
+                << "are written asynchronously.\n";
+    }
+
+    string ranksPerFile = "node";
+    agg_ps->getAttribute( "ranksPerFile", ranksPerFile );
+
+    const int myRank = d_myworld->myRank();
+
+    if( ranksPerFile == "node" ) {
+      // Ranks on the same host share the color of the host's lowest rank.
+      char name[ MPI_MAX_PROCESSOR_NAME ] = { 0 };
+      int  length;
+      Uintah::MPI::Get_processor_name( name, &length );
+
+      vector<char> names( (size_t) MPI_MAX_PROCESSOR_NAME * d_myworld->nRanks() );
+      Uintah::MPI::Allgather( name, MPI_MAX_PROCESSOR_NAME, MPI_CHAR,
+                              names.data(), MPI_MAX_PROCESSOR_NAME, MPI_CHAR, d_myworld->getComm() );
+
+      int color = 0;
+      while( strncmp( &names[ (size_t) color * MPI_MAX_PROCESSOR_NAME ], name, MPI_MAX_PROCESSOR_NAME ) != 0 ) {
+        ++color;
+      }
+      Uintah::MPI::Comm_split( d_myworld->getComm(), color, myRank, &m_aggregateComm );
+    }
+    else {
+      int groupSize = atoi( ranksPerFile.c_str() );
+      if( groupSize < 1 ) {
+        throw ProblemSetupException( "<outputAggregation ranksPerFile> must be 'node' or a positive integer, not '" +
+                                     ranksPerFile + "'", __FILE__, __LINE__ );
+      }
+      Uintah::MPI::Comm_split( d_myworld->getComm(), myRank / groupSize, myRank, &m_aggregateComm );
+    }
+
+    // Ranks are ordered by world rank, so group rank 0 is the lowest.
+    int aggregator = myRank;
+    Uintah::MPI::Bcast( &aggregator, 1, MPI_INT, 0, m_aggregateComm );
+
+    m_aggregatorOf.resize( d_myworld->nRanks() );
+    Uintah::MPI::Allgather( &aggregator, 1, MPI_INT, m_aggregatorOf.data(), 1, MPI_INT, d_myworld->getComm() );
+
+    // Listed with each aggregator's file in timestep.xml so readers
+    // find the file holding a rank's patches.
+    std::map<int, ConsecutiveRangeSet> groups;
+    for( int rank = 0; rank < d_myworld->nRanks(); ++rank ) {
+      groups[ m_aggregatorOf[ rank ] ].addInOrder( rank );
+    }
+    for( auto & group : groups ) {
+      m_aggregatedRanks[ group.first ] = group.second.toString();
+    }
+
+    int groupSize;
+    Uintah::MPI::Comm_size( m_aggregateComm, &groupSize );
+
+    proc0cout << "Output:" << std::setw(23) << " Aggregated, "
+              << groupSize << " ranks per file on rank 0's group.\n";
+  }
+
   m_lastTimeStepLocation   = "invalid";
   m_isOutputTimeStep       = false;
 
@@ -1130,6 +1261,11 @@ DataArchiver::finalizeTimeStep( const GridP & grid,
   }
   
   m_numLevelsInOutput = grid->numLevels();
+
+  if( m_aggregateComm != MPI_COMM_NULL ) {
+    m_aggregateScheduler = sched.get_rep();
+    setAggregateNoScrubVars();
+  }
   
 #if SCI_ASSERTION_LEVEL >= 2
   m_outputCalled.clear();
@@ -1265,6 +1401,19 @@ DataArchiver::setCheckpointTimeStep( bool val, const GridP& grid )
       makeTimeStepDirs( m_checkpointsDir, m_checkpointLabels, grid, &timestepDir );
       m_checkpointTimeStepDirs.push_back( timestepDir );
 
+      // With asynchronous output at most one checkpoint is in
+      // flight: the previous one must be on disk before this one
+      // starts. The expired checkpoint removed below is then complete
+      // on every rank, except with a cycle of one where it is the
+      // previous checkpoint itself.
+      if( m_asyncWriter ) {
+        m_asyncWriter->drain();
+
+        if( m_checkpointCycle == 1 ) {
+          Uintah::MPI::Barrier( d_myworld->getComm() );
+        }
+      }
+
       string iname = m_checkpointsDir.getName() + "/index.xml";
       
       ProblemSpecP index;
@@ -1672,6 +1821,8 @@ DataArchiver::recompute_OutputCheckPointTimeStep()
     }
   }
 
+  setAggregateNoScrubVars();
+
 #if SCI_ASSERTION_LEVEL >= 2
   m_outputCalled.clear();
   m_outputCalled.resize(m_numLevelsInOutput, false);
@@ -1697,6 +1848,9 @@ DataArchiver::writeto_xml_files( const GridP& grid )
     }
     return;
   }
+
+  // All of the output tasks have run, write the aggregated files.
+  flushAggregatedOutput();
   
   double simTime = m_application->getSimTime();
   double delT    = m_application->getDelT();
@@ -2021,6 +2175,359 @@ DataArchiver::writeto_xml_files( const GridP& grid )
   }
 } // end writeto_xml_files()
 
+//______________________________________________________________________
+//
+int
+DataArchiver::getOutputFileRank( const Patch * patch )
+{
+  int rank = m_loadBalancer->getOutputRank( patch );
+
+  if( m_aggregateComm != MPI_COMM_NULL ) {
+    rank = m_aggregatorOf[ rank ];
+  }
+  return rank;
+}
+
+//______________________________________________________________________
+// The output tasks only recorded their patches and data warehouses,
+// see outputVariables. Each rank runs them again here, level by
+// level, and passes the serialized variables to the aggregator at
+// most AGGREGATE_CHUNK bytes at a time. The aggregator writes the
+// chunks into the group's data files as they arrive from any sender,
+// in between serializing its own, so the senders serialize and
+// compress concurrently and neither side holds more than a chunk of
+// the output. The pxxxxx.xml entries written by outputVariables
+// already name the aggregator's data file; their offsets are mapped
+// to where each chunk was placed.
+void
+DataArchiver::flushAggregatedOutput()
+{
+  if( m_aggregateComm == MPI_COMM_NULL ) {
+    return;
+  }
+
+  Timers::Simple timer;
+  timer.start();
+
+  std::map< std::pair<int, int>, AggregateOutput > pending;
+
+  m_outputLock.lock();
+  pending.swap( m_aggregatePending );
+  m_outputLock.unlock();
+
+  m_aggregateFlushing = true;
+
+  for( auto & entry : pending ) {
+    PatchSubset * patches = scinew PatchSubset( entry.second.patches );
+    patches->addReference();
+
+    outputVariables( d_myworld, patches, nullptr, entry.second.old_dw, entry.second.new_dw, entry.first.first );
+
+    if( patches->removeReference() ) {
+      delete patches;
+    }
+  }
+
+  m_aggregateFlushing = false;
+
+  const int myRank = d_myworld->myRank();
+
+  //__________________________________
+  // Senders
+  if( m_aggregatorOf[ myRank ] != myRank ) {
+    uint64_t header[4] = { AGGREGATE_DONE, 0, 0, 0 };
+    Uintah::MPI::Send( header, 4, MPI_UINT64_T, 0, 0, m_aggregateComm );
+  }
+
+  //__________________________________
+  // Aggregator
+  else {
+    int groupSize;
+    Uintah::MPI::Comm_size( m_aggregateComm, &groupSize );
+
+    m_outputLock.lock();
+    while( m_aggregateSendersDone < groupSize - 1 ) {
+      aggregateServe( true );
+    }
+    m_aggregateSendersDone = 0;
+
+    for( auto & entry : m_aggregateFiles ) {
+      AggregateFile & file = entry.second;
+
+      if( close( file.fd ) == -1 ) {
+        m_outputLock.unlock();
+        throw ErrnoException( "DataArchiver::flushAggregatedOutput (close call) " + file.dataFilename,
+                              errno, __FILE__, __LINE__ );
+      }
+
+      file.doc->output( file.xmlFilename.c_str() );
+      if( m_binaryIndex ) {
+        AsyncOutputWriter::writeIndex( file.doc, file.indexFilename );
+      }
+      else {
+        AsyncOutputWriter::removeIndex( file.indexFilename );
+      }
+    }
+    m_aggregateFiles.clear();
+    m_aggregateStreams.clear();
+    m_outputLock.unlock();
+  }
+
+  (*m_runtimeStats)[ TotalIOTime ] += timer().seconds();
+}
+
+//______________________________________________________________________
+// The scheduler's no-scrub overrides are fixed when the task graph is
+// compiled, so the variables written by flushAggregatedOutput are kept
+// per time step instead: the saved labels on output time steps and
+// the checkpoint labels on checkpoint time steps, nothing otherwise.
+void
+DataArchiver::setAggregateNoScrubVars()
+{
+  if( m_aggregateScheduler == nullptr ) {
+    return;
+  }
+
+  std::set<std::string> vars;
+
+  if( m_isOutputTimeStep ) {
+    for( const SaveItem & item : m_saveLabels ) {
+      vars.insert( item.label->getName() );
+    }
+  }
+
+  if( m_isCheckpointTimeStep ) {
+    for( const SaveItem & item : m_checkpointLabels ) {
+      vars.insert( item.label->getName() );
+    }
+  }
+
+  m_aggregateScheduler->setTimeStepNoScrubVars( vars );
+}
+
+//______________________________________________________________________
+// The messages a sender passes to its aggregator: a header of
+// { kind, type, level, size } followed, for DATA and DOC, by size
+// bytes of data or xml. The aggregator applies its own output
+// directly, as group rank 0. Called with m_outputLock held.
+void
+DataArchiver::aggregateBegin( int type, int levelIndex )
+{
+  const int myRank = d_myworld->myRank();
+
+  if( m_aggregatorOf[ myRank ] != myRank ) {
+    uint64_t header[4] = { AGGREGATE_BEGIN, (uint64_t) type, (uint64_t) levelIndex, 0 };
+    Uintah::MPI::Send( header, 4, MPI_UINT64_T, 0, 0, m_aggregateComm );
+    return;
+  }
+
+  aggregateOpen( 0, type, levelIndex );
+}
+
+//______________________________________________________________________
+//
+void
+DataArchiver::aggregateData( string & data )
+{
+  const int myRank = d_myworld->myRank();
+
+  if( m_aggregatorOf[ myRank ] != myRank ) {
+    uint64_t header[4] = { AGGREGATE_DATA, 0, 0, data.size() };
+    Uintah::MPI::Send( header, 4, MPI_UINT64_T, 0, 0, m_aggregateComm );
+
+    // Keeps the MPI counts within an int.
+    for( size_t sent = 0; sent < data.size(); sent += AGGREGATE_CHUNK ) {
+      Uintah::MPI::Send( &data[ sent ], (int) std::min( AGGREGATE_CHUNK, data.size() - sent ),
+                         MPI_BYTE, 0, 0, m_aggregateComm );
+    }
+  }
+  else {
+    aggregateWrite( 0, data );
+
+    // Take in what the senders have passed on meanwhile.
+    aggregateServe( false );
+  }
+
+  data.clear();
+}
+
+//______________________________________________________________________
+//
+void
+DataArchiver::aggregateDoc( const ProblemSpecP & doc )
+{
+  const int myRank = d_myworld->myRank();
+
+  if( m_aggregatorOf[ myRank ] != myRank ) {
+    xmlChar * xml     = nullptr;
+    int       xmlSize = 0;
+    xmlDocDumpMemory( doc->getNode()->doc, &xml, &xmlSize );
+
+    uint64_t header[4] = { AGGREGATE_DOC, 0, 0, (uint64_t) xmlSize };
+    Uintah::MPI::Send( header, 4, MPI_UINT64_T, 0, 0, m_aggregateComm );
+    Uintah::MPI::Send( xml, xmlSize, MPI_BYTE, 0, 0, m_aggregateComm );
+
+    xmlFree( xml );
+    return;
+  }
+
+  aggregateMerge( 0, doc );
+}
+
+//______________________________________________________________________
+// Aggregator side. Handles the messages that have arrived, from any
+// sender; with 'wait' it first blocks for one. The messages of one
+// sender arrive in order, and a header is always followed by its
+// data, so each sender's stream is applied as it was sent.
+void
+DataArchiver::aggregateServe( bool wait )
+{
+  string buffer;
+
+  while( true ) {
+    MPI_Status status;
+    int        arrived = 0;
+
+    if( wait ) {
+      Uintah::MPI::Probe( MPI_ANY_SOURCE, 0, m_aggregateComm, &status );
+      arrived = 1;
+      wait    = false;
+    }
+    else {
+      Uintah::MPI::Iprobe( MPI_ANY_SOURCE, 0, m_aggregateComm, &arrived, &status );
+    }
+
+    if( !arrived ) {
+      return;
+    }
+
+    const int source = status.MPI_SOURCE;
+
+    uint64_t header[4];
+    Uintah::MPI::Recv( header, 4, MPI_UINT64_T, source, 0, m_aggregateComm, MPI_STATUS_IGNORE );
+
+    const uint64_t size = header[3];
+
+    if( header[0] == AGGREGATE_DONE ) {
+      ++m_aggregateSendersDone;
+      continue;
+    }
+
+    buffer.resize( size );
+    for( size_t recvd = 0; recvd < size; recvd += AGGREGATE_CHUNK ) {
+      Uintah::MPI::Recv( &buffer[ recvd ], (int) std::min( AGGREGATE_CHUNK, size - recvd ),
+                         MPI_BYTE, source, 0, m_aggregateComm, MPI_STATUS_IGNORE );
+    }
+
+    if( header[0] == AGGREGATE_BEGIN ) {
+      aggregateOpen( source, (int) header[1], (int) header[2] );
+    }
+    else if( header[0] == AGGREGATE_DATA ) {
+      aggregateWrite( source, buffer );
+    }
+    else { // AGGREGATE_DOC
+      ProblemSpecP doc = scinew ProblemSpec( buffer );
+      aggregateMerge( source, doc );
+    }
+  }
+}
+
+//______________________________________________________________________
+// Starts the stream of group rank 'source' into the (type, level) file.
+void
+DataArchiver::aggregateOpen( int source, int type, int levelIndex )
+{
+  AggregateFile & file = m_aggregateFiles[ std::make_pair( type, levelIndex ) ];
+
+  if( file.fd == -1 ) {
+    ostringstream name;
+    name << ( type == OUTPUT ? m_outputDir : m_checkpointsDir ).getName()
+         << "/t" << setw(5) << setfill('0') << getTimeStepTopLevel()
+         << "/l" << levelIndex
+         << "/p" << setw(5) << setfill('0') << d_myworld->myRank();
+
+    file.dataFilename  = name.str() + ".data";
+    file.xmlFilename   = name.str() + ".xml";
+    file.indexFilename = name.str() + ".idx";
+    file.doc           = ProblemSpec::createDocument( "Uintah_Output" );
+
+    file.fd = open( file.dataFilename.c_str(), O_WRONLY|O_CREAT|O_TRUNC, 0666 );
+
+    if( file.fd == -1 ) {
+      throw ErrnoException( "DataArchiver::aggregateOpen: Failed to open file '" + file.dataFilename + "'",
+                            errno, __FILE__, __LINE__ );
+    }
+  }
+
+  AggregateStream & stream = m_aggregateStreams[ source ];
+  stream.file = &file;
+  stream.end  = 0;
+  stream.chunks.clear();
+}
+
+//______________________________________________________________________
+// Places the next chunk of a stream at the end of its file, at the
+// same offset modulo PADSIZE as in the stream so that the variables
+// stay padded as outputVariables laid them out.
+void
+DataArchiver::aggregateWrite( int source, const string & data )
+{
+  if( data.empty() ) {
+    return;
+  }
+
+  AggregateStream & stream = m_aggregateStreams[ source ];
+  AggregateFile   & file   = *stream.file;
+
+  long offset = file.end + ( ( stream.end - file.end ) % PADSIZE + PADSIZE ) % PADSIZE;
+
+  stream.chunks.push_back( std::make_pair( stream.end, offset ) );
+  stream.end += data.size();
+  file.end    = offset + data.size();
+
+  for( size_t written = 0; written < data.size(); ) {
+    ssize_t n = pwrite( file.fd, &data[ written ], data.size() - written, offset + written );
+
+    if( n == -1 && errno != EINTR ) {
+      throw ErrnoException( "DataArchiver::aggregateWrite (pwrite call) " + file.dataFilename,
+                            errno, __FILE__, __LINE__ );
+    }
+    if( n > 0 ) {
+      written += n;
+    }
+  }
+}
+
+//______________________________________________________________________
+// Adds a stream's xml entries to its file's, with their offsets moved
+// from the stream to the file. A variable never spans two chunks.
+void
+DataArchiver::aggregateMerge( int source, const ProblemSpecP & doc )
+{
+  AggregateStream & stream = m_aggregateStreams[ source ];
+  AggregateFile   & file   = *stream.file;
+
+  for( ProblemSpecP var = doc->findBlock( "Variable" ); var != nullptr; var = var->findNextBlock( "Variable" ) ) {
+    ProblemSpecP copy = file.doc->importNode( var, true );
+    file.doc->appendChild( copy );
+
+    long start;
+    copy->findBlock( "start" )->get( start );
+
+    // The chunk holding the variable, the last one starting at or before it.
+    auto chunk = std::upper_bound( stream.chunks.begin(), stream.chunks.end(), std::make_pair( start, LONG_MAX ) );
+    const long shift = ( chunk == stream.chunks.begin() ) ? 0 : ( chunk - 1 )->second - ( chunk - 1 )->first;
+
+    for( const char * field : { "start", "end" } ) {
+      ProblemSpecP node = copy->findBlock( field );
+      long offset;
+      node->get( offset );
+      copy->removeChild( node );
+      copy->appendElement( field, offset + shift );
+    }
+  }
+}
+
 //______________________________________________________________________
 //  Update the xml file index.xml with any in situ modified variables.
 
@@ -2171,8 +2678,7 @@ DataArchiver::writeGridBinary( const bool hasGlobals, const string & grid_path,
       int       patch_id   = patch->getID();
       int       rank_id    = m_loadBalancer->getOutputRank( patch );
 
-      int proc = m_loadBalancer->getOutputRank( patch );
-      procOnLevel[ lev ][ proc ] = true;
+      procOnLevel[ lev ][ getOutputFileRank( patch ) ] = true;
 
       IntVector ecliiv  = patch->getExtraCellLowIndex();
       IntVector echiiv = patch->getExtraCellHighIndex();
@@ -2286,7 +2792,7 @@ DataArchiver::writeGridOriginal( const bool hasGlobals, const GridP & grid, Prob
       IntVector hi_EC = patch->getExtraCellHighIndex();
           
       int proc = m_loadBalancer->getOutputRank( patch );
-      procOnLevel[ l ][ proc ] = true;
+      procOnLevel[ l ][ getOutputFileRank( patch ) ] = true;
 
       Box box = patch->getExtraBox();
       ProblemSpecP patchElem = levelElem->appendChild("Patch");
@@ -2320,7 +2826,7 @@ DataArchiver::writeGridOriginal( const bool hasGlobals, const GridP & grid, Prob
     // Create a pxxxxx.xml file for each proc doing the outputting.
 
     for( int i = 0; i < d_myworld->nRanks(); i++ ) {
-      if( ( i % m_loadBalancer->getNthRank() ) != 0 || !procOnLevel[l][i] ){
+      if( !procOnLevel[l][i] ){
         continue;
       }
 
@@ -2334,6 +2840,10 @@ DataArchiver::writeGridOriginal( const bool hasGlobals, const GridP & grid, Prob
 
       df->setAttribute( "href", pname.str() );
       df->setAttribute( "proc", procID.str() );
+
+      if( m_aggregateComm != MPI_COMM_NULL ) {
+        df->setAttribute( "ranks", m_aggregatedRanks[ i ] );
+      }
     }
   }
 
@@ -2426,7 +2936,7 @@ DataArchiver::writeGridTextWriter( const bool hasGlobals, const string & grid_pa
       IntVector hi_EC = patch->getExtraCellHighIndex();
           
       int proc = m_loadBalancer->getOutputRank( patch );
-      procOnLevel[ l ][ proc ] = true;
+      procOnLevel[ l ][ getOutputFileRank( patch ) ] = true;
 
       Box box = patch->getExtraBox();
 
@@ -2500,7 +3010,7 @@ DataArchiver::writeDataTextWriter( const bool hasGlobals, const string & data_pa
 
     // create a pxxxxx.xml file for each proc doing the outputting
     for( int i = 0; i < d_myworld->nRanks(); i++ ) {
-      if ( i % m_loadBalancer->getNthRank() != 0 || !procOnLevel[l][i] ) {
+      if ( !procOnLevel[l][i] ) {
         continue;
       }
       ostringstream pname;
@@ -2514,6 +3024,10 @@ DataArchiver::writeDataTextWriter( const bool hasGlobals, const string & data_pa
       xmlTextWriterWriteAttribute( data_writer, BAD_CAST "href", BAD_CAST pname.str().c_str() );
       xmlTextWriterWriteAttribute( data_writer, BAD_CAST "proc", BAD_CAST procID.str().c_str() );
 
+      if( m_aggregateComm != MPI_COMM_NULL ) {
+        xmlTextWriterWriteAttribute( data_writer, BAD_CAST "ranks", BAD_CAST m_aggregatedRanks[ i ].c_str() );
+      }
+
       xmlTextWriterEndElement( data_writer ); // Close <Datafile>
     }
   }
@@ -2580,6 +3094,9 @@ DataArchiver::scheduleOutputTimeStep(       vector<SaveItem> & saveLabels,
         // accessed at any time after all of the tasks are finished.
         // This is needed when saving the old data warehouse as well
         // as the new data warehouse after the tasks are finished.
+        // Aggregated output is serialized after the time step; its
+        // variables are kept on output time steps only, see
+        // setAggregateNoScrubVars.
         sched->overrideVariableBehavior( (*saveIter).label->getName(),
                                          false, false,
                                          !scrubSavedVariables,
@@ -2861,6 +3378,21 @@ DataArchiver::outputVariables( const ProcessorGroup * pg,
     dbg << "  outputVariables task begin\n";
   }
 
+  // When aggregating, only note what to write; flushAggregatedOutput
+  // calls this again and the data is streamed to the aggregator.
+  if( m_aggregateComm != MPI_COMM_NULL && type != CHECKPOINT_GLOBAL && !m_aggregateFlushing ) {
+    AggregateOutput pending;
+    pending.patches = patches->getVector();
+    pending.old_dw  = old_dw;
+    pending.new_dw  = new_dw;
+
+    // A repeated execution of the time step replaces the entry.
+    m_outputLock.lock();
+    m_aggregatePending[ std::make_pair( type, getLevel( patches )->getIndex() ) ] = pending;
+    m_outputLock.unlock();
+    return;
+  }
+
 #if SCI_ASSERTION_LEVEL >= 2
   // Double-check to make sure only called once per level.
   int levelid = type != CHECKPOINT_GLOBAL ? getLevel( patches )->getIndex() : -1;
@@ -2936,6 +3468,7 @@ DataArchiver::outputVariables( const ProcessorGroup * pg,
   string xmlFilename;
   string dataFilebase;
   string dataFilename;
+  string indexFilename;
   const Level* level = nullptr;
 
   // find the xml filename and data filename that we will write to
@@ -2959,16 +3492,24 @@ DataArchiver::outputVariables( const ProcessorGroup * pg,
     lname << "l" << level->getIndex();
     ldir = tdir.getSubdir(lname.str());
     
+    // When aggregating, the entries name the aggregator's data file.
+    int fileRank = d_myworld->myRank();
+    if( m_aggregateComm != MPI_COMM_NULL ) {
+      fileRank = m_aggregatorOf[ fileRank ];
+    }
+
     ostringstream pname;
-    pname << "p" << setw(5) << setfill('0') << d_myworld->myRank();
+    pname << "p" << setw(5) << setfill('0') << fileRank;
     xmlFilename = ldir.getName() + "/" + pname.str() + ".xml";
     dataFilebase = pname.str() + ".data";
     dataFilename = ldir.getName() + "/" + dataFilebase;
+    indexFilename = ldir.getName() + "/" + pname.str() + ".idx";
   }
   else { // type == CHECKPOINT_GLOBAL
     xmlFilename =  tdir.getName() + "/global.xml";
     dataFilebase = "global.data";
     dataFilename = tdir.getName() + "/" + dataFilebase;
+    indexFilename = tdir.getName() + "/global.idx";
   }
 
   Timers::Simple timer;
@@ -2981,11 +3522,26 @@ DataArchiver::outputVariables( const ProcessorGroup * pg,
   // Not only lock to prevent multiple threads from writing over the same
   // file, but also lock because xerces (DOM..) has thread-safety issues.
 
+  // With asynchronous output the data file is assembled here and
+  // written by m_asyncWriter after the lock is released. When
+  // aggregating it is passed to the aggregator every
+  // AGGREGATE_CHUNK bytes.
+  AsyncOutputWriter::Job asyncJob;
+
+  const bool aggregate = ( m_aggregateComm != MPI_COMM_NULL && type != CHECKPOINT_GLOBAL );
+  const bool inMemory  = ( aggregate || m_asyncWriter != nullptr );
+  long       passedOn  = 0;  // bytes already given to the aggregator
+
   if( m_outputFileFormat == UDA || type == CHECKPOINT_GLOBAL ) {
     m_outputLock.lock(); 
     {  
       // Make sure doc's constructor is called after the lock.
       ProblemSpecP doc = ProblemSpec::createDocument( "Uintah_Output" );
+
+      if( aggregate ) {
+        aggregateBegin( type, level->getIndex() );
+      }
+
       // Find the end of the file
       ASSERT( doc != nullptr );
       ProblemSpecP n = doc->findBlock( "Variable" );
@@ -3015,30 +3571,34 @@ DataArchiver::outputVariables( const ProcessorGroup * pg,
       // 71.)  Therefore I am using a while loop and counting the
       // 'tries'.
       
-      int tries = 1;
-      int flags = O_WRONLY|O_CREAT|O_TRUNC;       // file-opening flags
-      
       const char* filename = dataFilename.c_str();
-      int fd  = open( filename, flags, 0666 );
-      
-      while( fd == -1 ) {
+      int fd = -1;
 
-        if( tries >= 50 ) {
-          ostringstream msg;
-          
-          msg << "DataArchiver::output(): Failed to open file '"
-              << dataFilename << "' (after 50 tries).";
-          throw ErrnoException( msg.str(), errno, __FILE__, __LINE__ );
-        }
+      if( !inMemory ) {
+        int tries = 1;
+        int flags = O_WRONLY|O_CREAT|O_TRUNC;       // file-opening flags
 
         fd = open( filename, flags, 0666 );
-        tries++;
-      }
-      
-      if( tries > 1 ) {
-        proc0cout << "WARNING: There was a glitch in trying to open the "
-                  << "checkpoint file: " << dataFilename << ". "
-                  << "It took " << tries << " tries to successfully open it.";
+
+        while( fd == -1 ) {
+
+          if( tries >= 50 ) {
+            ostringstream msg;
+
+            msg << "DataArchiver::output(): Failed to open file '"
+                << dataFilename << "' (after 50 tries).";
+            throw ErrnoException( msg.str(), errno, __FILE__, __LINE__ );
+          }
+
+          fd = open( filename, flags, 0666 );
+          tries++;
+        }
+
+        if( tries > 1 ) {
+          proc0cout << "WARNING: There was a glitch in trying to open the "
+                    << "checkpoint file: " << dataFilename << ". "
+                    << "It took " << tries << " tries to successfully open it.";
+        }
       }
 
       //__________________________________
@@ -3100,7 +3660,12 @@ DataArchiver::outputVariables( const ProcessorGroup * pg,
               pdElem->appendElement("boundaryLayer", var->getBoundaryLayer());
             }
             // Pad appropriately
-            if( cur % PADSIZE != 0 ) {
+            if( cur % PADSIZE != 0 && inMemory ) {
+              long pad = PADSIZE-cur%PADSIZE;
+              asyncJob.data.append( pad, '\0' );
+              cur+=pad;
+            }
+            else if( cur % PADSIZE != 0 ) {
               long pad = PADSIZE-cur%PADSIZE;
               char* zero = scinew char[pad];
               memset(zero, 0, pad);
@@ -3119,42 +3684,80 @@ DataArchiver::outputVariables( const ProcessorGroup * pg,
             
             // output data to data file
             OutputContext oc(fd, filename, cur, pdElem, m_outputDoubleAsFloat && type != CHECKPOINT);
+            if( inMemory ) {
+              oc.buffer = &asyncJob.data;
+            }
             totalBytes += dw->emit(oc, var, matlIndex, patch);
 
             pdElem->appendElement("end", oc.cur);
             pdElem->appendElement("filename", dataFilebase.c_str());
             
 #if SCI_ASSERTION_LEVEL >= 1
-            struct stat st;
-            int s = fstat(fd, &st);
-            
-            if(s == -1) {
-              cerr << "fstat error - file: " << filename
-                   << ", errno=" << errno << '\n';
-              throw ErrnoException("DataArchiver::output (stat call)",
-                                   errno, __FILE__, __LINE__);
+            if( inMemory ) {
+              ASSERTEQ(oc.cur, passedOn + (long) asyncJob.data.size());
+            }
+            else {
+              struct stat st;
+              int s = fstat(fd, &st);
+
+              if(s == -1) {
+                cerr << "fstat error - file: " << filename
+                     << ", errno=" << errno << '\n';
+                throw ErrnoException("DataArchiver::output (stat call)",
+                                     errno, __FILE__, __LINE__);
+              }
+              ASSERTEQ(oc.cur, st.st_size);
             }
-            ASSERTEQ(oc.cur, st.st_size);
 #endif
             cur = oc.cur;
+
+            if( aggregate && asyncJob.data.size() >= AGGREGATE_CHUNK ) {
+              passedOn += asyncJob.data.size();
+              aggregateData( asyncJob.data );
+            }
           }  // matls
         }  // patches
       }  // save items
       
       //__________________________________
       // close files and handles 
-      int s = close( fd );
-      if( s == -1 ) {
-        cerr << "Error closing file: " << filename << ", errno=" << errno << '\n';
-        throw ErrnoException("DataArchiver::output (close call)", errno, __FILE__, __LINE__ );
+      if( aggregate ) {
+        aggregateData( asyncJob.data );
+        aggregateDoc( doc );
       }
+      else if( inMemory ) {
+        asyncJob.dataFilename  = dataFilename;
+        asyncJob.xmlFilename   = xmlFilename;
+        asyncJob.doc           = doc;
+        asyncJob.indexFilename = indexFilename;
+        asyncJob.binaryIndex   = m_binaryIndex;
+      }
+      else {
+        int s = close( fd );
+        if( s == -1 ) {
+          cerr << "Error closing file: " << filename << ", errno=" << errno << '\n';
+          throw ErrnoException("DataArchiver::output (close call)", errno, __FILE__, __LINE__ );
+        }
       
-      doc->output( xmlFilename.c_str() );
-      //doc->releaseDocument();
+        doc->output( xmlFilename.c_str() );
+        if( m_binaryIndex ) {
+          AsyncOutputWriter::writeIndex( doc, indexFilename );
+        }
+        else {
+          AsyncOutputWriter::removeIndex( indexFilename );
+        }
+        //doc->releaseDocument();
+      }
 
     } // end output locked section
 
     m_outputLock.unlock(); 
+
+    // Outside of the lock as the writer needs it for the xml file;
+    // blocks while the writer is over its memory budget.
+    if( m_asyncWriter && !aggregate ) {
+      m_asyncWriter->enqueue( std::move( asyncJob ) );
+    }
   } // end UDA or Global Var
 
 #if HAVE_PIDX
@@ -4480,6 +5083,10 @@ DataArchiver::outputTimeStep( const GridP& grid,
   // timestep.
   writeto_xml_files( grid );
 
+  if( m_asyncWriter ) {
+    m_asyncWriter->drain();
+  }
+
   m_isOutputTimeStep = false;
   m_outputPreviousTimeStep = false;
 }
@@ -4542,6 +5149,12 @@ DataArchiver::checkpointTimeStep( const GridP& grid,
                      nullptr, oldDW, newDW, CHECKPOINT_GLOBAL );
   }
 
+  flushAggregatedOutput();
+
+  if( m_asyncWriter ) {
+    m_asyncWriter->drain();
+  }
+
   m_isCheckpointTimeStep = false;
   m_checkpointPreviousTimeStep = false;
 }
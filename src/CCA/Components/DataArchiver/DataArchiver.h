@@ -28,6 +28,8 @@
 #include <CCA/Ports/Output.h>
 #include <CCA/Ports/PIDXOutputContext.h>
 
+#include <CCA/Components/DataArchiver/AsyncOutputWriter.h>
+
 #include <CCA/Components/Schedulers/RuntimeStatsEnum.h>
 
 #include <Core/Containers/ConsecutiveRangeSet.h>
@@ -37,9 +39,14 @@
 #include <Core/Grid/MaterialManagerP.h>
 #include <Core/OS/Dir.h>
 #include <Core/Parallel/MasterLock.h>
+#include <Core/Parallel/UintahMPI.h>
 #include <Core/Parallel/UintahParallelComponent.h>
 #include <Core/Util/Assert.h>
 
+#include <map>
+#include <utility>
+#include <vector>
+
 namespace Uintah {
 
 class DataWarehouse;
@@ -329,6 +336,32 @@ class LoadBalancer;
     // Writes out the <Grid> section (associated with timestep.xml) to a separate binary file.
     void writeGridBinary(     const bool hasGlobals, const std::string & grid_path, const GridP & grid );
 
+    //! The rank whose pxxxxx.xml file holds the patch's data.
+    int getOutputFileRank( const Patch * patch );
+
+    //! Runs the outputVariables calls recorded for aggregation,
+    //! streaming each rank's data to its aggregator, which writes one
+    //! data and one xml file per level for its group.
+    void flushAggregatedOutput();
+
+    //! Keeps the variables saved on this time step from being scrubbed
+    //! until flushAggregatedOutput has written them.
+    void setAggregateNoScrubVars();
+
+    //! Used by outputVariables while flushAggregatedOutput replays it:
+    //! start an output on the level, pass on (and clear) the serialized
+    //! data, and pass on the level's xml entries.
+    void aggregateBegin( int type, int levelIndex );
+    void aggregateData(  std::string & data );
+    void aggregateDoc(   const ProblemSpecP & doc );
+
+    //! Aggregator side: handles the senders' messages that have
+    //! arrived, and applies a stream (group rank 'source') to a file.
+    void aggregateServe( bool wait );
+    void aggregateOpen(  int source, int type, int levelIndex );
+    void aggregateWrite( int source, const std::string & data );
+    void aggregateMerge( int source, const ProblemSpecP & doc );
+
     //__________________________________
     //! returns a ProblemSpecP reading the xml file xmlName.
     //! You will need to that you need to call ProblemSpec::releaseDocument
@@ -656,6 +689,53 @@ class LoadBalancer;
 #endif
     Uintah::MasterLock m_outputLock;
 
+    //! Set with <asyncOutput/>: output and checkpoint files are
+    //! serialized in outputVariables and written by this thread.
+    AsyncOutputWriter * m_asyncWriter {nullptr};
+
+    //! Set with <binaryIndex/>: a pNNNNN.idx is written next to each
+    //! pNNNNN.xml so readers can skip parsing the xml.
+    bool m_binaryIndex {false};
+
+    //! Set with <outputAggregation/>: the ranks of a group (a node, or
+    //! consecutive ranks) share one data and one xml file per level,
+    //! written by the group's first rank (its aggregator).
+    MPI_Comm         m_aggregateComm {MPI_COMM_NULL};
+    std::vector<int> m_aggregatorOf;   // world rank -> aggregator world rank
+    std::map<int, std::string> m_aggregatedRanks;  // aggregator -> its group, "0-3, 8"
+
+    //! The outputVariables calls waiting for flushAggregatedOutput, per
+    //! (type, level). Their variables are kept from being scrubbed
+    //! through m_aggregateScheduler.
+    struct AggregateOutput {
+      std::vector<const Patch*> patches;
+      DataWarehouse           * old_dw {nullptr};
+      DataWarehouse           * new_dw {nullptr};
+    };
+    std::map< std::pair<int, int>, AggregateOutput > m_aggregatePending;
+    bool m_aggregateFlushing {false};
+    Scheduler * m_aggregateScheduler {nullptr};
+
+    //! Aggregator: the group's open files, per (type, level), and the
+    //! stream each group rank is passing on, with where its chunks
+    //! were placed in the file.
+    struct AggregateFile {
+      std::string  dataFilename;
+      std::string  xmlFilename;
+      std::string  indexFilename;
+      int          fd   {-1};
+      long         end  {0};    // bytes placed so far
+      ProblemSpecP doc;
+    };
+    struct AggregateStream {
+      AggregateFile * file {nullptr};
+      long            end  {0};                   // bytes received so far
+      std::vector< std::pair<long, long> > chunks;  // offset in the stream, in the file
+    };
+    std::map< std::pair<int, int>, AggregateFile > m_aggregateFiles;
+    std::map< int, AggregateStream >               m_aggregateStreams;
+    int m_aggregateSendersDone {0};
+
     DataArchiver(const DataArchiver&);
     DataArchiver& operator=(const DataArchiver&);      
   };
@@ -30,6 +30,7 @@
 #include <CCA/Components/MPM/Core/MPMDiffusionLabel.h> // for MPMDiffusionLabel
 #include <CCA/Components/MPM/Core/MPMLabel.h>          // for MPMLabel
 #include <CCA/Components/MPM/Core/MPMBoundCond.h>      // for MPMBoundCond
+#include <CCA/Components/MPM/Core/ParticleScatter.h>
 #include <CCA/Components/MPM/Materials/MPMMaterial.h>
 #include <CCA/Components/MPM/Materials/ConstitutiveModel/ConstitutiveModel.h>
 #include <CCA/Components/MPM/Materials/ConstitutiveModel/PlasticityModels/DamageModel.h>
@@ -2106,64 +2107,78 @@ void AMRMPM::interpolateParticlesToGrid(const ProcessorGroup*,
         gnegcharge.initialize(0.0);
       }
       
-      Vector pmom;
-      for (ParticleSubset::iterator iter  = pset->begin();
-                                    iter != pset->end(); iter++){
-        particleIndex idx = *iter;
+      // Possibly threaded within the patch, see ParticleScatter
+      ParticleScatter scatter(patch, NGN, flags->d_particleScatterThreads);
+      scatter.setup(pset, px);
 
-        // Get the node indices that surround the cell
-        int NN = interpolator->findCellAndWeights(px[idx],ni,S,psize[idx]);
+      vector<vector<IntVector> > thread_ni(scatter.numThreads(), ni);
+      vector<vector<double> >    thread_S(scatter.numThreads(), S);
 
-        pmom = pvelocity[idx]*pmass[idx];
+      scatter.forEach([&](ParticleScatter::Block& blk) {
+        vector<IntVector>& ni = thread_ni[blk.thread()];
+        vector<double>&    S  = thread_S[blk.thread()];
 
-        // Add each particles contribution to the local mass & velocity 
-        IntVector node;
-        for(int k = 0; k < NN; k++) {
-          node = ni[k];
-          if(patch->containsNode(node)) {
-            if (flags->d_GEVelProj){
-              Point gpos = patch->getNodePosition(node);
-              Vector distance = px[idx] - gpos;
-              Vector pvel_ext = pvelocity[idx] - pVelGrad[idx]*distance;
-              pmom = pvel_ext*pmass[idx];
-            }
-            gmass[node]          += pmass[idx]                     * S[k];
-            gvelocity[node]      += pmom                           * S[k];
-            gvolume[node]        += pvolume[idx]                   * S[k];
-            gexternalforce[node] += pexternalforce[idx]            * S[k];
-            gTemperature[node]   += pTemperature[idx] * pmass[idx] * S[k];
+        for (int b = 0; b < blk.size(); b++) {
+          particleIndex idx = blk[b];
+
+          // Get the node indices that surround the cell
+          int NN = interpolator->findCellAndWeights(px[idx],ni,S,psize[idx]);
+          if (!blk.owns(&ni[0], NN)) {
+            blk.defer(b);
+            continue;
           }
-        }
-        if(flags->d_doScalarDiffusion){
-          double one_third = 1./3.;
-          double phydrostress = one_third*pStress[idx].Trace();
-          double pConc_Ext = pConcentration[idx];
+
+          Vector pmom = pvelocity[idx]*pmass[idx];
+
+          // Add each particles contribution to the local mass & velocity 
+          IntVector node;
           for(int k = 0; k < NN; k++) {
             node = ni[k];
             if(patch->containsNode(node)) {
-              if (flags->d_GEVelProj) {
+              if (flags->d_GEVelProj){
                 Point gpos = patch->getNodePosition(node);
-                Vector pointOffset = px[idx]-gpos;
-                pConc_Ext -= Dot(pConcGrad[idx],pointOffset);
+                Vector distance = px[idx] - gpos;
+                Vector pvel_ext = pvelocity[idx] - pVelGrad[idx]*distance;
+                pmom = pvel_ext*pmass[idx];
               }
-              ghydrostaticstress[node] += phydrostress        * pmass[idx]*S[k];
-              gconcentration[node]     += pConc_Ext           * pmass[idx]*S[k];
+              gmass[node]          += pmass[idx]                     * S[k];
+              gvelocity[node]      += pmom                           * S[k];
+              gvolume[node]        += pvolume[idx]                   * S[k];
+              gexternalforce[node] += pexternalforce[idx]            * S[k];
+              gTemperature[node]   += pTemperature[idx] * pmass[idx] * S[k];
+            }
+          }
+          if(flags->d_doScalarDiffusion){
+            double one_third = 1./3.;
+            double phydrostress = one_third*pStress[idx].Trace();
+            double pConc_Ext = pConcentration[idx];
+            for(int k = 0; k < NN; k++) {
+              node = ni[k];
+              if(patch->containsNode(node)) {
+                if (flags->d_GEVelProj) {
+                  Point gpos = patch->getNodePosition(node);
+                  Vector pointOffset = px[idx]-gpos;
+                  pConc_Ext -= Dot(pConcGrad[idx],pointOffset);
+                }
+                ghydrostaticstress[node] += phydrostress        * pmass[idx]*S[k];
+                gconcentration[node]     += pConc_Ext           * pmass[idx]*S[k];
 #ifndef CBDI_FLUXBCS
-              gextscalarflux[node]+= (pExternalScalarFlux[idx]*pmass[idx])*S[k];
+                gextscalarflux[node]+= (pExternalScalarFlux[idx]*pmass[idx])*S[k];
 #endif
+              }
             }
           }
-        }
-        if(flags->d_withGaussSolver){
-          for(int k = 0; k < NN; k++) {
-            node = ni[k];
-            if(patch->containsNode(node)) {
-              gposcharge[node] += pPosCharge[idx] * pmass[idx]*S[k];
-              gnegcharge[node] += pNegCharge[idx] * pmass[idx]*S[k];
+          if(flags->d_withGaussSolver){
+            for(int k = 0; k < NN; k++) {
+              node = ni[k];
+              if(patch->containsNode(node)) {
+                gposcharge[node] += pPosCharge[idx] * pmass[idx]*S[k];
+                gnegcharge[node] += pNegCharge[idx] * pmass[idx]*S[k];
+              }
             }
           }
         }
-      }  // End of particle loop
+      });  // End of particle loop
 
 
 #ifdef CBDI_FLUXBCS
@@ -84,6 +84,10 @@ MPMFlags::MPMFlags(const ProcessorGroup* myworld)
   d_addFrictionWork               =  0.0;               // don't do frictional heating by default
 
   d_extraSolverFlushes                 =  0;            // Have PETSc do more flushes to save memory
+  d_particleCellSortInterval           =  0;            // don't reorder particles by cell
+  d_particleCellSortOrder              =  "lexicographic";
+  d_particleShellScanInterval          =  0;            // relocation examines every particle
+  d_particleScatterThreads             =  1;            // scatter particles to the grid serially within a patch
   d_doImplicitHeatConduction           =  false;
   d_doExplicitHeatConduction           =  true;
   d_deleteGeometryObjects              =  false;
@@ -367,6 +371,35 @@ else{
   mpm_flag_ps->get("extra_solver_flushes", d_extraSolverFlushes);
   mpm_flag_ps->get("boundary_traction_faces", d_bndy_face_txt_list);
 
+  // Reorder particles by cell after relocation
+  mpm_flag_ps->get("particle_cell_sort_interval", d_particleCellSortInterval);
+  mpm_flag_ps->get("particle_cell_sort_order",    d_particleCellSortOrder);
+  if (d_particleCellSortOrder != "lexicographic" && d_particleCellSortOrder != "morton") {
+    ostringstream warn;
+    warn << "ERROR:MPM: invalid particle_cell_sort_order (" << d_particleCellSortOrder
+         << "), valid options are: lexicographic, morton" << endl;
+    throw ProblemSetupException(warn.str(), __FILE__, __LINE__ );
+  }
+
+  // Relocation only examines the particles near the patch faces between full
+  // scans; this relies on no particle moving a whole cell in one timestep
+  mpm_flag_ps->get("particle_shell_scan_interval", d_particleShellScanInterval);
+  if (d_particleShellScanInterval < 0) {
+    ostringstream warn;
+    warn << "ERROR:MPM: particle_shell_scan_interval (" << d_particleShellScanInterval
+         << ") must not be negative" << endl;
+    throw ProblemSetupException(warn.str(), __FILE__, __LINE__ );
+  }
+
+  // Threads for the particle to grid scatter within one patch
+  mpm_flag_ps->get("particle_scatter_threads", d_particleScatterThreads);
+  if (d_particleScatterThreads < 1) {
+    ostringstream warn;
+    warn << "ERROR:MPM: particle_scatter_threads (" << d_particleScatterThreads
+         << ") must be at least 1" << endl;
+    throw ProblemSetupException(warn.str(), __FILE__, __LINE__ );
+  }
+
   if (dbg.active()) {
     dbg << "---------------------------------------------------------\n";
     dbg << "MPM Flags " << endl;
@@ -386,6 +419,9 @@ else{
     dbg << " Use Cohesive Zones          = " << d_useCohesiveZones << endl;
     dbg << " Contact Friction Heating    = " << d_addFrictionWork << endl;
     dbg << " Extra Solver flushes        = " << d_extraSolverFlushes << endl;
+    dbg << " Particle cell sort interval = " << d_particleCellSortInterval << endl;
+    dbg << " Particle shell scan interval= " << d_particleShellScanInterval << endl;
+    dbg << " Particle scatter threads    = " << d_particleScatterThreads << endl;
     dbg << "---------------------------------------------------------\n";
   }
 }
@@ -446,6 +482,10 @@ MPMFlags::outputProblemSpec(ProblemSpecP& ps)
   ps->appendElement("computeColinearNormals",     d_computeColinearNormals);
   ps->appendElement("restartOnLargeNodalVelocity",d_restartOnLargeNodalVelocity);
   ps->appendElement("extra_solver_flushes", d_extraSolverFlushes);
+  ps->appendElement("particle_cell_sort_interval", d_particleCellSortInterval);
+  ps->appendElement("particle_cell_sort_order",    d_particleCellSortOrder);
+  ps->appendElement("particle_shell_scan_interval", d_particleShellScanInterval);
+  ps->appendElement("particle_scatter_threads",    d_particleScatterThreads);
   ps->appendElement("boundary_traction_faces", d_bndy_face_txt_list);
   ps->appendElement("do_scalar_diffusion", d_doScalarDiffusion);
   ps->appendElement("d_ndim",                      d_ndim);
@@ -94,6 +94,10 @@ class Output;
     double      d_addFrictionWork;                             // 1 == add , 0 == do not add
 
     int         d_extraSolverFlushes;                          // Have PETSc flush more to save memory
+    int         d_particleCellSortInterval;                    // Reorder particles by cell every N timesteps after relocation (0 = never)
+    std::string d_particleCellSortOrder;                       // "lexicographic" or "morton"
+    int         d_particleShellScanInterval;                   // Relocation scans all particles every N timesteps, only those near patch faces in between (0 = always all)
+    int         d_particleScatterThreads;                      // Threads for the particle to grid scatter within a patch
     bool        d_doImplicitHeatConduction;
     bool        d_doTransientImplicitHeatConduction;
     bool        d_doExplicitHeatConduction;
@@ -0,0 +1,110 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <CCA/Components/MPM/Core/ParticleScatter.h>
+#include <Core/Grid/Level.h>
+#include <Core/Grid/Patch.h>
+#include <Core/Math/MiscMath.h>
+
+using namespace Uintah;
+
+//______________________________________________________________________
+//
+ParticleScatter::ParticleScatter( const Patch * patch
+                                , int           numGhostNodes
+                                , int           numThreads
+                                )
+  : m_patch{patch}
+  , m_num_threads{numThreads < 1 ? 1 : numThreads}
+  , m_reach{numGhostNodes < 1 ? 0 : numGhostNodes - 1}
+{
+}
+
+//______________________________________________________________________
+//
+void
+ParticleScatter::setup( ParticleSubset                * pset
+                      , constParticleVariable<Point>  & px
+                      )
+{
+  m_pset = pset;
+  m_order.clear();
+  m_slab_start.clear();
+  m_num_slabs = 0;
+
+  if (m_num_threads == 1) {
+    return;
+  }
+
+  // Slab along the longest axis of the patch plus its ghost cells
+  const IntVector low  = m_patch->getExtraCellLowIndex()  - IntVector(m_reach + 1, m_reach + 1, m_reach + 1);
+  const IntVector high = m_patch->getExtraCellHighIndex() + IntVector(m_reach + 1, m_reach + 1, m_reach + 1);
+  const IntVector len  = high - low;
+
+  m_axis = 0;
+  if (len[1] > len[m_axis]) { m_axis = 1; }
+  if (len[2] > len[m_axis]) { m_axis = 2; }
+
+  // A particle in cell c writes nodes [c - reach, c + 1 + reach].  With the
+  // window a slab plus (width-1)/2 on each side, same colour slabs stay
+  // disjoint and a typical stencil fits once width >= 2*reach + 1.  Aim for
+  // about four slabs per thread per colour so dynamic scheduling can balance.
+  const int min_width = 2 * m_reach + 1;
+  const int target    = (len[m_axis] + 8 * m_num_threads - 1) / (8 * m_num_threads);
+  m_slab_width = Max(min_width, target);
+  m_slab_low   = low[m_axis];
+  m_num_slabs  = (len[m_axis] + m_slab_width - 1) / m_slab_width;
+  m_halo       = (m_slab_width - 1) / 2;
+
+  // Too few slabs to colour; run serially
+  if (m_num_slabs < 3) {
+    m_num_slabs = 0;
+    return;
+  }
+
+  // Counting sort of the particles by slab
+  const Level * level = m_patch->getLevel();
+  const int     n     = pset->numParticles();
+  std::vector<int> slab(n);
+
+  m_slab_start.assign(m_num_slabs + 1, 0);
+  int i = 0;
+  for (ParticleSubset::iterator iter = pset->begin(); iter != pset->end(); ++iter, ++i) {
+    const int c = Floor(level->positionToIndex(px[*iter])(m_axis));
+    const int s = Min(Max((c - m_slab_low) / m_slab_width, 0), m_num_slabs - 1);
+    slab[i] = s;
+    m_slab_start[s + 1]++;
+  }
+  for (int s = 0; s < m_num_slabs; s++) {
+    m_slab_start[s + 1] += m_slab_start[s];
+  }
+
+  m_order.resize(n);
+  std::vector<int> next(m_slab_start.begin(), m_slab_start.end() - 1);
+  i = 0;
+  for (ParticleSubset::iterator iter = pset->begin(); iter != pset->end(); ++iter, ++i) {
+    m_order[next[slab[i]]++] = *iter;
+  }
+}
@@ -0,0 +1,222 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#ifndef UINTAH_MPM_PARTICLESCATTER_H
+#define UINTAH_MPM_PARTICLESCATTER_H
+
+#include <Core/Geometry/IntVector.h>
+#include <Core/Grid/Variables/ParticleSubset.h>
+#include <Core/Grid/Variables/ParticleVariable.h>
+
+#include <vector>
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+namespace Uintah {
+
+  class Patch;
+
+  //______________________________________________________________________
+  //
+  //  Thread-parallel particle-to-grid scatter within one patch.
+  //
+  //  The particles are binned into slabs of cells along the longest patch
+  //  axis and the slabs are coloured alternately.  All slabs of one colour
+  //  run concurrently; two slabs of the same colour are a slab apart, so
+  //  their node windows (the slab widened by half a slab on each side) never
+  //  overlap and the scatter needs no locks or per-thread copies of the grid.
+  //
+  //  The body is called with a Block of particles from one slab.  Before it
+  //  writes anything for a particle it must check the particle's nodes with
+  //  Block::owns(); a particle whose stencil leaves the window (a stretched
+  //  CPDI particle, say) is handed back with Block::defer() and is replayed
+  //  serially, with an unbounded window, after both colours are done.
+  //
+  //  With one thread, or too few slabs to colour, the body sees the whole
+  //  subset in its original order, so results are identical to a plain loop.
+  //
+  class ParticleScatter {
+
+  public:
+
+    static const int blockSize = 32;
+
+    class Block {
+
+    public:
+
+      // Thread running this block, [0, numThreads())
+      int thread() const { return m_thread; }
+
+      int size() const { return m_size; }
+
+      particleIndex operator[]( int i ) const { return m_particles[i]; }
+
+      // True if every node k < NN (ni[k*stride]) lies in this block's window
+      bool owns( const IntVector * ni, int NN, int stride = 1 ) const
+      {
+        for (int k = 0; k < NN; k++) {
+          const int x = ni[k*stride][m_axis];
+          if (x < m_lo || x > m_hi) {
+            return false;
+          }
+        }
+        return true;
+      }
+
+      // Hand particle i back for the serial pass; write nothing for it
+      void defer( int i ) { m_deferred->push_back(m_particles[i]); }
+
+    private:
+
+      friend class ParticleScatter;
+
+      int                          m_thread{0};
+      int                          m_size{0};
+      const particleIndex        * m_particles{nullptr};
+      int                          m_axis{0};
+      int                          m_lo{0};
+      int                          m_hi{0};
+      std::vector<particleIndex> * m_deferred{nullptr};
+    };
+
+    // numGhostNodes is the interpolator's reach (NGN); it only sizes the
+    // slabs, correctness comes from Block::owns()
+    ParticleScatter( const Patch * patch, int numGhostNodes, int numThreads );
+
+    // Bin the particles of pset into slabs by position
+    void setup( ParticleSubset * pset, constParticleVariable<Point> & px );
+
+    int numThreads() const { return m_num_threads; }
+
+    // Particles deferred to the serial pass by the last forEach()
+    int numDeferred() const { return m_num_deferred; }
+
+    template<class Body>
+    void forEach( Body body );
+
+  private:
+
+    // Run body over particles [0, n) of list in blocks
+    template<class Body>
+    void runBlocks( Body & body, int thread, const particleIndex * list, int n,
+                    int lo, int hi, std::vector<particleIndex> * deferred );
+
+    const Patch                * m_patch;
+    int                          m_num_threads;
+    int                          m_reach;        // NGN - 1
+    int                          m_halo{0};      // window overhang, (width-1)/2
+    int                          m_axis{0};
+    int                          m_slab_width{1};
+    int                          m_slab_low{0};
+    int                          m_num_slabs{0};
+    int                          m_num_deferred{0};
+
+    ParticleSubset             * m_pset{nullptr};
+    std::vector<particleIndex>   m_order;        // particles, slab by slab
+    std::vector<int>             m_slab_start;   // m_num_slabs + 1 offsets
+  };
+
+  //______________________________________________________________________
+  //
+  template<class Body>
+  void
+  ParticleScatter::runBlocks( Body                       & body
+                            , int                          thread
+                            , const particleIndex        * list
+                            , int                          n
+                            , int                          lo
+                            , int                          hi
+                            , std::vector<particleIndex> * deferred
+                            )
+  {
+    Block blk;
+    blk.m_thread   = thread;
+    blk.m_axis     = m_axis;
+    blk.m_lo       = lo;
+    blk.m_hi       = hi;
+    blk.m_deferred = deferred;
+
+    for (int b0 = 0; b0 < n; b0 += blockSize) {
+      blk.m_particles = list + b0;
+      blk.m_size      = (n - b0 < blockSize) ? n - b0 : blockSize;
+      body(blk);
+    }
+  }
+
+  //______________________________________________________________________
+  //
+  template<class Body>
+  void
+  ParticleScatter::forEach( Body body )
+  {
+    const int unbounded_lo = -(1 << 30);
+    const int unbounded_hi =  (1 << 30);
+
+    m_num_deferred = 0;
+
+    // Serial: the whole subset in its own order
+    if (m_order.empty()) {
+      std::vector<particleIndex> list(m_pset->begin(), m_pset->end());
+      runBlocks(body, 0, list.data(), (int)list.size(), unbounded_lo, unbounded_hi, nullptr);
+      return;
+    }
+
+    std::vector<std::vector<particleIndex> > deferred(m_num_threads);
+
+    for (int colour = 0; colour < 2; colour++) {
+#ifdef _OPENMP
+      #pragma omp parallel for num_threads(m_num_threads) schedule(dynamic, 1)
+#endif
+      for (int s = colour; s < m_num_slabs; s += 2) {
+#ifdef _OPENMP
+        const int thread = omp_get_thread_num();
+#else
+        const int thread = 0;
+#endif
+        const int lo = m_slab_low + s * m_slab_width - m_halo;
+        const int hi = m_slab_low + (s + 1) * m_slab_width + m_halo;
+        const int first = m_slab_start[s];
+        runBlocks(body, thread, m_order.data() + first, m_slab_start[s + 1] - first,
+                  lo, hi, &deferred[thread]);
+      }
+    }
+
+    // Stencils that left their window, one thread, no window
+    std::vector<particleIndex> leftovers;
+    for (auto & d : deferred) {
+      leftovers.insert(leftovers.end(), d.begin(), d.end());
+    }
+    m_num_deferred = (int)leftovers.size();
+    if (!leftovers.empty()) {
+      runBlocks(body, 0, leftovers.data(), (int)leftovers.size(), unbounded_lo, unbounded_hi, nullptr);
+    }
+  }
+
+} // end namespace Uintah
+
+#endif
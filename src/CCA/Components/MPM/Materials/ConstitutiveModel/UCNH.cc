@@ -32,6 +32,7 @@
 #include <Core/Grid/Patch.h>
 #include <Core/Grid/Variables/NCVariable.h>
 #include <Core/Grid/Variables/ParticleVariable.h>
+#include <Core/Grid/Variables/ParticleVariableSoA.h>
 #include <Core/Grid/Task.h>
 #include <Core/Grid/Variables/VarLabel.h>
 #include <Core/Grid/Variables/VarTypes.h>
@@ -581,7 +582,7 @@ void UCNH::computeStressTensor(const PatchSubset* patches,
     double c_dil=0.0;  // Speed of sound
 
     Matrix3 pBBar_new(0.0), bEB_new(0.0), bElBarTrial(0.0), pDefGradInc(0.0);
-    Matrix3 fBar(0.0), defGrad(0.0), normal(0.0);
+    Matrix3 fBar(0.0), normal(0.0);
     Matrix3 tauDev(0.0), tauDevTrial(0.0);
     Vector WaveSpeed(1.e-12,1.e-12,1.e-12);
 
@@ -643,23 +644,32 @@ void UCNH::computeStressTensor(const PatchSubset* patches,
     new_dw->allocateAndPut(pdTdt,       lb->pdTdtLabel,            pset);
     new_dw->allocateAndPut(p_q,         lb->p_qLabel_preReloc,     pset);
 
+    // Without plasticity the stress depends only on F_new; do it for the
+    // whole subset up front
+    vector<double> pJ;
+    if(!d_usePlasticity){
+      computeElasticStress(pset, pDefGrad_new, bElBar_new, pStress, pJ);
+    }
+
+    int i = 0;
     ParticleSubset::iterator iter = pset->begin();
-    for(; iter != pset->end(); iter++){
+    for(; iter != pset->end(); iter++, i++){
       particleIndex idx = *iter;
       // Assign zero internal heating by default - modify if necessary.
       pdTdt[idx] = 0.0;
 
-      pDefGradInc = pDefGrad_new[idx]*pDefGrad[idx].Inverse();
-      Jinc    = pDefGradInc.Determinant();
-      defGrad = pDefGrad_new[idx];
-
       // 1) Get the volumetric part of the deformation
       // 2) Compute the deformed volume and new density
-      J               = defGrad.Determinant();
+      if(d_usePlasticity){
+        J = pDefGrad_new[idx].Determinant();
+      } else {
+        J = pJ[i];
+      }
       double rho_cur  = rho_orig/J;
 
       // Check 1: Look at Jacobian
       if (!(J > 0.0)) {
+        pDefGradInc = pDefGrad_new[idx]*pDefGrad[idx].Inverse();
         cerr << "matl = "  << dwi              << endl;
         cerr << "F_old = " << pDefGrad[idx]     << endl;
         cerr << "F_inc = " << pDefGradInc       << endl;
@@ -675,56 +685,53 @@ void UCNH::computeStressTensor(const PatchSubset* patches,
                             __FILE__, __LINE__);
       }
 
-      // Get the volume preserving part of the deformation gradient increment
-      fBar = pDefGradInc/cbrt(Jinc);
-
-      // Compute the trial elastic part of the volume preserving
-      // part of the left Cauchy-Green deformation tensor
-      bElBarTrial = fBar*bElBar[idx]*fBar.Transpose();
-      if(!d_usePlasticity){
-        double cubeRootJ      = cbrt(J);
-        double Jtothetwothirds= cubeRootJ*cubeRootJ;
-        bElBarTrial           = pDefGrad_new[idx]* pDefGrad_new[idx].Transpose()
-                                 /Jtothetwothirds;
-      }
-      IEl   = onethird*bElBarTrial.Trace();
-      muBar = IEl*shear;
-
-      // tauDevTrial is equal to the shear modulus times dev(bElBar)
-      // Compute ||tauDevTrial||
-      tauDevTrial = (bElBarTrial - Identity*IEl)*shear;
-      sTnorm      = tauDevTrial.Norm();
-
-      // Check for plastic loading
-      double alpha;
-      if(d_usePlasticity) {
-        flow = pYieldStress[idx];
-        alpha  = pPlasticStrain[idx];
+      if(d_usePlasticity){
+        pDefGradInc = pDefGrad_new[idx]*pDefGrad[idx].Inverse();
+        Jinc    = pDefGradInc.Determinant();
+
+        // Get the volume preserving part of the deformation gradient increment
+        fBar = pDefGradInc/cbrt(Jinc);
+
+        // Compute the trial elastic part of the volume preserving
+        // part of the left Cauchy-Green deformation tensor
+        bElBarTrial = fBar*bElBar[idx]*fBar.Transpose();
+        IEl   = onethird*bElBarTrial.Trace();
+        muBar = IEl*shear;
+
+        // tauDevTrial is equal to the shear modulus times dev(bElBar)
+        // Compute ||tauDevTrial||
+        tauDevTrial = (bElBarTrial - Identity*IEl)*shear;
+        sTnorm      = tauDevTrial.Norm();
+
+        // Check for plastic loading
+        flow   = pYieldStress[idx];
+        double alpha = pPlasticStrain[idx];
         fTrial = sTnorm - sqtwthds*(K*alpha + flow);
-      }
-      if (d_usePlasticity && (fTrial > 0.0) ) {
-        // plastic
-        // Compute increment of slip in the direction of flow
-        delgamma = (fTrial/(2.0*muBar)) / (1.0 + (K/(3.0*muBar)));
-        normal   = tauDevTrial/sTnorm;
-
-        // The actual shear stress
-        tauDev = tauDevTrial - normal*2.0*muBar*delgamma;
-
-        // Deal with history variables
-        pPlasticStrain[idx] = alpha + sqtwthds*delgamma;
-        bElBar_new[idx]     = tauDev/shear + Identity*IEl;
-      } else {
-        // The actual shear stress
-        tauDev          = tauDevTrial;
-        bElBar_new[idx] = bElBarTrial;
-      }
 
-      // get the hydrostatic part of the stress
-      p = 0.5*bulk*(J - 1.0/J);
+        if (fTrial > 0.0) {
+          // plastic
+          // Compute increment of slip in the direction of flow
+          delgamma = (fTrial/(2.0*muBar)) / (1.0 + (K/(3.0*muBar)));
+          normal   = tauDevTrial/sTnorm;
+
+          // The actual shear stress
+          tauDev = tauDevTrial - normal*2.0*muBar*delgamma;
+
+          // Deal with history variables
+          pPlasticStrain[idx] = alpha + sqtwthds*delgamma;
+          bElBar_new[idx]     = tauDev/shear + Identity*IEl;
+        } else {
+          // The actual shear stress
+          tauDev          = tauDevTrial;
+          bElBar_new[idx] = bElBarTrial;
+        }
 
-      // compute the total stress (volumetric + deviatoric)
-      pStress[idx] = Identity*p + tauDev/J;
+        // get the hydrostatic part of the stress
+        p = 0.5*bulk*(J - 1.0/J);
+
+        // compute the total stress (volumetric + deviatoric)
+        pStress[idx] = Identity*p + tauDev/J;
+      }
 
       //__________________________________
       // Compute the strain energy for non-localized particles
@@ -769,6 +776,80 @@ void UCNH::computeStressTensor(const PatchSubset* patches,
 }
 //______________________________________________________________________
 //
+void UCNH::computeElasticStress(ParticleSubset* pset,
+                                constParticleVariable<Matrix3>& pDefGrad_new,
+                                ParticleVariable<Matrix3>& bElBar_new,
+                                ParticleVariable<Matrix3>& pStress,
+                                vector<double>& pJ) const
+{
+  const double onethird = (1.0/3.0);
+  const double shear    = d_initialData.tauDev;
+  const double bulk     = d_initialData.Bulk;
+  const int    n        = pset->numParticles();
+
+  ParticleVariableSoA<Matrix3> F(pset, pDefGrad_new);
+  ParticleVariableSoA<Matrix3> bEl(n), sig(n);
+  pJ.resize(n);
+
+  // Component c of particle i is at [c*n + i]
+  const double* f = F.component(0);
+  double*       b = bEl.component(0);
+  double*       s = sig.component(0);
+  double*       J = pJ.data();
+
+#ifdef _OPENMP
+  #pragma omp simd
+#endif
+  for(int i = 0; i < n; i++){
+    J[i] = f[0*n+i]*f[4*n+i]*f[8*n+i] + f[1*n+i]*f[5*n+i]*f[6*n+i]
+         + f[2*n+i]*f[3*n+i]*f[7*n+i] - f[2*n+i]*f[4*n+i]*f[6*n+i]
+         - f[1*n+i]*f[3*n+i]*f[8*n+i] - f[0*n+i]*f[5*n+i]*f[7*n+i];
+  }
+
+  // cbrt has no vector variant without -ffast-math; keep it out of the
+  // loops that should vectorize
+  vector<double> oneOverJ23(n);
+  for(int i = 0; i < n; i++){
+    double cubeRootJ = cbrt(J[i]);
+    oneOverJ23[i]    = 1.0/(cubeRootJ*cubeRootJ);
+  }
+  const double* J23 = oneOverJ23.data();
+
+#ifdef _OPENMP
+  #pragma omp simd
+#endif
+  for(int i = 0; i < n; i++){
+    const double F00 = f[0*n+i], F01 = f[1*n+i], F02 = f[2*n+i];
+    const double F10 = f[3*n+i], F11 = f[4*n+i], F12 = f[5*n+i];
+    const double F20 = f[6*n+i], F21 = f[7*n+i], F22 = f[8*n+i];
+
+    // bElBar = F F^T / J^(2/3)
+    const double b00 = (F00*F00 + F01*F01 + F02*F02)*J23[i];
+    const double b01 = (F00*F10 + F01*F11 + F02*F12)*J23[i];
+    const double b02 = (F00*F20 + F01*F21 + F02*F22)*J23[i];
+    const double b11 = (F10*F10 + F11*F11 + F12*F12)*J23[i];
+    const double b12 = (F10*F20 + F11*F21 + F12*F22)*J23[i];
+    const double b22 = (F20*F20 + F21*F21 + F22*F22)*J23[i];
+
+    // tauDev = shear*dev(bElBar), p = bulk/2 (J - 1/J)
+    const double IEl      = onethird*(b00 + b11 + b22);
+    const double oneOverJ = 1.0/J[i];
+    const double p        = 0.5*bulk*(J[i] - oneOverJ);
+    const double G        = shear*oneOverJ;
+
+    b[0*n+i] = b00;  b[1*n+i] = b01;  b[2*n+i] = b02;
+    b[3*n+i] = b01;  b[4*n+i] = b11;  b[5*n+i] = b12;
+    b[6*n+i] = b02;  b[7*n+i] = b12;  b[8*n+i] = b22;
+
+    s[0*n+i] = p + (b00 - IEl)*G;  s[1*n+i] = b01*G;  s[2*n+i] = b02*G;
+    s[3*n+i] = b01*G;  s[4*n+i] = p + (b11 - IEl)*G;  s[5*n+i] = b12*G;
+    s[6*n+i] = b02*G;  s[7*n+i] = b12*G;  s[8*n+i] = p + (b22 - IEl)*G;
+  }
+
+  bEl.scatter(pset, bElBar_new);
+  sig.scatter(pset, pStress);
+}
+//______________________________________________________________________
 void UCNH::computeStressTensorImplicit(const PatchSubset* patches,
                                        const MPMMaterial* matl,
                                        DataWarehouse* old_dw,
@@ -248,6 +248,15 @@ namespace Uintah {
 
     void createPlasticityLabels();
 
+    /*! Stress update without plasticity for every particle in pset; it
+        depends only on F_new, so it runs on structure-of-arrays copies
+        and vectorizes.  Also returns J = det(F_new) per particle. */
+    void computeElasticStress(ParticleSubset* pset,
+                              constParticleVariable<Matrix3>& pDefGrad_new,
+                              ParticleVariable<Matrix3>& bElBar_new,
+                              ParticleVariable<Matrix3>& pStress,
+                              std::vector<double>& J) const;
+
   protected:
     // compute stress at each particle in the patch
     void computeStressTensorImplicit(const PatchSubset* patches,
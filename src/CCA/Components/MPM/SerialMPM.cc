@@ -25,6 +25,7 @@
 
 #include <CCA/Components/MPM/Core/MPMDiffusionLabel.h>
 #include <CCA/Components/MPM/Core/MPMBoundCond.h>
+#include <CCA/Components/MPM/Core/ParticleScatter.h>
 #include <CCA/Components/MPM/Materials/ConstitutiveModel/ConstitutiveModel.h>
 #include <CCA/Components/MPM/Materials/ConstitutiveModel/PlasticityModels/DamageModel.h>
 #include <CCA/Components/MPM/Materials/ConstitutiveModel/PlasticityModels/ErosionModel.h>
@@ -193,6 +194,10 @@ void SerialMPM::problemSetup(const ProblemSpecP& prob_spec,
                                  __FILE__, __LINE__);
   }
 
+  m_scheduler->setParticleCellSort(flags->d_particleCellSortInterval,
+                                   flags->d_particleCellSortOrder == "morton");
+  m_scheduler->setParticleShellScan(flags->d_particleShellScanInterval);
+
   // convert text representation of face into FaceType
   for(std::vector<std::string>::const_iterator ftit(flags->d_bndy_face_txt_list.begin());
       ftit!=flags->d_bndy_face_txt_list.end();ftit++) {
@@ -2392,99 +2397,141 @@ void SerialMPM::interpolateParticlesToGrid(const ProcessorGroup*,
 
       Vector total_mom(0.0,0.0,0.0);
       double pSp_vol = 1./mpm_matl->getInitialDensity();
+
+      // Particles are scattered in blocks; node k of particle b in a block
+      // is ni[k*nb + b], weight S[k*nb + b].  With particle_scatter_threads
+      // > 1 the blocks of one patch run on several threads (see
+      // ParticleScatter).  The CBDI corner forces reach nodes outside the
+      // particle's own stencil, so that path stays serial.
+      const int scatterThreads = flags->d_useCBDI ? 1 : flags->d_particleScatterThreads;
+      ParticleScatter scatter(patch, NGN, scatterThreads);
+      scatter.setup(pset, px);
+
+      const int numThreads = scatter.numThreads();
+      const int blockSize  = ParticleScatter::blockSize;
+      vector<Vector> thread_mom(numThreads, Vector(0.0,0.0,0.0));
+      vector<vector<IntVector> > thread_ni(numThreads,
+                                 vector<IntVector>(interpolator->size()*blockSize));
+      vector<vector<double> >    thread_S(numThreads,
+                                 vector<double>(interpolator->size()*blockSize));
+
       //loop over all particles in the patch:
-      for (ParticleSubset::iterator iter = pset->begin();
-           iter != pset->end();
-           iter++){
-        particleIndex idx = *iter;
-        int NN =
-           interpolator->findCellAndWeights(px[idx],ni,S,psize[idx]);
-        Vector pmom = pvelocity[idx]*pmass[idx];
-        double ptemp_ext = pTemperature[idx];
-        total_mom += pmom;
+      scatter.forEach([&](ParticleScatter::Block& blk) {
+        const int t  = blk.thread();
+        const int nb = blk.size();
+        IntVector* blk_ni = &thread_ni[t][0];
+        double*    blk_S  = &thread_S[t][0];
+
+        Point   blk_px[blockSize];
+        Matrix3 blk_psize[blockSize];
+        for (int b = 0; b < nb; b++) {
+          blk_px[b]    = px[blk[b]];
+          blk_psize[b] = psize[blk[b]];
+        }
+        const int NN = interpolator->findCellsAndWeights(nb, blk_px, blk_psize,
+                                                         blk_ni, blk_S);
 
-        // Add each particles contribution to the local mass & velocity
-        // Must use the node indices
-        IntVector node;
-        // Iterate through the nodes that receive data from the current particle
-        for(int k = 0; k < NN; k++) {
-          node = ni[k];
-          if(patch->containsNode(node)) {
-            if (flags->d_GEVelProj){
-              Point gpos = patch->getNodePosition(node);
-              Vector distance = px[idx] - gpos;
-              Vector pvel_ext = pvelocity[idx] - pVelGrad[idx]*distance;
-              pmom = pvel_ext*pmass[idx];
-              ptemp_ext = pTemperature[idx] - Dot(pTempGrad[idx],distance);
-            }
-            gmass[node]          += pmass[idx]                     * S[k];
-            gvelocity[node]      += pmom                           * S[k];
-            gvolume[node]        += pvolume[idx]                   * S[k];
-//            gColor[node]         += pColor[idx]*pmass[idx]         * S[k];
-            if (!flags->d_useCBDI) {
-              gexternalforce[node] += pexternalforce[idx]          * S[k];
-            }
-            gTemperature[node]   += ptemp_ext * pmass[idx] * S[k];
-            gSp_vol[node]        += pSp_vol   * pmass[idx] * S[k];
-            //gexternalheatrate[node] += pexternalheatrate[idx]      * S[k];
+        for (int b = 0; b < nb; b++) {
+          if (!blk.owns(blk_ni + b, NN, nb)) {
+            blk.defer(b);
+            continue;
           }
-        }
-        if (flags->d_doScalarDiffusion) {
-          double one_third = 1./3.;
-          double pHydroStress = one_third*pStress[idx].Trace();
-          double pConc_Ext = pConcentration[idx];
-          for (int k = 0; k < NN; ++k) {
-            node = ni[k];
-            if (patch->containsNode(node)) {
-              if (flags->d_GEVelProj) {
+          particleIndex idx = blk[b];
+          Vector pmom = pvelocity[idx]*pmass[idx];
+          double ptemp_ext = pTemperature[idx];
+          thread_mom[t] += pmom;
+
+          // Add each particles contribution to the local mass & velocity
+          // Must use the node indices
+          IntVector node;
+          // Iterate through the nodes that receive data from the current particle
+          for(int k = 0; k < NN; k++) {
+            node = blk_ni[k*nb + b];
+            const double Sk = blk_S[k*nb + b];
+            if(Sk != 0.0 && patch->containsNode(node)) {
+              if (flags->d_GEVelProj){
                 Point gpos = patch->getNodePosition(node);
-                Vector pointOffset = px[idx]-gpos;
-                pConc_Ext -= Dot(pConcGrad[idx],pointOffset);
+                Vector distance = px[idx] - gpos;
+                Vector pvel_ext = pvelocity[idx] - pVelGrad[idx]*distance;
+                pmom = pvel_ext*pmass[idx];
+                ptemp_ext = pTemperature[idx] - Dot(pTempGrad[idx],distance);
+              }
+              gmass[node]          += pmass[idx]                     * Sk;
+              gvelocity[node]      += pmom                           * Sk;
+              gvolume[node]        += pvolume[idx]                   * Sk;
+//              gColor[node]         += pColor[idx]*pmass[idx]         * Sk;
+              if (!flags->d_useCBDI) {
+                gexternalforce[node] += pexternalforce[idx]          * Sk;
               }
-              double massWeight = pmass[idx]*S[k];
-              gHydrostaticStress[node]  += pHydroStress             * massWeight;
-              gConcentration[node]      += pConc_Ext                * massWeight;
-              gExtScalarFlux[node]      += pExternalScalarFlux[idx] * massWeight;
+              gTemperature[node]   += ptemp_ext * pmass[idx] * Sk;
+              gSp_vol[node]        += pSp_vol   * pmass[idx] * Sk;
+              //gexternalheatrate[node] += pexternalheatrate[idx]      * Sk;
             }
           }
-        }
-        if (flags->d_useCBDI && pLoadCurveID[idx].x()>0) {
-          vector<IntVector> niCorner1(linear_interpolator->size());
-          vector<IntVector> niCorner2(linear_interpolator->size());
-          vector<IntVector> niCorner3(linear_interpolator->size());
-          vector<IntVector> niCorner4(linear_interpolator->size());
-          vector<double> SCorner1(linear_interpolator->size());
-          vector<double> SCorner2(linear_interpolator->size());
-          vector<double> SCorner3(linear_interpolator->size());
-          vector<double> SCorner4(linear_interpolator->size());
-          linear_interpolator->findCellAndWeights(pExternalForceCorner1[idx],
-                                 niCorner1,SCorner1,psize[idx]);
-          linear_interpolator->findCellAndWeights(pExternalForceCorner2[idx],
-                                 niCorner2,SCorner2,psize[idx]);
-          linear_interpolator->findCellAndWeights(pExternalForceCorner3[idx],
-                                 niCorner3,SCorner3,psize[idx]);
-          linear_interpolator->findCellAndWeights(pExternalForceCorner4[idx],
-                                 niCorner4,SCorner4,psize[idx]);
-          for(int k = 0; k < 8; k++) { // Iterates through the nodes which receive information from the current particle
-            node = niCorner1[k];
-            if(patch->containsNode(node)) {
-              gexternalforce[node] += pexternalforce[idx] * SCorner1[k];
-            }
-            node = niCorner2[k];
-            if(patch->containsNode(node)) {
-              gexternalforce[node] += pexternalforce[idx] * SCorner2[k];
-            }
-            node = niCorner3[k];
-            if(patch->containsNode(node)) {
-              gexternalforce[node] += pexternalforce[idx] * SCorner3[k];
+          if (flags->d_doScalarDiffusion) {
+            double one_third = 1./3.;
+            double pHydroStress = one_third*pStress[idx].Trace();
+            double pConc_Ext = pConcentration[idx];
+            // no zero-weight skip here: pConc_Ext accumulates over every
+            // node of the stencil, including those with zero weight
+            for (int k = 0; k < NN; ++k) {
+              node = blk_ni[k*nb + b];
+              const double Sk = blk_S[k*nb + b];
+              if (patch->containsNode(node)) {
+                if (flags->d_GEVelProj) {
+                  Point gpos = patch->getNodePosition(node);
+                  Vector pointOffset = px[idx]-gpos;
+                  pConc_Ext -= Dot(pConcGrad[idx],pointOffset);
+                }
+                double massWeight = pmass[idx]*Sk;
+                gHydrostaticStress[node]  += pHydroStress             * massWeight;
+                gConcentration[node]      += pConc_Ext                * massWeight;
+                gExtScalarFlux[node]      += pExternalScalarFlux[idx] * massWeight;
+              }
             }
-            node = niCorner4[k];
-            if(patch->containsNode(node)) {
-              gexternalforce[node] += pexternalforce[idx] * SCorner4[k];
+          }
+          if (flags->d_useCBDI && pLoadCurveID[idx].x()>0) {
+            vector<IntVector> niCorner1(linear_interpolator->size());
+            vector<IntVector> niCorner2(linear_interpolator->size());
+            vector<IntVector> niCorner3(linear_interpolator->size());
+            vector<IntVector> niCorner4(linear_interpolator->size());
+            vector<double> SCorner1(linear_interpolator->size());
+            vector<double> SCorner2(linear_interpolator->size());
+            vector<double> SCorner3(linear_interpolator->size());
+            vector<double> SCorner4(linear_interpolator->size());
+            linear_interpolator->findCellAndWeights(pExternalForceCorner1[idx],
+                                   niCorner1,SCorner1,psize[idx]);
+            linear_interpolator->findCellAndWeights(pExternalForceCorner2[idx],
+                                   niCorner2,SCorner2,psize[idx]);
+            linear_interpolator->findCellAndWeights(pExternalForceCorner3[idx],
+                                   niCorner3,SCorner3,psize[idx]);
+            linear_interpolator->findCellAndWeights(pExternalForceCorner4[idx],
+                                   niCorner4,SCorner4,psize[idx]);
+            for(int k = 0; k < 8; k++) { // Iterates through the nodes which receive information from the current particle
+              node = niCorner1[k];
+              if(patch->containsNode(node)) {
+                gexternalforce[node] += pexternalforce[idx] * SCorner1[k];
+              }
+              node = niCorner2[k];
+              if(patch->containsNode(node)) {
+                gexternalforce[node] += pexternalforce[idx] * SCorner2[k];
+              }
+              node = niCorner3[k];
+              if(patch->containsNode(node)) {
+                gexternalforce[node] += pexternalforce[idx] * SCorner3[k];
+              }
+              node = niCorner4[k];
+              if(patch->containsNode(node)) {
+                gexternalforce[node] += pexternalforce[idx] * SCorner4[k];
+              }
             }
           }
         }
-      } // End of particle loop
+      }); // End of particle loop
+
+      for (int t = 0; t < numThreads; t++) {
+        total_mom += thread_mom[t];
+      }
       for(NodeIterator iter=patch->getExtraNodeIterator();
                        !iter.done();iter++){
         IntVector c = *iter;
@@ -3023,63 +3070,68 @@ void SerialMPM::computeInternalForce(const ProcessorGroup*,
 
       internalforce.initialize(Vector(0,0,0));
 
-      Matrix3 stressvol;
-      Matrix3 stresspress;
+      // Scatter the particles' stress divergence to the nodes, possibly on
+      // several threads (see ParticleScatter); each thread has its own
+      // weight buffers
+      ParticleScatter scatter(patch, NGN, flags->d_particleScatterThreads);
+      scatter.setup(pset, px);
 
-      // for the non axisymmetric case:
-      if(!flags->d_axisymmetric){
-        for (ParticleSubset::iterator iter = pset->begin();
-             iter != pset->end();
-             iter++){
-          particleIndex idx = *iter;
+      const int numThreads = scatter.numThreads();
+      vector<vector<IntVector> > thread_ni(numThreads, ni);
+      vector<vector<double> >    thread_S(numThreads, S);
+      vector<vector<Vector> >    thread_d_S(numThreads, d_S);
+
+      scatter.forEach([&](ParticleScatter::Block& blk) {
+        const int t = blk.thread();
+        vector<IntVector>& ni  = thread_ni[t];
+        vector<double>&    S   = thread_S[t];
+        vector<Vector>&    d_S = thread_d_S[t];
+
+        for (int b = 0; b < blk.size(); b++) {
+          particleIndex idx = blk[b];
 
           // Get the node indices that surround the cell
           int NN =
             interpolator->findCellAndWeightsAndShapeDerivatives(px[idx],ni,S,
                                                      d_S,psize[idx]);
-          stressvol  = pstress[idx]*pvol[idx];
-          stresspress = pstress[idx] + Id*(p_pressure[idx] - p_q[idx]);
+          if (!blk.owns(&ni[0], NN)) {
+            blk.defer(b);
+            continue;
+          }
 
-          for (int k = 0; k < NN; k++){
-            if(patch->containsNode(ni[k])){
-              Vector div(d_S[k].x()*oodx[0],d_S[k].y()*oodx[1],
-                         d_S[k].z()*oodx[2]);
-              internalforce[ni[k]] -= (div * stresspress)  * pvol[idx];
-              gstress[ni[k]]       += stressvol * S[k];
+          Matrix3 stressvol  = pstress[idx]*pvol[idx];
+          Matrix3 stresspress = pstress[idx] + Id*(p_pressure[idx] - p_q[idx]);
+
+          // for the non axisymmetric case:
+          if(!flags->d_axisymmetric){
+            for (int k = 0; k < NN; k++){
+              if(patch->containsNode(ni[k])){
+                Vector div(d_S[k].x()*oodx[0],d_S[k].y()*oodx[1],
+                           d_S[k].z()*oodx[2]);
+                internalforce[ni[k]] -= (div * stresspress)  * pvol[idx];
+                gstress[ni[k]]       += stressvol * S[k];
+              }
             }
           }
-        }
-      }
-
-      // for the axisymmetric case
-      if(flags->d_axisymmetric){
-        for (ParticleSubset::iterator iter = pset->begin();
-             iter != pset->end();
-             iter++){
-          particleIndex idx = *iter;
-
-          int NN =
-            interpolator->findCellAndWeightsAndShapeDerivatives(px[idx],ni,S,
-                                                   d_S,psize[idx]);
-
-          stressvol   = pstress[idx]*pvol[idx];
-          stresspress = pstress[idx] + Id*(p_pressure[idx] - p_q[idx]);
 
+          // for the axisymmetric case
           // r is the x direction, z (axial) is the y direction
-          double IFr=0.,IFz=0.;
-          for (int k = 0; k < NN; k++){
-            if(patch->containsNode(ni[k])){
-              IFr = d_S[k].x()*oodx[0]*stresspress(0,0) +
-                    d_S[k].y()*oodx[1]*stresspress(0,1) +
-                    d_S[k].z()*stresspress(2,2);
-              IFz = d_S[k].x()*oodx[0]*stresspress(0,1)
-                  + d_S[k].y()*oodx[1]*stresspress(1,1);
-              internalforce[ni[k]] -=  Vector(IFr,IFz,0.0) * pvol[idx];
-              gstress[ni[k]]       += stressvol * S[k];
+          else{
+            double IFr=0.,IFz=0.;
+            for (int k = 0; k < NN; k++){
+              if(patch->containsNode(ni[k])){
+                IFr = d_S[k].x()*oodx[0]*stresspress(0,0) +
+                      d_S[k].y()*oodx[1]*stresspress(0,1) +
+                      d_S[k].z()*stresspress(2,2);
+                IFz = d_S[k].x()*oodx[0]*stresspress(0,1)
+                    + d_S[k].y()*oodx[1]*stresspress(1,1);
+                internalforce[ni[k]] -=  Vector(IFr,IFz,0.0) * pvol[idx];
+                gstress[ni[k]]       += stressvol * S[k];
+              }
             }
           }
         }
-      }
+      });
 
       for(NodeIterator iter =patch->getNodeIterator();!iter.done();iter++){
         IntVector c = *iter;
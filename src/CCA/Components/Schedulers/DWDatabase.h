@@ -40,6 +40,10 @@
 #include <Core/Util/FancyAssert.h>
 #include <Core/Util/DOUT.hpp>
 
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <mutex>
 #include <ostream>
 #include <sstream>
 #include <string>
@@ -68,17 +72,13 @@
 
   DESCRIPTION
 
+    Each DWDatabase guards its variables with its own set of shard locks, indexed
+    by (real) domain, so tasks working on different patches never serialize on a
+    database lock. Inserting a new key (init == true, copy timesteps only) resizes
+    m_vars and therefore takes every shard.
 
 ****************************************/
 
-
-namespace {
-
-Uintah::MasterLock g_keyDB_lock{};
-Uintah::MasterLock g_mvars_lock{};
-
-}
-
 namespace Uintah {
 
 
@@ -107,15 +107,44 @@ public:
 
   void merge( const KeyDatabase<DomainType>& newDB );
 
+  // Once the key set is known (task graph compiled), lay the keys out in a dense
+  // (label, matl, domain) table so lookup is array arithmetic instead of hashing.
+  // Keys inserted afterwards go in the table when they fit its layout; otherwise
+  // lookup falls back to the hash map for keys the table does not know.
+  void freeze();
+
   void print( const int rank ) const;
 
 private:
 
+  // adds the key if new, returns its index
+  int addKey( const VarLabelMatl<DomainType> & key );
+
+  // position of the key in m_dense_keys, -1 if outside the frozen layout
+  inline int densePosition( const VarLabel   * label
+                          ,       int          matlIndex
+                          , const DomainType * realDom
+                          ) const;
+
   using keyDBtype = std::unordered_map<VarLabelMatl<DomainType>, int>;
   keyDBtype m_keys;
 
   int m_key_count { 0 };
 
+  // dense layout, see freeze()
+  static constexpr size_t s_max_dense_keys   = 1 << 24;
+  static constexpr size_t s_max_domain_span  = 1 << 22;
+
+  bool             m_frozen           { false };
+  bool             m_dense_complete   { false };  // every key is in m_dense_keys, so a dense miss is authoritative
+  std::vector<int> m_label_rows       {};         // VarLabel::getDenseID() -> row, -1 if the label has no keys
+  int              m_num_rows         { 0 };
+  int              m_num_matl_slots   { 0 };      // matl index + 1 (level-independent variables use matl -1)
+  int              m_min_domain_id    { 0 };
+  std::vector<int> m_domain_slots     {};         // getDenseDomainID() - m_min_domain_id -> domain slot, -1 if none
+  std::vector<const DomainType*> m_slot_domains {};  // domain slot -> domain, only the domains that have keys
+  std::vector<int> m_dense_keys       {};         // (row, matl slot, domain slot) -> key index, -1 if none
+
 };
 
 
@@ -253,6 +282,18 @@ class DWDatabase {
                          , const DomainType * dom
                          ) const;
 
+    // number of shard locks, must be a power of two
+    static constexpr int s_num_shards = 64;
+
+    // the shard guarding all variables of this domain
+    Uintah::MasterLock & shardLock( const DomainType * dom ) const;
+
+    // for key inserts that resize m_vars, shards are always taken in index order
+    void lockAllShards() const;
+    void unlockAllShards() const;
+
+    mutable std::array<Uintah::MasterLock, s_num_shards> m_shard_locks {};
+
     KeyDatabase<DomainType>* m_keyDB { nullptr };
 
     using varDBtype = std::vector<DataItem*>;
@@ -290,6 +331,41 @@ void DWDatabase<DomainType>::clear()
   m_vars.clear();
 }
 
+//______________________________________________________________________
+//
+template<class DomainType>
+inline
+Uintah::MasterLock &
+DWDatabase<DomainType>::shardLock( const DomainType * dom ) const
+{
+  // drop the low (allocation alignment) bits of the domain address before folding
+  size_t h = reinterpret_cast<size_t>(getRealDomain(dom)) >> 4;
+  h ^= (h >> 7) ^ (h >> 13);
+  return m_shard_locks[h & (s_num_shards - 1)];
+}
+
+//______________________________________________________________________
+//
+template<class DomainType>
+void
+DWDatabase<DomainType>::lockAllShards() const
+{
+  for (auto & shard_lock : m_shard_locks) {
+    shard_lock.lock();
+  }
+}
+
+//______________________________________________________________________
+//
+template<class DomainType>
+void
+DWDatabase<DomainType>::unlockAllShards() const
+{
+  for (auto iter = m_shard_locks.rbegin(); iter != m_shard_locks.rend(); ++iter) {
+    iter->unlock();
+  }
+}
+
 //______________________________________________________________________
 //
 template<class DomainType>
@@ -321,7 +397,7 @@ DWDatabase<DomainType>::decrementScrubCount( const VarLabel   * label
 
   ASSERT(matlIndex >= -1);
 
-  std::lock_guard<Uintah::MasterLock> decrement_scrub_count_lock(g_keyDB_lock);
+  std::lock_guard<Uintah::MasterLock> decrement_scrub_count_lock(shardLock(dom));
 
   int idx = m_keyDB->lookup(label, matlIndex, dom);
   if (idx == -1) {
@@ -350,7 +426,7 @@ DWDatabase<DomainType>::setScrubCount( const VarLabel   * label
                                      ,       int          count
                                      )
 {
-  std::lock_guard<Uintah::MasterLock> set_scrub_count_lock(g_keyDB_lock);
+  std::lock_guard<Uintah::MasterLock> set_scrub_count_lock(shardLock(dom));
 
   int idx = m_keyDB->lookup(label, matlIndex, dom);
   if (idx == -1) {
@@ -370,7 +446,7 @@ DWDatabase<DomainType>::scrub( const VarLabel   * label
 {
   ASSERT(matlIndex >= -1);
 
-  std::lock_guard<Uintah::MasterLock> scrub_lock(g_keyDB_lock);
+  std::lock_guard<Uintah::MasterLock> scrub_lock(shardLock(dom));
 
   int idx = m_keyDB->lookup(label, matlIndex, dom);
   if (idx != -1 && m_vars[idx]) {
@@ -420,6 +496,35 @@ DWDatabase<DomainType>::initializeScrubs(       int                        dwid
   }
 }
 
+//______________________________________________________________________
+//
+template<class DomainType>
+inline
+int
+KeyDatabase<DomainType>::densePosition( const VarLabel   * label
+                                      ,       int          matlIndex
+                                      , const DomainType * realDom
+                                      ) const
+{
+  const int label_id = label->getDenseID();
+  if (label_id < 0 || label_id >= static_cast<int>(m_label_rows.size())) {
+    return -1;
+  }
+  const int row = m_label_rows[label_id];
+  const int matl_slot = matlIndex + 1;
+  const int domain_id = getDenseDomainID(realDom) - m_min_domain_id;
+  if (row < 0 || matl_slot < 0 || matl_slot >= m_num_matl_slots || domain_id < 0 || domain_id >= static_cast<int>(m_domain_slots.size())) {
+    return -1;
+  }
+  // a domain of another grid (the old one after a regrid) can have the same id
+  const int domain_slot = m_domain_slots[domain_id];
+  if (domain_slot < 0 || m_slot_domains[domain_slot] != realDom) {
+    return -1;
+  }
+  const int num_domain_slots = static_cast<int>(m_slot_domains.size());
+  return (row * m_num_matl_slots + matl_slot) * num_domain_slots + domain_slot;
+}
+
 //______________________________________________________________________
 //
 template<class DomainType>
@@ -429,7 +534,23 @@ KeyDatabase<DomainType>::lookup( const VarLabel   * label
                                , const DomainType * dom
                                )
 {
-  VarLabelMatl<DomainType> v(label, matlIndex, getRealDomain(dom));
+  const DomainType* realDom = getRealDomain(dom);
+
+  if (m_frozen) {
+    const int pos = densePosition(label, matlIndex, realDom);
+    if (pos >= 0) {
+      const int idx = m_dense_keys[pos];
+      if (idx >= 0 || m_dense_complete) {
+        return idx;
+      }
+    }
+    else if (m_dense_complete) {
+      return -1;
+    }
+  }
+
+  // dynamic keys, or not frozen yet
+  VarLabelMatl<DomainType> v(label, matlIndex, realDom);
   typename keyDBtype::const_iterator const_iter = m_keys.find(v);
   if (const_iter == m_keys.end()) {
     return -1;
@@ -439,6 +560,32 @@ KeyDatabase<DomainType>::lookup( const VarLabel   * label
   }
 }
 
+//______________________________________________________________________
+//
+template<class DomainType>
+int
+KeyDatabase<DomainType>::addKey( const VarLabelMatl<DomainType> & key )
+{
+  typename keyDBtype::const_iterator const_iter = m_keys.find(key);
+  if (const_iter != m_keys.end()) {
+    return const_iter->second;
+  }
+
+  const int idx = m_key_count++;
+  m_keys.insert(std::pair<VarLabelMatl<DomainType>, int>(key, idx));
+
+  if (m_frozen) {
+    const int pos = densePosition(key.m_label, key.m_matl_index, key.m_domain);
+    if (pos >= 0) {
+      m_dense_keys[pos] = idx;
+    }
+    else {
+      m_dense_complete = false;
+    }
+  }
+  return idx;
+}
+
 //______________________________________________________________________
 //
 template<class DomainType>
@@ -446,10 +593,7 @@ void
 KeyDatabase<DomainType>::merge( const KeyDatabase<DomainType> & newDB )
 {
   for (typename keyDBtype::const_iterator const_keyiter = newDB.m_keys.cbegin(); const_keyiter != newDB.m_keys.cend(); ++const_keyiter) {
-    typename keyDBtype::const_iterator const_db_iter = m_keys.find(const_keyiter->first);
-    if (const_db_iter == m_keys.end()) {
-      m_keys.insert(std::pair<VarLabelMatl<DomainType>, int>(const_keyiter->first, m_key_count++));
-    }
+    addKey(const_keyiter->first);
   }
 }
 
@@ -462,11 +606,78 @@ KeyDatabase<DomainType>::insert( const VarLabel   * label
                                , const DomainType * dom
                                )
 {
-  VarLabelMatl<DomainType> v(label, matlIndex, getRealDomain(dom));
-  typename keyDBtype::const_iterator const_iter = m_keys.find(v);
-  if (const_iter == m_keys.end()) {
-    m_keys.insert(std::pair<VarLabelMatl<DomainType>, int>(v, m_key_count++));
+  addKey(VarLabelMatl<DomainType>(label, matlIndex, getRealDomain(dom)));
+}
+
+//______________________________________________________________________
+//
+template<class DomainType>
+void
+KeyDatabase<DomainType>::freeze()
+{
+  m_frozen = false;
+  m_dense_complete = false;
+  m_label_rows.assign(VarLabel::numDenseIDs(), -1);
+  m_domain_slots.clear();
+  m_slot_domains.clear();
+  m_dense_keys.clear();
+
+  if (m_keys.empty()) {
+    return;
   }
+
+  // extents of the layout
+  int max_matl = -1;
+  int min_domain_id = std::numeric_limits<int>::max();
+  int max_domain_id = std::numeric_limits<int>::min();
+  m_num_rows = 0;
+  for (auto keyiter = m_keys.begin(); keyiter != m_keys.end(); ++keyiter) {
+    const VarLabelMatl<DomainType>& vlm = keyiter->first;
+    const int label_id = vlm.m_label->getDenseID();
+    if (label_id < 0 || label_id >= static_cast<int>(m_label_rows.size()) || vlm.m_matl_index < -1) {
+      return;  // not representable, stay with the hash map
+    }
+    if (m_label_rows[label_id] < 0) {
+      m_label_rows[label_id] = m_num_rows++;
+    }
+    max_matl = std::max(max_matl, vlm.m_matl_index);
+    min_domain_id = std::min(min_domain_id, getDenseDomainID(vlm.m_domain));
+    max_domain_id = std::max(max_domain_id, getDenseDomainID(vlm.m_domain));
+  }
+
+  const size_t domain_span = static_cast<size_t>(max_domain_id) - min_domain_id + 1;
+  if (domain_span > s_max_domain_span) {
+    return;  // stay with the hash map
+  }
+
+  // only the domains this rank has keys for (its own and neighboring patches) get a slot
+  m_num_matl_slots = max_matl + 2;
+  m_min_domain_id = min_domain_id;
+  m_domain_slots.assign(domain_span, -1);
+  for (auto keyiter = m_keys.begin(); keyiter != m_keys.end(); ++keyiter) {
+    const DomainType* dom = keyiter->first.m_domain;
+    int& domain_slot = m_domain_slots[getDenseDomainID(dom) - min_domain_id];
+    if (domain_slot < 0) {
+      domain_slot = static_cast<int>(m_slot_domains.size());
+      m_slot_domains.push_back(dom);
+    }
+    else if (m_slot_domains[domain_slot] != dom) {
+      return;  // two domains with one id, stay with the hash map
+    }
+  }
+
+  const size_t num_dense = static_cast<size_t>(m_num_rows) * m_num_matl_slots * m_slot_domains.size();
+  if (num_dense > s_max_dense_keys) {
+    return;  // too sparse to be worth the memory, stay with the hash map
+  }
+
+  m_dense_keys.assign(num_dense, -1);
+  m_frozen = true;
+  for (auto keyiter = m_keys.begin(); keyiter != m_keys.end(); ++keyiter) {
+    const VarLabelMatl<DomainType>& vlm = keyiter->first;
+    m_dense_keys[densePosition(vlm.m_label, vlm.m_matl_index, vlm.m_domain)] = keyiter->second;
+  }
+  m_dense_complete = true;
 }
 
 //______________________________________________________________________
@@ -477,6 +688,13 @@ KeyDatabase<DomainType>::clear()
 {
   m_keys.clear();
   m_key_count = 0;
+
+  m_frozen = false;
+  m_dense_complete = false;
+  m_label_rows.clear();
+  m_domain_slots.clear();
+  m_slot_domains.clear();
+  m_dense_keys.clear();
 }
 
 //______________________________________________________________________
@@ -519,7 +737,7 @@ DWDatabase<DomainType>::exists( const VarLabel   * label
                               , const DomainType * dom
                               ) const
 {
-  std::lock_guard<Uintah::MasterLock> exists_lock(g_keyDB_lock);
+  std::lock_guard<Uintah::MasterLock> exists_lock(shardLock(dom));
 
   int idx = m_keyDB->lookup(label, matlIndex, dom);
   if (idx == -1) {
@@ -545,13 +763,16 @@ DWDatabase<DomainType>::put( const VarLabel   * label
 {
   ASSERT(matlIndex >= -1);
 
-  std::lock_guard<Uintah::MasterLock> put_lock(g_keyDB_lock);
-
+  // a new key may resize m_vars, which no other shard may be reading meanwhile
   if (init) {
+    lockAllShards();
     m_keyDB->insert(label, matlIndex, dom);
     this->doReserve(m_keyDB);
+    unlockAllShards();
   }
 
+  std::lock_guard<Uintah::MasterLock> put_lock(shardLock(dom));
+
   int idx = m_keyDB->lookup(label, matlIndex, dom);
   if (idx == -1) {
     SCI_THROW(UnknownVariable(label->getName(), -1, dom, matlIndex, "DWDatabase::put", __FILE__, __LINE__));
@@ -586,13 +807,16 @@ DWDatabase<DomainType>::putReduce( const VarLabel              * label
 {
   ASSERT(matlIndex >= -1);
 
-  std::lock_guard<Uintah::MasterLock> put_reduce_lock(g_keyDB_lock);
-
+  // a new key may resize m_vars, which no other shard may be reading meanwhile
   if (init) {
+    lockAllShards();
     m_keyDB->insert(label, matlIndex, dom);
     this->doReserve(m_keyDB);
+    unlockAllShards();
   }
 
+  std::lock_guard<Uintah::MasterLock> put_reduce_lock(shardLock(dom));
+
   int idx = m_keyDB->lookup(label, matlIndex, dom);
   if (idx == -1) {
     SCI_THROW(UnknownVariable(label->getName(), -1, dom, matlIndex, "DWDatabase::putReduce", __FILE__, __LINE__));
@@ -629,13 +853,16 @@ DWDatabase<DomainType>::putForeign( const VarLabel   * label
 {
   ASSERT(matlIndex >= -1);
 
-  std::lock_guard<Uintah::MasterLock> put_foreign_lock(g_keyDB_lock);
-
+  // a new key may resize m_vars, which no other shard may be reading meanwhile
   if (init) {
+    lockAllShards();
     m_keyDB->insert(label, matlIndex, dom);
     this->doReserve(m_keyDB);
+    unlockAllShards();
   }
 
+  std::lock_guard<Uintah::MasterLock> put_foreign_lock(shardLock(dom));
+
   int idx = m_keyDB->lookup(label, matlIndex, dom);
   if (idx == -1) {
     SCI_THROW(UnknownVariable(label->getName(), -1, dom, matlIndex, "DWDatabase::putForeign", __FILE__, __LINE__));
@@ -677,7 +904,7 @@ DWDatabase<DomainType>::get( const VarLabel   * label
                            , const DomainType * dom
                            ) const
 {
-  std::lock_guard<Uintah::MasterLock> get_lock(g_keyDB_lock);
+  std::lock_guard<Uintah::MasterLock> get_lock(shardLock(dom));
 
   const DataItem* dataItem = getDataItem(label, matlIndex, dom);
   ASSERT(dataItem != nullptr);          // should have thrown an exception before
@@ -709,7 +936,7 @@ DWDatabase<DomainType>::getlist( const VarLabel               * label
                                ,       std::vector<Variable*> & varlist
                                ) const
 {
-  std::lock_guard<Uintah::MasterLock> get_list_lock(g_keyDB_lock);
+  std::lock_guard<Uintah::MasterLock> get_list_lock(shardLock(dom));
 
   for (DataItem* dataItem = getDataItem(label, matlIndex, dom); dataItem != nullptr; dataItem = dataItem->m_next) {
     varlist.push_back(dataItem->m_var);
@@ -773,7 +1000,7 @@ template<class DomainType>
 void
 DWDatabase<DomainType>::getVarLabelMatlTriples( std::vector<VarLabelMatl<DomainType> > & v) const
 {
-  std::lock_guard<Uintah::MasterLock> get_var_label_mat_triples_lock(g_keyDB_lock);
+  lockAllShards();
 
   for (auto keyiter = m_keyDB->m_keys.begin(); keyiter != m_keyDB->m_keys.end(); ++keyiter) {
     const VarLabelMatl<DomainType>& vlm = keyiter->first;
@@ -781,6 +1008,8 @@ DWDatabase<DomainType>::getVarLabelMatlTriples( std::vector<VarLabelMatl<DomainT
       v.push_back(vlm);
     }
   }
+
+  unlockAllShards();
 }
 
 } // namespace Uintah
@@ -25,6 +25,7 @@
 #include <CCA/Components/Schedulers/DependencyBatch.h>
 
 #include <Core/Parallel/MasterLock.h>
+#include <Core/Parallel/PackBufferInfo.h>
 #include <Core/Util/DOUT.hpp>
 
 #include <sstream>
@@ -65,6 +66,28 @@ DependencyBatch::~DependencyBatch()
     delete dep;
     dep = tmp;
   }
+
+  freePersistentRequest();
+}
+
+//_____________________________________________________________________________
+//
+void
+DependencyBatch::freePersistentRequest()
+{
+  if (m_persistent_request != MPI_REQUEST_NULL) {
+    int finalized = 0;
+    Uintah::MPI::Finalized(&finalized);
+    if (!finalized) {
+      Uintah::MPI::Request_free(&m_persistent_request);
+    }
+    m_persistent_request = MPI_REQUEST_NULL;
+  }
+
+  if (m_persistent_buffer && m_persistent_buffer->removeReference()) {
+    delete m_persistent_buffer;
+  }
+  m_persistent_buffer = nullptr;
 }
 
 //_____________________________________________________________________________
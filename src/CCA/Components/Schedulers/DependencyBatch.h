@@ -27,6 +27,8 @@
 
 #include <CCA/Components/Schedulers/DetailedTasks.h>
 
+#include <Core/Parallel/UintahMPI.h>
+
 #include <list>
 #include <map>
 #include <vector>
@@ -34,6 +36,7 @@
 namespace Uintah {
 
 class DetailedDep;
+class PackedBuffer;
 class ProcessorGroup;
 class Variable;
 class VarLabel;
@@ -63,6 +66,9 @@ public:
   // Add invalid variables to dep batch. These variables will be marked as valid when MPI completes.
   void addVar( Variable * var );
 
+  // Release the persistent request and its packed buffer, e.g. when the packed size changed.
+  void freePersistentRequest();
+
   DependencyBatch          * m_comp_next{nullptr};
   DetailedTask             * m_from_task{nullptr};
   DetailedDep              * m_head{nullptr};
@@ -70,6 +76,11 @@ public:
   int                        m_message_tag{-1};
   int                        m_to_rank{-1};
 
+  // Persistent (MPI_Send_init/MPI_Recv_init) request and the packed buffer it is bound to.
+  // Both live as long as the batch, i.e. until the task graph is recompiled.
+  MPI_Request                m_persistent_request{MPI_REQUEST_NULL};
+  PackedBuffer             * m_persistent_buffer{nullptr};
+
 
 private:
 
@@ -25,6 +25,7 @@
 #include <CCA/Components/Schedulers/DetailedTask.h>
 #include <CCA/Components/Schedulers/DetailedTasks.h>
 #include <CCA/Components/Schedulers/DependencyBatch.h>
+#include <CCA/Components/Schedulers/NUMAPlacement.h>
 #include <CCA/Components/Schedulers/OnDemandDataWarehouse.h>
 #include <CCA/Components/Schedulers/SchedulerCommon.h>
 
@@ -50,9 +51,8 @@
 using namespace Uintah;
 
 
-// declared in DetailedTasks.cc - used in both places to protect external ready queue (hence, extern here)
+// declared in DetailedTasks.cc
 namespace Uintah {
-  extern Uintah::MasterLock g_external_ready_mutex;
   extern Dout               g_scrubbing_dbg;
   extern std::string        g_var_scrub_dbg;
   extern int                g_patch_scrub_dbg;
@@ -141,6 +141,12 @@ DetailedTask::doit( const ProcessorGroup                      * pg
     }
   }
 
+  if (NUMAPlacement::isEnabled() && m_patches != nullptr) {
+    for (int p = 0; p < m_patches->size(); ++p) {
+      NUMAPlacement::countAccess(m_patches->get(p));
+    }
+  }
+
   // Start loading up the UintahParams object
   UintahParams uintahParams;
   uintahParams.setProcessorGroup(pg);
@@ -208,6 +214,7 @@ DetailedTask::scrub( std::vector<OnDemandDataWarehouseP> & dws )
 
   const std::set<const VarLabel*, VarLabel::Compare> & initialRequires = m_task_group->getSchedulerCommon()->getInitialRequiredVars();
   const std::set<std::string>                        &   unscrubbables = m_task_group->getSchedulerCommon()->getNoScrubVars();
+  const std::set<std::string>                        &   timeStepUnscrubbables = m_task_group->getSchedulerCommon()->getTimeStepNoScrubVars();
 
   // Decrement the scrub count for each of the required variables
   for (const Task::Dependency* req = task->getRequires(); req != nullptr; req = req->m_next) {
@@ -220,7 +227,8 @@ DetailedTask::scrub( std::vector<OnDemandDataWarehouseP> & dws )
       if (scrubmode == DataWarehouse::ScrubComplete
           || (scrubmode == DataWarehouse::ScrubNonPermanent && initialRequires.find(req->m_var) == initialRequires.end())) {
 
-        if (unscrubbables.find(req->m_var->getName()) != unscrubbables.end())
+        if (unscrubbables.find(req->m_var->getName()) != unscrubbables.end()
+            || timeStepUnscrubbables.find(req->m_var->getName()) != timeStepUnscrubbables.end())
           continue;
 
         constHandle<PatchSubset> patches = req->getPatchesUnderDomain(getPatches());
@@ -296,7 +304,8 @@ DetailedTask::scrub( std::vector<OnDemandDataWarehouseP> & dws )
     if (scrubmode == DataWarehouse::ScrubComplete
         || (scrubmode == DataWarehouse::ScrubNonPermanent && initialRequires.find(mod->m_var) == initialRequires.end())) {
 
-      if (unscrubbables.find(mod->m_var->getName()) != unscrubbables.end())
+      if (unscrubbables.find(mod->m_var->getName()) != unscrubbables.end()
+          || timeStepUnscrubbables.find(mod->m_var->getName()) != timeStepUnscrubbables.end())
         continue;
 
       constHandle<PatchSubset> patches = mod->getPatchesUnderDomain(getPatches());
@@ -331,7 +340,8 @@ DetailedTask::scrub( std::vector<OnDemandDataWarehouseP> & dws )
         constHandle<PatchSubset> patches = comp->getPatchesUnderDomain(getPatches());
         constHandle<MaterialSubset> matls = comp->getMaterialsUnderDomain(getMaterials());
 
-        if (unscrubbables.find(comp->m_var->getName()) != unscrubbables.end()) {
+        if (unscrubbables.find(comp->m_var->getName()) != unscrubbables.end()
+            || timeStepUnscrubbables.find(comp->m_var->getName()) != timeStepUnscrubbables.end()) {
           continue;
         }
 
@@ -430,14 +440,14 @@ DetailedTask::addInternalRequires( DependencyBatch * req )
 void
 DetailedTask::checkExternalDepCount()
 {
-  std::lock_guard<Uintah::MasterLock> external_ready_guard(g_external_ready_mutex);
-
   DOUT(g_external_deps_dbg, "Rank-" << Parallel::getMPIRank() << " Task " << this->getTask()->getName() << " external deps: "
                                     << m_external_dependency_count.load(std::memory_order_acquire)
                                     << " internal deps: " << m_num_pending_internal_dependencies);
 
-  if ((m_external_dependency_count.load(std::memory_order_acquire) == 0) && m_task_group->m_sched_common->useInternalDeps() &&
-       m_initiated.load(std::memory_order_acquire) && !m_task->usesMPI()) {
+  // No lock is held here; the seq_cst loads pair with the seq_cst stores in markInitiated() and
+  // decrementExternalDepCount() so at least one of the racing callers sees both conditions met.
+  if ((m_external_dependency_count.load(std::memory_order_seq_cst) == 0) && m_task_group->m_sched_common->useInternalDeps() &&
+       m_initiated.load(std::memory_order_seq_cst) && !m_task->usesMPI()) {
 
     DOUT(g_external_deps_dbg, "Rank-" << Parallel::getMPIRank() << " Task " << this->getTask()->getName()
                                       << " MPI requirements satisfied, placing into external ready queue");
@@ -453,10 +463,10 @@ DetailedTask::checkExternalDepCount()
       }
     }
 
-    if (m_externally_ready.load(std::memory_order_acquire) == false) {
-      m_task_group->m_mpi_completed_tasks.push(this);
-      m_task_group->m_atomic_mpi_completed_tasks_size.fetch_add(1);
-      m_externally_ready.store(true, std::memory_order_release);
+    // only the caller that flips m_externally_ready queues the task
+    bool expected = false;
+    if (m_externally_ready.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+      m_task_group->addExternalReadyTask(this);
     }
   }
 }
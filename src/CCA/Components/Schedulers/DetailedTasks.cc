@@ -44,6 +44,7 @@
   #include <Core/Parallel/CrowdMonitor.hpp>
 #endif
 
+#include <algorithm>
 #include <atomic>
 #include <sstream>
 #include <string>
@@ -51,9 +52,6 @@
 using namespace Uintah;
 
 namespace Uintah {
-  // Used externally in DetailedTask.cc
-  Uintah::MasterLock g_external_ready_mutex{}; // synchronizes access to the external-ready task queue
-
   // used externally in DetailedTask.cc
   Dout g_scrubbing_dbg(      "Scrubbing", "DetailedTasks", "report var scrubbing: see DetailedTasks.cc for usage", false);
   
@@ -65,8 +63,6 @@ namespace Uintah {
 
 namespace {
 
-  Uintah::MasterLock g_internal_ready_mutex{}; // synchronizes access to the internal-ready task queue
-  
   Dout g_detailed_dw_dbg(    "DetailedDWDBG", "DetailedTasks", "report when var is saved in varDB", false);
   Dout g_detailed_tasks_dbg( "DetailedTasks", "DetailedTasks", "general bdg info for DetailedTasks", false);
   Dout g_message_tags_dbg(           "MessageTags",         "DetailedTasks", "info on MPI message tag assignment", false);
@@ -91,6 +87,15 @@ namespace {
   using  host_ready_queue_monitor               = Uintah::CrowdMonitor<host_ready_queue_tag>;
 #endif
 
+  Uintah::MasterLock g_internal_ready_mutex{}; // synchronizes access to the internal-ready FIFO
+
+  // one shard for the single-threaded schedulers keeps their task ordering exact
+  int numReadyQueueShards()
+  {
+    int nthreads = std::max(Uintah::Parallel::getNumThreads(), Uintah::Parallel::getNumPartitions());
+    return (nthreads > 1) ? 2 * nthreads : 1;
+  }
+
 }
 
 
@@ -106,6 +111,9 @@ DetailedTasks::DetailedTasks(       SchedulerCommon         * sc
   , m_proc_group{pg}
   , m_task_graph{taskgraph}
   , m_must_consider_internal_deps{mustConsiderInternalDependencies}
+  , m_ready_tasks_sharded{numReadyQueueShards() > 1}
+  , m_sharded_ready_tasks{numReadyQueueShards()}
+  , m_mpi_completed_tasks{numReadyQueueShards()}
 {
   // Set up mappings for the initial send tasks
   int dwmap[Task::TotalDWs];
@@ -331,7 +339,7 @@ DetailedTasks::computeLocalTasks()
   }
 
   int order = 0;
-  m_initial_ready_tasks = TaskQueue();
+  m_initial_ready_tasks.clear();
   for (auto i = 0u; i < m_tasks.size(); i++) {
     DetailedTask* task = m_tasks[i];
 
@@ -341,7 +349,7 @@ DetailedTasks::computeLocalTasks()
       m_local_tasks.push_back(task);
 
       if (task->areInternalDependenciesSatisfied()) {
-        m_initial_ready_tasks.push(task);
+        m_initial_ready_tasks.push_back(task);
       }
       task->assignStaticOrder(++order);
     }
@@ -930,10 +938,15 @@ DetailedTasks::getOldDWSendTask( int proc )
 void
 DetailedTasks::internalDependenciesSatisfied( DetailedTask * dtask )
 {
+  if (m_ready_tasks_sharded) {
+    m_sharded_ready_tasks.push(dtask);
+    return;
+  }
+
   std::lock_guard<Uintah::MasterLock> internal_deps_satisfied_guard(g_internal_ready_mutex);
 
   m_ready_tasks.push(dtask);
-  m_atomic_initial_ready_tasks_size.fetch_add(1, std::memory_order_relaxed);
+  m_ready_tasks_size.fetch_add(1, std::memory_order_relaxed);
 }
 
 //_____________________________________________________________________________
@@ -941,15 +954,17 @@ DetailedTasks::internalDependenciesSatisfied( DetailedTask * dtask )
 DetailedTask*
 DetailedTasks::getNextInternalReadyTask()
 {
+  if (m_ready_tasks_sharded) {
+    return m_sharded_ready_tasks.pop();
+  }
+
   std::lock_guard<Uintah::MasterLock> internal_ready_guard(g_internal_ready_mutex);
 
   DetailedTask* nextTask = nullptr;
-  if (m_atomic_initial_ready_tasks_size.load(std::memory_order_acquire) > 0) {
-    if (!m_ready_tasks.empty()) {
-      nextTask = m_ready_tasks.front();
-      m_atomic_initial_ready_tasks_size.fetch_sub(1, std::memory_order_relaxed);
-      m_ready_tasks.pop();
-    }
+  if (!m_ready_tasks.empty()) {
+    nextTask = m_ready_tasks.front();
+    m_ready_tasks_size.fetch_sub(1, std::memory_order_relaxed);
+    m_ready_tasks.pop();
   }
 
   return nextTask;
@@ -960,7 +975,18 @@ DetailedTasks::getNextInternalReadyTask()
 int
 DetailedTasks::numInternalReadyTasks()
 {
-  return m_atomic_initial_ready_tasks_size.load(std::memory_order_seq_cst);
+  if (m_ready_tasks_sharded) {
+    return m_sharded_ready_tasks.size();
+  }
+  return m_ready_tasks_size.load(std::memory_order_seq_cst);
+}
+
+//_____________________________________________________________________________
+//
+void
+DetailedTasks::addExternalReadyTask( DetailedTask * dtask )
+{
+  m_mpi_completed_tasks.push(dtask);
 }
 
 //_____________________________________________________________________________
@@ -968,18 +994,7 @@ DetailedTasks::numInternalReadyTasks()
 DetailedTask*
 DetailedTasks::getNextExternalReadyTask()
 {
-  std::lock_guard<Uintah::MasterLock> external_ready_guard(g_external_ready_mutex);
-
-  DetailedTask* nextTask = nullptr;
-  if (m_atomic_mpi_completed_tasks_size.load(std::memory_order_acquire) > 0) {
-    if (!m_mpi_completed_tasks.empty()) {
-      nextTask = m_mpi_completed_tasks.top();
-      m_atomic_mpi_completed_tasks_size.fetch_sub(1, std::memory_order_relaxed);
-      m_mpi_completed_tasks.pop();
-    }
-  }
-
-  return nextTask;
+  return m_mpi_completed_tasks.pop();
 }
 
 //_____________________________________________________________________________
@@ -987,7 +1002,7 @@ DetailedTasks::getNextExternalReadyTask()
 int
 DetailedTasks::numExternalReadyTasks()
 {
-  return m_atomic_mpi_completed_tasks_size.load(std::memory_order_seq_cst);
+  return m_mpi_completed_tasks.size();
 }
 
 //_____________________________________________________________________________
@@ -995,8 +1010,12 @@ DetailedTasks::numExternalReadyTasks()
 void
 DetailedTasks::initTimestep()
 {
-  m_ready_tasks = m_initial_ready_tasks;
-  m_atomic_initial_ready_tasks_size.store(m_initial_ready_tasks.size(), std::memory_order_release);
+  m_sharded_ready_tasks.clear();
+  m_ready_tasks = TaskQueue();
+  m_ready_tasks_size.store(0, std::memory_order_relaxed);
+  for (auto dtask : m_initial_ready_tasks) {
+    internalDependenciesSatisfied(dtask);
+  }
   incrementDependencyGeneration();
   initializeBatches();
 }
@@ -1060,6 +1079,16 @@ DetailedTasks::emitEdges( ProblemSpecP edgesElement, int rank )
   }
 }
 
+//_____________________________________________________________________________
+//
+bool
+DetailedTaskStaticOrderComparison::operator()( DetailedTask *& ltask
+                                             , DetailedTask *& rtask
+                                             )
+{
+  return ltask->getStaticOrder() > rtask->getStaticOrder();
+}
+
 //_____________________________________________________________________________
 //
 // comparing the priority of two detailed tasks - true means give rtask priority
@@ -39,6 +39,7 @@
 #include <Core/Grid/Variables/ScrubItem.h>
 
 #include <Core/Lockfree/Lockfree_Pool.hpp>
+#include <Core/Parallel/ShardedPriorityQueue.hpp>
 
 
 #ifdef HAVE_CUDA
@@ -98,6 +99,17 @@ public:
 };
 
 
+//_____________________________________________________________________________
+//
+// gives priority to the task with the smaller static (task graph) order
+class DetailedTaskStaticOrderComparison {
+
+public:
+
+  bool operator()( DetailedTask *& ltask, DetailedTask *& rtask );
+};
+
+
 //_____________________________________________________________________________
 //
 class DetailedTasks {
@@ -304,6 +316,8 @@ protected:
 
   void internalDependenciesSatisfied( DetailedTask * dtask );
 
+  void addExternalReadyTask( DetailedTask * dtask );
+
   SchedulerCommon* getSchedulerCommon()
   {
     return m_sched_common;
@@ -366,15 +380,21 @@ private:
 
   QueueAlg m_task_priority_alg { QueueAlg::MostMessages };
 
-  using TaskQueue  = std::queue<DetailedTask*>;
-  using TaskPQueue = std::priority_queue<DetailedTask*, std::vector<DetailedTask*>, DetailedTaskPriorityComparison>;
-
-  TaskQueue  m_ready_tasks;
-  TaskQueue  m_initial_ready_tasks;
-  TaskPQueue m_mpi_completed_tasks;
-  std::atomic<int> m_atomic_initial_ready_tasks_size { 0 };
+  // with several task-executing threads both ready queues are sharded (relaxed)
+  // priority queues so that threads pushing and popping tasks do not serialize on
+  // a single lock; the internal-ready one is then ordered by static task order.
+  // A single thread keeps the internal-ready FIFO, and so its execution order.
+  using TaskQueue        = std::queue<DetailedTask*>;
+  using TaskShardedQueue = ShardedPriorityQueue<DetailedTask*, DetailedTaskStaticOrderComparison>;
+  using TaskPQueue       = ShardedPriorityQueue<DetailedTask*, DetailedTaskPriorityComparison>;
+
+  bool                        m_ready_tasks_sharded;
+  TaskQueue                   m_ready_tasks;
+  std::atomic<int>            m_ready_tasks_size{0};
+  TaskShardedQueue            m_sharded_ready_tasks;
+  std::vector<DetailedTask*>  m_initial_ready_tasks;
+  TaskPQueue                  m_mpi_completed_tasks;
   std::atomic<int> atomic_task_to_debug_size { 0 };
-  std::atomic<int> m_atomic_mpi_completed_tasks_size { 0 };
 
   // This "generation" number is to keep track of which InternalDependency
   // links have been satisfied in the current timestep and avoids the
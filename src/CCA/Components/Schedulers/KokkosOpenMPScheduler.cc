@@ -23,6 +23,7 @@
  */
 
 #include <CCA/Components/Schedulers/KokkosOpenMPScheduler.h>
+#include <CCA/Components/Schedulers/NUMAPlacement.h>
 #include <CCA/Components/Schedulers/OnDemandDataWarehouse.h>
 #include <CCA/Components/Schedulers/RuntimeStats.hpp>
 #include <CCA/Components/Schedulers/TaskGraph.h>
@@ -45,6 +46,7 @@
   #include <Kokkos_Core.hpp>
 #endif //KOKKOS_ENABLE_OPENMP
 
+#include <algorithm>
 #include <atomic>
 #include <cstring>
 #include <iomanip>
@@ -72,6 +74,9 @@ namespace {
 
   volatile int  g_num_tasks_done{0};
 
+  // WorkStealing: number of tasks a partition pulls from the shared external-ready queue at once
+  const int     g_ws_refill_batch_size{4};
+
   bool g_have_hypre_task{false};
   DetailedTask* g_HypreTask;
 
@@ -147,11 +152,22 @@ KokkosOpenMPScheduler::problemSetup( const ProblemSpecP     & prob_spec
     else if (taskQueueAlg == "PatchOrderRandom") {
       m_task_queue_alg = PatchOrderRandom;
     }
+    else if (taskQueueAlg == "WorkStealing") {
+      m_work_stealing  = true;
+      m_task_queue_alg = MostMessages;  // order in which partitions take batches from the shared queue
+    }
     else {
       throw ProblemSetupException("Unknown task ready queue algorithm", __FILE__, __LINE__);
     }
   }
 
+  if (m_work_stealing) {
+    m_partition_queues.clear();
+    for (int i = 0; i < std::max(1, m_num_partitions); ++i) {
+      m_partition_queues.emplace_back(scinew PartitionQueue());
+    }
+  }
+
   proc0cout << "Using \"" << taskQueueAlg << "\" task queue priority algorithm" << std::endl;
 
   if (d_myworld->myRank() == 0) {
@@ -245,6 +261,20 @@ KokkosOpenMPScheduler::execute( int tgnum       /* = 0 */
     m_phase_tasks[m_detailed_tasks->localTask(i)->getTask()->m_phase]++;
   }
 
+  // patch -> partition affinity for NUMA placement, only changes with the set of local patches
+  if (NUMAPlacement::isEnabled()) {
+    std::vector<int> patch_ids;
+    for (int i = 0; i < m_num_tasks; i++) {
+      const PatchSubset* patches = m_detailed_tasks->localTask(i)->getPatches();
+      if (patches != nullptr) {
+        for (int p = 0; p < patches->size(); p++) {
+          patch_ids.push_back(patches->get(p)->getRealPatch()->getID());
+        }
+      }
+    }
+    NUMAPlacement::assignPatches(patch_ids);
+  }
+
   if (g_dbg) {
     std::ostringstream message;
     message << "\n" << "Rank-" << my_rank << " Executing " << m_detailed_tasks->numTasks() << " tasks (" << m_num_tasks
@@ -270,7 +300,16 @@ KokkosOpenMPScheduler::execute( int tgnum       /* = 0 */
       // A task_worker can run either a serial task, e.g. threads_per_partition == 1
       //       or a Kokkos-based data parallel task, e.g. threads_per_partition > 1
 
-      this->runTasks();
+      if ( NUMAPlacement::isEnabled() ) {
+        NUMAPlacement::setPartitionNode( partition_id, NUMAPlacement::getCurrentNode() );
+      }
+
+      if ( m_work_stealing ) {
+        this->runTasksWorkStealing( partition_id );
+      }
+      else {
+        this->runTasks();
+      }
 
     }; //end task_worker
 
@@ -281,7 +320,12 @@ KokkosOpenMPScheduler::execute( int tgnum       /* = 0 */
 
 #else //KOKKOS_ENABLE_OPENMP
 
-    this->runTasks();
+    if ( m_work_stealing ) {
+      this->runTasksWorkStealing( 0 );
+    }
+    else {
+      this->runTasks();
+    }
 
 #endif // UINTAH_ENABLE_KOKKOS
 
@@ -316,6 +360,12 @@ KokkosOpenMPScheduler::execute( int tgnum       /* = 0 */
   ASSERT(m_sends.size() == 0u);
   ASSERT(m_recvs.size() == 0u);
 
+#if SCI_ASSERTION_LEVEL >= 1
+  for (auto & queue : m_partition_queues) {
+    ASSERT(queue->m_tasks.empty());
+  }
+#endif
+
 
   if (g_queuelength) {
     float lengthsum = 0;
@@ -535,6 +585,222 @@ KokkosOpenMPScheduler::runTasks()
 }
 
 
+//______________________________________________________________________
+//
+DetailedTask*
+KokkosOpenMPScheduler::popLocalTask( int partition_id )
+{
+  PartitionQueue & queue = *m_partition_queues[partition_id];
+
+  std::lock_guard<Uintah::MasterLock> queue_guard(queue.m_lock);
+
+  DetailedTask* dtask = nullptr;
+  if (!queue.m_tasks.empty()) {
+    dtask = queue.m_tasks.front();
+    queue.m_tasks.pop_front();
+  }
+  return dtask;
+}
+
+
+//______________________________________________________________________
+//  With NUMA placement, single-patch tasks go to the queue of the partition
+//  their patch is placed for; everything else stays with the caller.
+int
+KokkosOpenMPScheduler::affinityPartition( DetailedTask * dtask
+                                        , int            partition_id
+                                        ) const
+{
+  if (NUMAPlacement::isEnabled()) {
+    const PatchSubset* patches = dtask->getPatches();
+    if (patches != nullptr && patches->size() == 1) {
+      const int partition = NUMAPlacement::getPartition(patches->get(0));
+      if (partition >= 0 && partition < static_cast<int>(m_partition_queues.size())) {
+        return partition;
+      }
+    }
+  }
+  return partition_id;
+}
+
+
+//______________________________________________________________________
+//  Take up to g_ws_refill_batch_size tasks (in priority order) from the shared
+//  external-ready queue. The first is returned to run, the rest go to the back
+//  of this partition's queue.
+DetailedTask*
+KokkosOpenMPScheduler::refillLocalTasks( int partition_id )
+{
+  if (m_detailed_tasks->numExternalReadyTasks() == 0) {
+    return nullptr;
+  }
+
+  DetailedTask* first = m_detailed_tasks->getNextExternalReadyTask();
+  if (first == nullptr) {
+    return nullptr;
+  }
+
+  for (int i = 1; i < g_ws_refill_batch_size; ++i) {
+    DetailedTask* dtask = m_detailed_tasks->getNextExternalReadyTask();
+    if (dtask == nullptr) {
+      break;
+    }
+    PartitionQueue & queue = *m_partition_queues[affinityPartition(dtask, partition_id)];
+    std::lock_guard<Uintah::MasterLock> queue_guard(queue.m_lock);
+    queue.m_tasks.push_back(dtask);
+  }
+
+  return first;
+}
+
+
+//______________________________________________________________________
+//  Steal the back half of the first non-empty peer queue. Owners pop from the
+//  front, so the highest priority tasks of a batch stay with their owner.
+bool
+KokkosOpenMPScheduler::stealTasks( int partition_id )
+{
+  const int num_queues = static_cast<int>(m_partition_queues.size());
+
+  std::deque<DetailedTask*> stolen;
+
+  for (int i = 1; i < num_queues && stolen.empty(); ++i) {
+    PartitionQueue & victim = *m_partition_queues[(partition_id + i) % num_queues];
+
+    std::lock_guard<Uintah::MasterLock> victim_guard(victim.m_lock);
+
+    size_t num_steal = (victim.m_tasks.size() + 1) / 2;
+    for (size_t n = 0; n < num_steal; ++n) {
+      stolen.push_front(victim.m_tasks.back());
+      victim.m_tasks.pop_back();
+    }
+  }
+
+  if (stolen.empty()) {
+    return false;
+  }
+
+  PartitionQueue & queue = *m_partition_queues[partition_id];
+  std::lock_guard<Uintah::MasterLock> queue_guard(queue.m_lock);
+  queue.m_tasks.insert(queue.m_tasks.end(), stolen.begin(), stolen.end());
+
+  return true;
+}
+
+
+//______________________________________________________________________
+//
+void
+KokkosOpenMPScheduler::runTasksWorkStealing( int partition_id )
+{
+  // partition 0 is the only one that progresses MPI receives and runs phase sync tasks
+  const bool is_mpi_partition = (partition_id == 0);
+
+  while( g_num_tasks_done < m_num_tasks && !g_have_hypre_task ) {
+
+    DetailedTask* readyTask = nullptr;
+
+    /*
+     * (1)
+     *
+     * MPI progress and phase-synchronizing (reduction) tasks, designated partition only.
+     *
+     */
+    if ( is_mpi_partition ) {
+      if (m_recvs.size() != 0u) {
+        MPIScheduler::processMPIRecvs(TEST);
+      }
+
+      {
+        std::lock_guard<Uintah::MasterLock> task_consumed_guard(g_mark_task_consumed_mutex);
+        if ((m_phase_sync_task[m_curr_phase] != nullptr) && (m_phase_tasks_done[m_curr_phase] == m_phase_tasks[m_curr_phase] - 1)) {
+          readyTask = m_phase_sync_task[m_curr_phase];
+        }
+      }
+
+      if (readyTask != nullptr) {
+        markTaskConsumed(&g_num_tasks_done, m_curr_phase, m_num_phases, readyTask);
+        runReadyTask(readyTask);
+        continue;
+      }
+    }
+
+    /*
+     * (2)
+     *
+     * Run an externally-ready task from the local queue, refilling it from the shared queue when empty.
+     *
+     */
+    readyTask = popLocalTask(partition_id);
+    if (readyTask == nullptr) {
+      readyTask = refillLocalTasks(partition_id);
+    }
+
+    if (readyTask != nullptr) {
+      if ( readyTask->getTask()->getType() == Task::Hypre ) {
+        std::lock_guard<Uintah::MasterLock> task_consumed_guard(g_mark_task_consumed_mutex);
+        if ( g_have_hypre_task ) {
+          // another partition got there first, keep this one for the next pass
+          std::lock_guard<Uintah::MasterLock> queue_guard(m_partition_queues[partition_id]->m_lock);
+          m_partition_queues[partition_id]->m_tasks.push_front(readyTask);
+          return;
+        }
+        g_HypreTask       = readyTask;
+        g_have_hypre_task = true;
+      }
+
+      markTaskConsumed(&g_num_tasks_done, m_curr_phase, m_num_phases, readyTask);
+
+      if ( readyTask->getTask()->getType() == Task::Hypre ) {
+        return;
+      }
+
+      DOUT(g_task_dbg, myRankThread() << " Task external ready " << *readyTask);
+      runReadyTask(readyTask);
+      continue;
+    }
+
+    /*
+     * (3)
+     *
+     * Initiate MPI receives for an internally-ready task, see runTasks() (1.3).
+     *
+     */
+    if (m_detailed_tasks->numInternalReadyTasks() > 0) {
+      DetailedTask* initTask = m_detailed_tasks->getNextInternalReadyTask();
+      if (initTask != nullptr) {
+        if (initTask->getTask()->getType() == Task::Reduction || initTask->getTask()->usesMPI()) {
+          DOUT(g_task_dbg, myRankThread() <<  " Task internal ready 1 " << *initTask);
+          ASSERT(initTask->getRequires().size() == 0)
+          std::lock_guard<Uintah::MasterLock> task_consumed_guard(g_mark_task_consumed_mutex);
+          m_phase_sync_task[initTask->getTask()->m_phase] = initTask;
+        }
+        else if (initTask->getRequires().size() == 0) {  // no ext. dependencies, then skip MPI sends
+          initTask->markInitiated();
+          initTask->checkExternalDepCount();
+        }
+        else {
+          MPIScheduler::initiateTask(initTask, m_abort, m_abort_point, m_curr_iteration.load(std::memory_order_relaxed));
+          DOUT(g_task_dbg, myRankThread() << " Task internal ready 2 " << *initTask << " deps needed: " << initTask->getExternalDepCount());
+          initTask->markInitiated();
+          initTask->checkExternalDepCount();
+        }
+        continue;
+      }
+    }
+
+    /*
+     * (4)
+     *
+     * Nothing local or shared to do, try to steal from a peer partition.
+     *
+     */
+    stealTasks(partition_id);
+
+  }  // end while (numTasksDone < ntasks)
+}
+
+
 //______________________________________________________________________
 //  generate string   <MPI_rank>.<Thread_ID>
 std::string
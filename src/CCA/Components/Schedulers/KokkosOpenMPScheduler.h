@@ -27,7 +27,11 @@
 
 #include <CCA/Components/Schedulers/MPIScheduler.h>
 
+#include <Core/Parallel/MasterLock.h>
+
 #include <atomic>
+#include <deque>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -63,6 +67,13 @@ DESCRIPTION
    This scheduler is designed primarily for use on the many-core Intel Xeon Phi
    architecture, specifically KNL and KNH, but should also work well on any
    multi-core CPU node with hyper-threading
+
+   With <taskReadyQueueAlg>WorkStealing</taskReadyQueueAlg>, task selection no
+   longer goes through the single scheduler lock. Each partition owns a local
+   deque of externally-ready tasks that it refills in small batches from the
+   shared ready queue, and steals from its peers when both are empty. MPI
+   progress and phase-synchronizing (reduction) tasks are handled only by
+   partition 0.
   
 WARNING
    This scheduler is EXPERIMENTAL and undergoing extensive development.
@@ -92,6 +103,8 @@ class KokkosOpenMPScheduler : public MPIScheduler  {
 
     void runTasks();
 
+    void runTasksWorkStealing( int partition_id );
+
     static std::string myRankThread();
 
 
@@ -106,6 +119,18 @@ class KokkosOpenMPScheduler : public MPIScheduler  {
     void markTaskConsumed( volatile int * numTasksDone, int & currphase, int numPhases, DetailedTask * dtask );
     void runReadyTask( DetailedTask* readyTask );
 
+    // work-stealing helpers, see runTasksWorkStealing()
+    DetailedTask* popLocalTask( int partition_id );
+    DetailedTask* refillLocalTasks( int partition_id );
+    bool          stealTasks( int partition_id );
+    int           affinityPartition( DetailedTask * dtask, int partition_id ) const;
+
+    // per-partition ready queue, each protected by its own lock
+    struct PartitionQueue {
+      Uintah::MasterLock          m_lock{};
+      std::deque<DetailedTask*>   m_tasks{};
+    };
+
     // thread shared data, needs lock protection when accessed
     std::vector<int>             m_phase_tasks;
     std::vector<int>             m_phase_tasks_done;
@@ -115,6 +140,9 @@ class KokkosOpenMPScheduler : public MPIScheduler  {
 
     QueueAlg m_task_queue_alg{MostMessages};
 
+    bool     m_work_stealing{false};
+    std::vector<std::unique_ptr<PartitionQueue>> m_partition_queues;
+
     std::atomic<int>  m_curr_iteration{0};
 
     int               m_num_tasks{0};
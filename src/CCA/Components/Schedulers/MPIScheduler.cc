@@ -24,6 +24,7 @@
 
 #include <CCA/Components/Schedulers/MPIScheduler.h>
 
+#include <CCA/Components/Schedulers/DependencyBatch.h>
 #include <CCA/Components/Schedulers/DetailedTasks.h>
 #include <CCA/Components/Schedulers/OnDemandDataWarehouse.h>
 #include <CCA/Components/Schedulers/RuntimeStats.hpp>
@@ -57,14 +58,16 @@
 #include <map>
 #include <sstream>
 
-// Pack data into a buffer before sending -- testing to see if this
-// works better and avoids certain problems possible when you allow
-// tasks to modify data that may have a pending send.
+// Packing data into a buffer before sending (PackBufferInfo) vs. sending straight from the
+// variables with MPI derived datatypes (BufferInfo) is selected at runtime with
+// <packed_messages> in the Scheduler block (default: packing), see usePacking().
 //
 // Note, we have found considerable memory savings and appreciable performance gains
-// by commenting USE_PACKING out... however, on some machines this will cause a crash,
+// by not packing... however, on some machines this will cause a crash,
 // but on Titan production runs it had no problems. Alan H./Brad P.,  05/10/2017
-#define USE_PACKING
+//
+// Persistent communication plans (<persistent_comm_plans> in the Scheduler block) rely on
+// the packed buffers, so they require packing.
 
 
 using namespace Uintah;
@@ -366,11 +369,9 @@ MPIScheduler::postMPISends( DetailedTask * dtask
   for (DependencyBatch* batch = dtask->getComputes(); batch != nullptr; batch = batch->m_comp_next) {
 
     // Prepare to send a message
-#ifdef USE_PACKING
-    PackBufferInfo mpibuff;
-#else
-    BufferInfo mpibuff;
-#endif
+    PackBufferInfo   pack_buff;
+    BufferInfo       type_buff;
+    BufferInfo     & mpibuff = usePacking() ? pack_buff : type_buff;
 
     // Create the MPI type
     int to = batch->m_to_tasks.front()->getAssignedResourceIndex();
@@ -450,12 +451,16 @@ MPIScheduler::postMPISends( DetailedTask * dtask
       int count;
       MPI_Datatype datatype;
 
-#ifdef USE_PACKING
-      mpibuff.get_type(buf, count, datatype, my_comm);
-      mpibuff.pack(my_comm, count);
-#else
-      mpibuff.get_type(buf, count, datatype);
-#endif
+      if (usePacking()) {
+        if (usePersistentComm()) {
+          setupPersistentRequest(batch, pack_buff, to, true, my_comm);
+        }
+        pack_buff.get_type(buf, count, datatype, my_comm);
+        pack_buff.pack(my_comm, count);
+      }
+      else {
+        type_buff.get_type(buf, count, datatype);
+      }
       if (!buf) {
         printf("postMPISends() - ERROR, the send MPI buffer is nullptr\n");
         SCI_THROW( InternalError("The send MPI buffer is null", __FILE__, __LINE__) );
@@ -477,7 +482,13 @@ MPIScheduler::postMPISends( DetailedTask * dtask
       // New way of managing single MPI requests - avoids MPI_Waitsome & MPI_Donesome - APH 07/20/16
       //---------------------------------------------------------------------------
       CommRequestPool::iterator comm_sends_iter = m_sends.emplace(new SendHandle(mpibuff.takeSendlist()));
-      Uintah::MPI::Isend(buf, count, datatype, to, batch->m_message_tag, my_comm, comm_sends_iter->request());
+      if (usePersistentComm()) {
+        *comm_sends_iter->request() = batch->m_persistent_request;
+        Uintah::MPI::Start(comm_sends_iter->request());
+      }
+      else {
+        Uintah::MPI::Isend(buf, count, datatype, to, batch->m_message_tag, my_comm, comm_sends_iter->request());
+      }
       comm_sends_iter.clear();
       //---------------------------------------------------------------------------
 
@@ -567,13 +578,13 @@ void MPIScheduler::postMPIRecvs( DetailedTask * dtask
       // Prepare to receive a message
       BatchReceiveHandler* pBatchRecvHandler = scinew BatchReceiveHandler(batch);
       PackBufferInfo* p_mpibuff = nullptr;
+      BufferInfo      type_buff;
 
-#ifdef USE_PACKING
-      p_mpibuff = scinew PackBufferInfo();
-      PackBufferInfo& mpibuff = *p_mpibuff;
-#else
-        BufferInfo mpibuff;
-#endif
+      // the packed buffer is unpacked and deleted by the RecvHandle once the receive completes
+      if (usePacking()) {
+        p_mpibuff = scinew PackBufferInfo();
+      }
+      BufferInfo& mpibuff = usePacking() ? *p_mpibuff : type_buff;
 
       // Create the MPI type
       for (DetailedDep* req = batch->m_head; req != nullptr; req = req->m_next) {
@@ -651,19 +662,23 @@ void MPIScheduler::postMPIRecvs( DetailedTask * dtask
         int count;
         MPI_Datatype datatype;
 
-#ifdef USE_PACKING
-        mpibuff.get_type(buf, count, datatype, my_comm);
-#else
-        mpibuff.get_type(buf, count, datatype);
-#endif
+        int from = batch->m_from_task->getAssignedResourceIndex();
+        ASSERTRANGE(from, 0, d_myworld->nRanks());
+
+        if (usePacking()) {
+          if (usePersistentComm()) {
+            setupPersistentRequest(batch, *p_mpibuff, from, false, my_comm);
+          }
+          p_mpibuff->get_type(buf, count, datatype, my_comm);
+        }
+        else {
+          type_buff.get_type(buf, count, datatype);
+        }
         if (!buf) {
           printf("postMPIRecvs() - ERROR, the receive MPI buffer is nullptr\n");
           SCI_THROW( InternalError("The receive MPI buffer is nullptr", __FILE__, __LINE__) );
         }
 
-        int from = batch->m_from_task->getAssignedResourceIndex();
-        ASSERTRANGE(from, 0, d_myworld->nRanks());
-
         DOUTR(g_mpi_dbg, " Posting recv for message number "
                           << batch->m_message_tag << " from rank-" << from
                           << ", length: " << count << " (bytes)");
@@ -672,7 +687,13 @@ void MPIScheduler::postMPIRecvs( DetailedTask * dtask
         // New way of managing single MPI requests - avoids MPI_Waitsome & MPI_Donesome - APH 07/20/16
         //---------------------------------------------------------------------------
         CommRequestPool::iterator comm_recvs_iter = m_recvs.emplace(new RecvHandle(p_mpibuff, pBatchRecvHandler));
-        Uintah::MPI::Irecv(buf, count, datatype, from, batch->m_message_tag, my_comm, comm_recvs_iter->request());
+        if (usePersistentComm()) {
+          *comm_recvs_iter->request() = batch->m_persistent_request;
+          Uintah::MPI::Start(comm_recvs_iter->request());
+        }
+        else {
+          Uintah::MPI::Irecv(buf, count, datatype, from, batch->m_message_tag, my_comm, comm_recvs_iter->request());
+        }
         comm_recvs_iter.clear();
         //---------------------------------------------------------------------------
 
@@ -681,11 +702,9 @@ void MPIScheduler::postMPIRecvs( DetailedTask * dtask
         // Nothing really needs to be received, but let everyone else know that it has what is needed (nothing).
         batch->received(d_myworld);
 
-#ifdef USE_PACKING
         // otherwise, these will be deleted after it receives and unpacks the data.
         delete p_mpibuff;
         delete pBatchRecvHandler;
-#endif
 
       }
     }  // end for loop over requires
@@ -702,6 +721,43 @@ void MPIScheduler::postMPIRecvs( DetailedTask * dtask
 
 }  // end postMPIRecvs()
 
+//______________________________________________________________________
+//
+//  The persistent request of a batch is created once, bound to a packed buffer owned by the batch,
+//  and started each time the batch is communicated. It only has to be rebuilt when the packed size
+//  changes, e.g. particle counts or conditional (first iteration, output timestep) dependencies.
+//  Batches, and with them their requests, are recreated whenever the task graph is recompiled.
+void
+MPIScheduler::setupPersistentRequest( DependencyBatch * batch
+                                    , PackBufferInfo  & mpibuff
+                                    , int               peer
+                                    , bool              is_send
+                                    , MPI_Comm          comm
+                                    )
+{
+  int packed_size = mpibuff.packedSize(comm);
+
+  if (batch->m_persistent_buffer == nullptr || batch->m_persistent_buffer->getBufSize() != packed_size) {
+    batch->freePersistentRequest();
+
+    batch->m_persistent_buffer = scinew PackedBuffer(packed_size);
+    batch->m_persistent_buffer->addReference();
+
+    void* buf = batch->m_persistent_buffer->getBuffer();
+    if (is_send) {
+      Uintah::MPI::Send_init(buf, packed_size, MPI_PACKED, peer, batch->m_message_tag, comm, &batch->m_persistent_request);
+    }
+    else {
+      Uintah::MPI::Recv_init(buf, packed_size, MPI_PACKED, peer, batch->m_message_tag, comm, &batch->m_persistent_request);
+    }
+
+    DOUTR(g_mpi_dbg, " Created persistent " << (is_send ? "send" : "recv") << " for message number "
+                     << batch->m_message_tag << " with rank-" << peer << ", length: " << packed_size << " (bytes)");
+  }
+
+  mpibuff.usePackedBuffer(batch->m_persistent_buffer);
+}
+
 //______________________________________________________________________
 //
 void MPIScheduler::processMPIRecvs( int test_type )
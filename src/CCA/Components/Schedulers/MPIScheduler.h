@@ -130,6 +130,14 @@ class MPIScheduler : public SchedulerCommon {
 
     void outputTimingStats( const char* label );
 
+    // bind mpibuff to the persistent request/buffer of the batch, (re)building them if the packed size changed
+    void setupPersistentRequest( DependencyBatch * batch
+                               , PackBufferInfo  & mpibuff
+                               , int               peer
+                               , bool              is_send
+                               , MPI_Comm          comm
+                               );
+
     CommRequestPool             m_sends{};
     CommRequestPool             m_recvs{};
 
@@ -0,0 +1,334 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <CCA/Components/Schedulers/NUMAPlacement.h>
+
+#include <Core/Grid/Patch.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+#if defined(__linux__)
+  #include <sched.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+using namespace Uintah;
+
+namespace {
+
+bool g_enabled{false};
+std::atomic<bool> g_can_bind{true};   // cleared if the kernel refuses mbind, by any thread placing a variable
+
+int g_num_nodes{1};
+int g_num_partitions{1};
+
+std::vector<int> g_cpu_node;   // cpu id -> NUMA node
+
+// node each partition runs on, -1 until the partition reports it
+std::unique_ptr<std::atomic<int>[]> g_partition_node{nullptr};
+
+// sorted local patch ids of the current assignment, and patch id -> partition
+std::vector<int>             g_patch_ids;
+std::unordered_map<int, int> g_patch_partition;
+
+std::atomic<int64_t> g_local_count{0};
+std::atomic<int64_t> g_remote_count{0};
+
+// smaller variables share pages with their neighbors, leave them where they are
+constexpr size_t s_min_place_bytes = 64 * 1024;
+
+// from <numaif.h>, without linking libnuma
+constexpr int s_mpol_preferred = 1;
+constexpr int s_mpol_mf_move   = 1 << 1;
+
+//______________________________________________________________________
+//
+// parses a sysfs cpu list, e.g. "0-15,32-47"
+std::vector<int>
+parseCPUList( const std::string & list )
+{
+  std::vector<int> cpus;
+  std::stringstream ss(list);
+  std::string range;
+  while (std::getline(ss, range, ',')) {
+    if (range.empty() || range == "\n") {
+      continue;
+    }
+    const size_t dash = range.find('-');
+    const int first = std::stoi(range.substr(0, dash));
+    const int last  = (dash == std::string::npos) ? first : std::stoi(range.substr(dash + 1));
+    for (int cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+//______________________________________________________________________
+//
+void
+readTopology()
+{
+  g_num_nodes = 1;
+  g_cpu_node.clear();
+
+#if defined(__linux__)
+  for (int node = 0; node < 1024; ++node) {
+    std::ifstream in("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    if (!in) {
+      continue;
+    }
+    std::string list;
+    std::getline(in, list);
+    for (int cpu : parseCPUList(list)) {
+      if (cpu >= static_cast<int>(g_cpu_node.size())) {
+        g_cpu_node.resize(cpu + 1, 0);
+      }
+      g_cpu_node[cpu] = node;
+    }
+    g_num_nodes = std::max(g_num_nodes, node + 1);
+  }
+#endif
+}
+
+} // namespace
+
+
+//______________________________________________________________________
+//
+void
+NUMAPlacement::initialize( int num_partitions )
+{
+  readTopology();
+
+  g_num_partitions = std::max(1, num_partitions);
+  g_partition_node.reset(new std::atomic<int>[g_num_partitions]);
+  for (int i = 0; i < g_num_partitions; ++i) {
+    g_partition_node[i].store(-1);
+  }
+
+  g_patch_ids.clear();
+  g_patch_partition.clear();
+  resetCounts();
+
+#if defined(__linux__)
+  g_enabled = (g_num_nodes > 1 && g_num_partitions > 1);
+#else
+  g_enabled = false;
+#endif
+}
+
+//______________________________________________________________________
+//
+bool
+NUMAPlacement::isEnabled()
+{
+  return g_enabled;
+}
+
+//______________________________________________________________________
+//
+int
+NUMAPlacement::getNumNodes()
+{
+  return g_num_nodes;
+}
+
+//______________________________________________________________________
+//
+void
+NUMAPlacement::assignPatches( std::vector<int> patch_ids )
+{
+  std::sort(patch_ids.begin(), patch_ids.end());
+  patch_ids.erase(std::unique(patch_ids.begin(), patch_ids.end()), patch_ids.end());
+
+  if (patch_ids == g_patch_ids) {
+    return;  // same local patches, keep the affinity
+  }
+
+  g_patch_ids = std::move(patch_ids);
+  g_patch_partition.clear();
+
+  const size_t num_patches = g_patch_ids.size();
+  for (size_t i = 0; i < num_patches; ++i) {
+    g_patch_partition[g_patch_ids[i]] = static_cast<int>((i * g_num_partitions) / num_patches);
+  }
+}
+
+//______________________________________________________________________
+//
+int
+NUMAPlacement::getPartition( const Patch * patch )
+{
+  if (patch == nullptr) {
+    return -1;
+  }
+  auto iter = g_patch_partition.find(patch->getRealPatch()->getID());
+  return (iter != g_patch_partition.end()) ? iter->second : -1;
+}
+
+//______________________________________________________________________
+//
+int
+NUMAPlacement::getNode( const Patch * patch )
+{
+  const int partition = getPartition(patch);
+  if (partition < 0) {
+    return -1;
+  }
+
+  const int node = g_partition_node[partition].load(std::memory_order_relaxed);
+
+  // partitions are laid out in order over the hardware threads until they report otherwise
+  return (node >= 0) ? node : (partition * g_num_nodes) / g_num_partitions;
+}
+
+//______________________________________________________________________
+//
+void
+NUMAPlacement::setPartitionNode( int partition, int node )
+{
+  if (g_partition_node && partition >= 0 && partition < g_num_partitions) {
+    g_partition_node[partition].store(node, std::memory_order_relaxed);
+  }
+}
+
+//______________________________________________________________________
+//
+int
+NUMAPlacement::getCurrentNode()
+{
+#if defined(__linux__)
+  const int cpu = sched_getcpu();
+  if (cpu >= 0 && cpu < static_cast<int>(g_cpu_node.size())) {
+    return g_cpu_node[cpu];
+  }
+#endif
+  return 0;
+}
+
+//______________________________________________________________________
+//
+void
+NUMAPlacement::place( const Patch * patch
+                    ,       void  * ptr
+                    ,       size_t  bytes
+                    )
+{
+  if (!g_enabled || !g_can_bind.load(std::memory_order_relaxed) || ptr == nullptr || bytes < s_min_place_bytes) {
+    return;
+  }
+
+  const int node = getNode(patch);
+  if (node < 0) {
+    return;
+  }
+
+#if defined(__linux__)
+  // only whole pages inside the variable
+  const uintptr_t page  = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  const uintptr_t begin = (reinterpret_cast<uintptr_t>(ptr) + page - 1) & ~(page - 1);
+  const uintptr_t end   = (reinterpret_cast<uintptr_t>(ptr) + bytes) & ~(page - 1);
+  if (end <= begin) {
+    return;
+  }
+
+  unsigned long nodemask[1024 / (8 * sizeof(unsigned long))] = {};
+  nodemask[node / (8 * sizeof(unsigned long))] = 1UL << (node % (8 * sizeof(unsigned long)));
+
+  // pages not touched yet are placed on first touch, resident ones (recycled buffers) are moved
+  const long status = syscall(SYS_mbind, reinterpret_cast<void*>(begin), end - begin, s_mpol_preferred,
+                              nodemask, 8 * sizeof(nodemask) + 1, s_mpol_mf_move);
+  if (status != 0) {
+    g_can_bind.store(false, std::memory_order_relaxed);
+  }
+#endif
+}
+
+//______________________________________________________________________
+//
+void
+NUMAPlacement::countAccess( const Patch * patch )
+{
+  const int node = getNode(patch);
+  if (node < 0) {
+    return;
+  }
+
+  if (node == getCurrentNode()) {
+    g_local_count.fetch_add(1, std::memory_order_relaxed);
+  }
+  else {
+    g_remote_count.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+//______________________________________________________________________
+//
+int64_t
+NUMAPlacement::getLocalCount()
+{
+  return g_local_count.load(std::memory_order_relaxed);
+}
+
+//______________________________________________________________________
+//
+int64_t
+NUMAPlacement::getRemoteCount()
+{
+  return g_remote_count.load(std::memory_order_relaxed);
+}
+
+//______________________________________________________________________
+//
+void
+NUMAPlacement::resetLocalCount()
+{
+  g_local_count.store(0);
+}
+
+//______________________________________________________________________
+//
+void
+NUMAPlacement::resetRemoteCount()
+{
+  g_remote_count.store(0);
+}
+
+//______________________________________________________________________
+//
+void
+NUMAPlacement::resetCounts()
+{
+  resetLocalCount();
+  resetRemoteCount();
+}
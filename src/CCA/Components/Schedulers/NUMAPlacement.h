@@ -0,0 +1,109 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#ifndef CCA_COMPONENTS_SCHEDULERS_NUMAPLACEMENT_H
+#define CCA_COMPONENTS_SCHEDULERS_NUMAPLACEMENT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Uintah {
+
+class Patch;
+
+/**************************************
+
+CLASS
+   NUMAPlacement
+
+DESCRIPTION
+   Keeps each patch's variables on the NUMA node of the scheduler partition
+   that runs the patch's tasks.
+
+   Patches are assigned to partitions in contiguous blocks of the sorted local
+   patch ids, and an assignment only changes when the set of local patches does,
+   so the affinity is stable across timesteps.  The DW binds the storage of
+   grid and particle variables it allocates to the node of the patch's
+   partition (mbind, moving pages that are already resident).  Each partition
+   records the node it actually runs on, so the mapping follows however the
+   OpenMP runtime placed the partitions.
+
+   Task executions are counted as local or remote (the thread running the task
+   is on another node than the task's patch), reported through RuntimeStats.
+
+   Only active on Linux with more than one NUMA node and more than one partition.
+
+****************************************/
+
+class NUMAPlacement {
+
+public:
+
+  // discovers the node topology, enables placement if it can help
+  static void initialize( int num_partitions );
+
+  static bool isEnabled();
+
+  static int  getNumNodes();
+
+  // must be called while no tasks run
+  static void assignPatches( std::vector<int> patch_ids );
+
+  // -1 if the patch is not local
+  static int  getPartition( const Patch * patch );
+
+  // node of the patch's partition, -1 if the patch is not local
+  static int  getNode( const Patch * patch );
+
+  static void setPartitionNode( int partition, int node );
+
+  // node of the calling thread's CPU
+  static int  getCurrentNode();
+
+  // binds [ptr, ptr + bytes) to the node of the patch
+  static void place( const Patch * patch, void * ptr, size_t bytes );
+
+  // counts a task execution on the patch by the calling thread, as local if the
+  // thread runs on the patch's node and remote otherwise (not memory accesses)
+  static void countAccess( const Patch * patch );
+
+  static int64_t getLocalCount();
+  static int64_t getRemoteCount();
+  static void    resetLocalCount();
+  static void    resetRemoteCount();
+  static void    resetCounts();
+
+private:
+
+  NUMAPlacement()                                  = delete;
+  NUMAPlacement( const NUMAPlacement & )            = delete;
+  NUMAPlacement& operator=( const NUMAPlacement & ) = delete;
+
+};
+
+} // namespace Uintah
+
+#endif // CCA_COMPONENTS_SCHEDULERS_NUMAPLACEMENT_H
@@ -27,6 +27,7 @@
 #include <CCA/Components/Schedulers/DetailedTasks.h>
 #include <CCA/Components/Schedulers/DependencyException.h>
 #include <CCA/Components/Schedulers/MPIScheduler.h>
+#include <CCA/Components/Schedulers/NUMAPlacement.h>
 #include <CCA/Components/Schedulers/RuntimeStats.hpp>
 #include <CCA/Components/Schedulers/SchedulerCommon.h>
 #include <CCA/Ports/LoadBalancer.h>
@@ -76,6 +77,7 @@
 #include <limits>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace Uintah;
@@ -97,16 +99,12 @@ namespace {
   // Tags for each CrowdMonitor
   struct varDB_tag{};
   struct levelDB_tag{};
-  struct psetDB_tag{};
   struct addsetDB_tag{};
-  struct delsetDB_tag{};
   struct task_access_tag{};
 
   using  varDB_monitor         = Uintah::CrowdMonitor<varDB_tag>;
   using  levelDB_monitor       = Uintah::CrowdMonitor<levelDB_tag>;
-  using  psetDB_monitor        = Uintah::CrowdMonitor<psetDB_tag>;
   using  addsetDB_monitor      = Uintah::CrowdMonitor<addsetDB_tag>;
-  using  delsetDB_monitor      = Uintah::CrowdMonitor<delsetDB_tag>;
   using  task_access_monitor   = Uintah::CrowdMonitor<task_access_tag>;
 
   Dout  g_foreign_dbg(    "ForeignVariables"   , "OnDemandDataWarehouse", "report when foreign variable is added to DW" , false );
@@ -115,8 +113,6 @@ namespace {
   Dout  g_check_accesses( "DWCheckTaskAccess"  , "OnDemandDataWarehouse", "report on task DW access checking (DBG-only)", false );
   Dout  g_warnings_dbg(   "DWWarnings"         , "OnDemandDataWarehouse", "report DW GridVar progressive warnings"      , false );
 
-  Uintah::MasterLock g_running_tasks_lock{};
-
 }
 
 // we want a particle message to have a unique tag per patch/matl/batch/dest.
@@ -128,6 +124,8 @@ namespace {
 #define PARTICLESET_TAG 0x4000|batch->messageTag
 
 bool OnDemandDataWarehouse::s_combine_memory = false;
+bool OnDemandDataWarehouse::s_use_ghost_cache = false;
+bool OnDemandDataWarehouse::s_halo_padded_allocation = false;
 
 
 //______________________________________________________________________
@@ -185,20 +183,28 @@ void
 OnDemandDataWarehouse::clear()
 {
   {
-    psetDB_monitor psetDB_lock{ Uintah::CrowdMonitor<psetDB_tag>::WRITER };
-
-    for (psetDBType::const_iterator iter = m_pset_db.begin(); iter != m_pset_db.end(); ++iter) {
-      if (iter->second->removeReference()) {
-        delete iter->second;
+    for (auto & shard : m_pset_db) {
+      std::lock_guard<Uintah::MasterLock> pset_shard_lock(shard.m_lock);
+      for (psetDBType::const_iterator iter = shard.m_psets.begin(); iter != shard.m_psets.end(); ++iter) {
+        if (iter->second->removeReference()) {
+          delete iter->second;
+        }
       }
+      shard.m_psets.clear();
     }
 
-    for (psetDBType::const_iterator iter = m_delset_DB.begin(); iter != m_delset_DB.end(); ++iter) {
-      if (iter->second->removeReference()) {
-        delete iter->second;
+    for (auto & shard : m_delset_DB) {
+      std::lock_guard<Uintah::MasterLock> delset_shard_lock(shard.m_lock);
+      for (psetDBType::const_iterator iter = shard.m_psets.begin(); iter != shard.m_psets.end(); ++iter) {
+        if (iter->second->removeReference()) {
+          delete iter->second;
+        }
       }
+      shard.m_psets.clear();
     }
 
+    addsetDB_monitor addset_lock{ Uintah::CrowdMonitor<addsetDB_tag>::WRITER };
+
     for (psetAddDBType::const_iterator iter = m_addset_DB.begin(); iter != m_addset_DB.end(); ++iter) {
       std::map<const VarLabel*, ParticleVariableBase*>::const_iterator pvar_itr;
       for (pvar_itr = iter->second->begin(); pvar_itr != iter->second->end(); pvar_itr++) {
@@ -208,9 +214,10 @@ OnDemandDataWarehouse::clear()
     }
   }
 
+  clearGhostCache();
+
   m_var_DB.clear();
   m_level_DB.clear();
-  m_running_tasks.clear();
 
 
 #ifdef HAVE_CUDA
@@ -242,6 +249,7 @@ OnDemandDataWarehouse::isFinalized() const
 void
 OnDemandDataWarehouse::finalize()
 {
+  clearGhostCache();
   m_var_DB.cleanForeign();
   m_finalized = true;
 }
@@ -252,6 +260,7 @@ void
 OnDemandDataWarehouse::unfinalize()
 {
   // this is for processes that need to make small modifications to the DW after it has been finalized.
+  clearGhostCache();
   m_finalized = false;
 }
 
@@ -315,6 +324,10 @@ OnDemandDataWarehouse::copyKeyDB( KeyDatabase<Patch> & varkeyDB
 //______________________________________________________________________
 void
 OnDemandDataWarehouse::doReserve() {
+  // the key set is known at this point (copyKeyDB), so switch to dense lookups
+  m_var_key_DB.freeze();
+  m_level_key_DB.freeze();
+
   m_var_DB.doReserve(&m_var_key_DB);
   m_level_DB.doReserve(&m_level_key_DB);
 }
@@ -731,9 +744,7 @@ OnDemandDataWarehouse::exchangeParticleQuantities(       DetailedTasks * dts
         if( data[i] > 0 && foreign_particles > 0 ) {
           DOUTR(g_particles_dbg,  "  adjusting particles by " << foreign_particles);
 
-          for( ParticleSubset::iterator iter = subset->begin(); iter != subset->end(); iter++ ) {
-            *iter = *iter + foreign_particles;
-          }
+          subset->shift( foreign_particles );
         }
         foreign_particles += data[i];
 
@@ -964,6 +975,7 @@ OnDemandDataWarehouse::recvMPI(       DependencyBatch       * batch
                                    << "  low: " << low << "  high: " << high << " sizes: " << size
                                    << "  num ghost cells: " << dep->m_req->m_num_ghost_cells);
 
+      invalidateGhostCache( label, matlIndex );
       m_var_DB.putForeign( label, matlIndex, patch, var, d_scheduler->copyTimestep() );  //put new var in data warehouse
       var->getMPIBuffer( buffer, dep->m_low, dep->m_high );
 
@@ -1235,22 +1247,37 @@ OnDemandDataWarehouse::printParticleSubsets()
   DOUTR( true,  "----------------------------------------------");
   DOUTR( true,  "-- Particle Subsets: Available psets on DW " << d_generation << ":" );
 
-  psetDBType::iterator iter;
-  for (iter = m_pset_db.begin(); iter != m_pset_db.end(); iter++) {
-    DOUTR( true, *(iter->second) );
+  for (auto & shard : m_pset_db) {
+    std::lock_guard<Uintah::MasterLock> pset_shard_lock(shard.m_lock);
+    for (psetDBType::iterator iter = shard.m_psets.begin(); iter != shard.m_psets.end(); iter++) {
+      DOUTR( true, *(iter->second) );
+    }
   }
   DOUTR( true,   "----------------------------------------------" );
 }
 
+//______________________________________________________________________
+//
+OnDemandDataWarehouse::psetDBShard&
+OnDemandDataWarehouse::getPSetShard(       psetShardedDBType & db
+                                   , const Patch             * realPatch
+                                   )
+{
+  // drop the low (allocation alignment) bits of the patch address before folding
+  size_t h = reinterpret_cast<size_t>(realPatch) >> 4;
+  h ^= (h >> 7) ^ (h >> 13);
+  return db[h & (s_num_pset_shards - 1)];
+}
+
 //______________________________________________________________________
 //
 void
-OnDemandDataWarehouse::insertPSetRecord(       psetDBType     & subsetDB
-                                       , const Patch          * patch
-                                       ,       IntVector        low
-                                       ,       IntVector        high
-                                       ,       int              matlIndex
-                                       ,       ParticleSubset * psubset
+OnDemandDataWarehouse::insertPSetRecord(       psetShardedDBType & subsetDB
+                                       , const Patch             * patch
+                                       ,       IntVector           low
+                                       ,       IntVector           high
+                                       ,       int                 matlIndex
+                                       ,       ParticleSubset    * psubset
                                        )
 {
   psubset->setLow(low);
@@ -1268,23 +1295,24 @@ OnDemandDataWarehouse::insertPSetRecord(       psetDBType     & subsetDB
 #endif
 
   {
-    psetDB_monitor psetDB_lock{ Uintah::CrowdMonitor<psetDB_tag>::WRITER };
+    psetDBShard& shard = getPSetShard(subsetDB, patch->getRealPatch());
+    std::lock_guard<Uintah::MasterLock> pset_shard_lock(shard.m_lock);
 
     psetDBType::key_type key(patch->getRealPatch(), matlIndex, getID());
-    subsetDB.insert(std::pair<psetDBType::key_type, ParticleSubset*>(key, psubset));
+    shard.m_psets.insert(std::pair<psetDBType::key_type, ParticleSubset*>(key, psubset));
     psubset->addReference();
   }
 }
 //______________________________________________________________________
 //
 ParticleSubset*
-OnDemandDataWarehouse::queryPSetDB(       psetDBType & subsetDB
-                                  , const Patch      * patch
-                                  ,       int          matlIndex
-                                  ,       IntVector    low
-                                  ,       IntVector    high
-                                  , const VarLabel   * pos_var
-                                  ,       bool         exact /* = false */
+OnDemandDataWarehouse::queryPSetDB(       psetShardedDBType & subsetDB
+                                  , const Patch             * patch
+                                  ,       int                 matlIndex
+                                  ,       IntVector           low
+                                  ,       IntVector           high
+                                  , const VarLabel          * pos_var
+                                  ,       bool                exact /* = false */
                                   )
 {
   ParticleSubset* subset = nullptr;
@@ -1293,11 +1321,12 @@ OnDemandDataWarehouse::queryPSetDB(       psetDBType & subsetDB
   int best_volume = std::numeric_limits<int>::max();
   int target_volume = Region::getVolume(low,high);
 
+  psetDBShard& shard = getPSetShard(subsetDB, patch->getRealPatch());
 
   {
-    psetDB_monitor psetDB_write_lock{ Uintah::CrowdMonitor<psetDB_tag>::WRITER };
+    std::lock_guard<Uintah::MasterLock> pset_shard_lock(shard.m_lock);
 
-    std::pair<psetDBType::const_iterator, psetDBType::const_iterator> ret = subsetDB.equal_range(key);
+    std::pair<psetDBType::const_iterator, psetDBType::const_iterator> ret = shard.m_psets.equal_range(key);
 
     // search multimap for best subset
     for (psetDBType::const_iterator iter = ret.first; iter != ret.second; ++iter) {
@@ -1323,7 +1352,7 @@ OnDemandDataWarehouse::queryPSetDB(       psetDBType & subsetDB
         }
       }
     }
-  } // end psetDB_write_lock{ Uintah::CrowdMonitor<psetDB_tag>::WRITER }
+  } // end pset_shard_lock
 
 
   if (exact && best_volume != target_volume) {
@@ -1353,9 +1382,9 @@ OnDemandDataWarehouse::queryPSetDB(       psetDBType & subsetDB
 
   // save subset for future queries
   {
-    psetDB_monitor psetDB_write_lock{ Uintah::CrowdMonitor<psetDB_tag>::WRITER };
+    std::lock_guard<Uintah::MasterLock> pset_shard_lock(shard.m_lock);
 
-    subsetDB.insert(std::pair<psetDBType::key_type, ParticleSubset*>(key, newsubset));
+    shard.m_psets.insert(std::pair<psetDBType::key_type, ParticleSubset*>(key, newsubset));
     newsubset->addReference();
   }
 
@@ -1774,6 +1803,11 @@ OnDemandDataWarehouse::allocateAndPut(       ParticleVariableBase & var
   }
 
   var.allocate(pset);
+
+  if (NUMAPlacement::isEnabled()) {
+    NUMAPlacement::place(patch, var.getBasePointer(), var.getDataSize());
+  }
+
   put(var, label);
 }
 
@@ -1846,11 +1880,22 @@ OnDemandDataWarehouse::get(       constGridVariableBase & constVar
                           ,       int                     numGhostCells
                           )
 {
+  checkGetAccess( label, matlIndex, patch, gtype, numGhostCells );
+
+  // only the host path reassembles ghost cells on every get
+  const bool use_ghost_cache = s_use_ghost_cache && numGhostCells > 0 && !Parallel::usingDevice();
+  if (use_ghost_cache && getCachedGhostWindow( constVar, label, matlIndex, patch, gtype, numGhostCells )) {
+    return;
+  }
+
   GridVariableBase* var = constVar.cloneType();
 
-  checkGetAccess( label, matlIndex, patch, gtype, numGhostCells );
   getGridVar( *var, label, matlIndex, patch, gtype, numGhostCells );
 
+  if (use_ghost_cache) {
+    putCachedGhostWindow( *var, label, matlIndex, patch, gtype, numGhostCells );
+  }
+
   constVar = *var;
   delete var;
 }
@@ -1867,6 +1912,7 @@ OnDemandDataWarehouse::getModifiable(       GridVariableBase & var
                                     )
 {
  //checkModifyAccess(label, matlIndex, patch);
+  invalidateGhostCache(label, matlIndex);
   getGridVar(var, label, matlIndex, patch, gtype, numGhostCells);
 }
 
@@ -1924,6 +1970,7 @@ OnDemandDataWarehouse::allocateAndPut(       GridVariableBase & var
 #endif
 
   checkPutAccess(label, matlIndex, patch, false);
+  invalidateGhostCache(label, matlIndex);
   Patch::VariableBasis basis = Patch::translateTypeToBasis(label->typeDescription()->getType(), false);
 
   IntVector lowIndex, highIndex;
@@ -1937,8 +1984,20 @@ OnDemandDataWarehouse::allocateAndPut(       GridVariableBase & var
   //TODO: getMaxDeviceGhost does not count RMCRT tasks graphs and might conflict. Need to fix later.
   //TODO: check the impact on super patch.
   //Check comments in OnDemandDW::allocateAndPut, OnDemandDW::getGridVar, Array3<T>::rewindowExact and UnifiedScheduler::initiateD2H
-  if ( numGhostCells < label->getMaxDeviceGhost() ) {
-    Patch::getGhostOffsets(var.virtualGetTypeDescription()->getType(), label->getMaxDeviceGhostType(), label->getMaxDeviceGhost(), lowOffset, highOffset);
+  //
+  //With halo padded allocation the same is done on the host with the max ghost cells of all host tasks: getGridVar then rewindows
+  //without reallocating and neighbor copies land directly in the halo of the variable in m_var_DB instead of a fresh copy.
+  int              maxGhostCells = label->getMaxDeviceGhost();
+  Ghost::GhostType maxGhostType  = label->getMaxDeviceGhostType();
+  bool             hostHalo      = false;
+  if ( s_halo_padded_allocation && label->getMaxHostGhost() > maxGhostCells ) {
+    maxGhostCells = label->getMaxHostGhost();
+    maxGhostType  = label->getMaxHostGhostType();
+    hostHalo      = ( numGhostCells < maxGhostCells );
+  }
+
+  if ( numGhostCells < maxGhostCells ) {
+    Patch::getGhostOffsets(var.virtualGetTypeDescription()->getType(), maxGhostType, maxGhostCells, lowOffset, highOffset);
   } else {
     Patch::getGhostOffsets(var.virtualGetTypeDescription()->getType(), gtype, numGhostCells, lowOffset, highOffset);
   }
@@ -1963,9 +2022,22 @@ OnDemandDataWarehouse::allocateAndPut(       GridVariableBase & var
     // allocate the memory
     var.allocate(lowIndex, highIndex);
 
+    if (NUMAPlacement::isEnabled()) {
+      NUMAPlacement::place(patch, var.getBasePointer(), var.getDataSize());
+    }
+
     // put the variable in the database
     printDebuggingPutInfo( label, matlIndex, patch, __LINE__ );
     m_var_DB.put(label, matlIndex, patch, var.clone(), d_scheduler->copyTimestep(), true);
+
+    // the task sees the window it asked for, the halo stays with the variable in m_var_DB
+    if (hostHalo) {
+      IntVector reqLowOffset, reqHighOffset, reqLowIndex, reqHighIndex;
+      Patch::getGhostOffsets(var.virtualGetTypeDescription()->getType(), gtype, numGhostCells, reqLowOffset, reqHighOffset);
+      patch->computeExtents(basis, label->getBoundaryLayer(), reqLowOffset, reqHighOffset, reqLowIndex, reqHighIndex);
+      USE_IF_ASSERTS_ON(bool no_realloc =) var.rewindow(reqLowIndex, reqHighIndex);
+      ASSERT(no_realloc);
+    }
   }
   else {
     {
@@ -2013,6 +2085,10 @@ OnDemandDataWarehouse::allocateAndPut(       GridVariableBase & var
 
       var.allocate(superLowIndex, superHighIndex);
 
+      if (NUMAPlacement::isEnabled()) {
+        NUMAPlacement::place(patch, var.getBasePointer(), var.getDataSize());
+      }
+
 #if SCI_ASSERTION_LEVEL >= 3
 
       // check for dead portions of a variable (variable space that isn't covered by any patch).
@@ -2220,6 +2296,7 @@ OnDemandDataWarehouse::put(       GridVariableBase & var
    ASSERT(no_realloc);
    printDebuggingPutInfo( label, matlIndex, patch, __LINE__ );
 
+   invalidateGhostCache(label, matlIndex);
    m_var_DB.put(label, matlIndex, patch, var.clone(), d_scheduler->copyTimestep(),true);
 }
 
@@ -2793,26 +2870,27 @@ OnDemandDataWarehouse::deleteParticles( ParticleSubset * delset )
   const Patch* realPatch = (patch != nullptr) ? patch->getRealPatch() : nullptr;
 
   {
-    delsetDB_monitor delset_lock{ Uintah::CrowdMonitor<delsetDB_tag>::WRITER };
+    psetDBShard& shard = getPSetShard(m_delset_DB, realPatch);
+    std::lock_guard<Uintah::MasterLock> delset_shard_lock(shard.m_lock);
 
     psetDBType::key_type key(realPatch, matlIndex, getID());
-    auto iter = m_delset_DB.find(key);
+    auto iter = shard.m_psets.find(key);
     ParticleSubset* currentDelset;
-    if (iter != m_delset_DB.end()) {  //update existing delset
+    if (iter != shard.m_psets.end()) {  //update existing delset
       // Concatenate the delsets into the delset that already exists in the DB.
       currentDelset = iter->second;
       for (auto iter = delset->begin(); iter != delset->end(); ++iter) {
         currentDelset->addParticle(*iter);
       }
 
-      m_delset_DB.erase(key);
-      m_delset_DB.insert(std::pair<psetDBType::key_type, ParticleSubset*>(key, currentDelset));
+      shard.m_psets.erase(key);
+      shard.m_psets.insert(std::pair<psetDBType::key_type, ParticleSubset*>(key, currentDelset));
 
       delete delset;
 
     }
     else {
-      m_delset_DB.insert(std::pair<psetDBType::key_type, ParticleSubset*>(key, delset));
+      shard.m_psets.insert(std::pair<psetDBType::key_type, ParticleSubset*>(key, delset));
       delset->addReference();
     }
   }
@@ -2934,6 +3012,7 @@ OnDemandDataWarehouse::scrub( const VarLabel * var
     case TypeDescription::SFCZVariable :
     case TypeDescription::PerPatch :
     case TypeDescription::ParticleVariable : {
+      invalidateGhostCache(var, matlIndex);
       m_var_DB.scrub(var, matlIndex, patch);
       break;
     }
@@ -3103,6 +3182,121 @@ void OnDemandDataWarehouse::getValidNeighbors( const VarLabel
   } //end for neighbors
 }
 
+//______________________________________________________________________
+//
+bool
+OnDemandDataWarehouse::getCachedGhostWindow(       constGridVariableBase & constVar
+                                           , const VarLabel              * label
+                                           ,       int                     matlIndex
+                                           , const Patch                 * patch
+                                           ,       Ghost::GhostType        gtype
+                                           ,       int                     numGhostCells
+                                           )
+{
+  std::lock_guard<Uintah::MasterLock> ghost_cache_lock(m_ghost_cache_lock);
+
+  auto label_iter = m_ghost_cache_DB.find(std::make_pair(label, matlIndex));
+  if (label_iter == m_ghost_cache_DB.end()) {
+    return false;
+  }
+
+  auto window_iter = label_iter->second.find(std::make_tuple(patch, static_cast<int>(gtype), numGhostCells));
+  if (window_iter == label_iter->second.end()) {
+    return false;
+  }
+
+  // shares the cached window's data, no copy
+  constVar = *window_iter->second;
+
+  return true;
+}
+
+//______________________________________________________________________
+//
+void
+OnDemandDataWarehouse::putCachedGhostWindow(       GridVariableBase & var
+                                           , const VarLabel         * label
+                                           ,       int                matlIndex
+                                           , const Patch            * patch
+                                           ,       Ghost::GhostType   gtype
+                                           ,       int                numGhostCells
+                                           )
+{
+  std::lock_guard<Uintah::MasterLock> ghost_cache_lock(m_ghost_cache_lock);
+
+  // if another thread assembled the same window first, keep the one already cached
+  auto & windows = m_ghost_cache_DB[std::make_pair(label, matlIndex)];
+  auto   key     = std::make_tuple(patch, static_cast<int>(gtype), numGhostCells);
+  if (windows.find(key) == windows.end()) {
+    windows[key] = var.clone();
+  }
+}
+
+//______________________________________________________________________
+//
+void
+OnDemandDataWarehouse::invalidateGhostCache( const VarLabel * label
+                                           ,       int        matlIndex
+                                           )
+{
+  // a new version of (label, matl) also needs its shared halos gathered again
+  if (s_halo_padded_allocation) {
+    std::lock_guard<Uintah::MasterLock> host_halo_lock(m_host_halo_lock);
+
+    auto first = m_host_halo_DB.lower_bound(hostHaloKey(label, matlIndex, nullptr));
+    for (auto iter = first; iter != m_host_halo_DB.end() && std::get<0>(iter->first) == label && std::get<1>(iter->first) == matlIndex; ++iter) {
+      iter->second.m_state.store(HALO_EMPTY, std::memory_order_release);
+    }
+  }
+
+  if (!s_use_ghost_cache) {
+    return;
+  }
+
+  // any write to (label, matl) may change the ghost cells of every window assembled for it
+  std::lock_guard<Uintah::MasterLock> ghost_cache_lock(m_ghost_cache_lock);
+
+  auto label_iter = m_ghost_cache_DB.find(std::make_pair(label, matlIndex));
+  if (label_iter != m_ghost_cache_DB.end()) {
+    for (auto & window : label_iter->second) {
+      delete window.second;
+    }
+    m_ghost_cache_DB.erase(label_iter);
+  }
+}
+
+//______________________________________________________________________
+//
+void
+OnDemandDataWarehouse::clearGhostCache()
+{
+  std::lock_guard<Uintah::MasterLock> ghost_cache_lock(m_ghost_cache_lock);
+
+  for (auto & label_windows : m_ghost_cache_DB) {
+    for (auto & window : label_windows.second) {
+      delete window.second;
+    }
+  }
+  m_ghost_cache_DB.clear();
+
+  std::lock_guard<Uintah::MasterLock> host_halo_lock(m_host_halo_lock);
+  m_host_halo_DB.clear();
+}
+
+//______________________________________________________________________
+//
+OnDemandDataWarehouse::HostHalo &
+OnDemandDataWarehouse::getHostHalo( const VarLabel * label
+                                  ,       int        matlIndex
+                                  , const Patch    * patch
+                                  )
+{
+  std::lock_guard<Uintah::MasterLock> host_halo_lock(m_host_halo_lock);
+
+  // map nodes are stable, so the entry can be used after the lock is released
+  return m_host_halo_DB[hostHaloKey(label, matlIndex, patch)];
+}
+
 //______________________________________________________________________
 //
 /*
@@ -3242,9 +3436,43 @@ OnDemandDataWarehouse::getGridVar(       GridVariableBase & var
       return; // no need to gather ghost cells. Do not update status. Return. Scenarios G1* and G4*
     }
     bool should_gather = false;
+    HostHalo * shared_halo = nullptr;
+
+    if (Parallel::usingDevice() == false && s_halo_padded_allocation && no_reallocation_needed) {
+      // The halo is part of the variable in m_var_DB and shared by every getter: one thread gathers it per
+      // version of the variable and the others wait for it. A getter asking for more than was gathered,
+      // or for a virtual patch (whose offset view would write the real patch's halo), gets its own copy.
+      bool use_shared = !patch->isVirtual();
+      if (use_shared) {
+        HostHalo & halo = getHostHalo(label, matlIndex, patch);
+        int state = HALO_EMPTY;
+        if (halo.m_state.compare_exchange_strong(state, HALO_GATHERING, std::memory_order_acq_rel)) {
+          halo.m_gtype           = gtype;
+          halo.m_num_ghost_cells = numGhostCells;
+          shared_halo            = &halo;
+          should_gather          = true;
+        }
+        else {
+          while ((state = halo.m_state.load(std::memory_order_acquire)) == HALO_GATHERING) {
+            std::this_thread::yield();
+          }
+          use_shared = (state == HALO_VALID && halo.m_gtype == gtype && numGhostCells <= halo.m_num_ghost_cells);
+          if (use_shared) {
+            return;
+          }
+        }
+      }
 
-
-    if (Parallel::usingDevice() == false) { //G5*
+      if (!use_shared) {
+        GridVariableBase* copy = var.cloneType();
+        copy->allocate(lowIndex, highIndex);
+        copy->copyPatch(&var, low, high);
+        var.copyPointer(*copy);
+        delete copy;
+        should_gather = true;
+      }
+    }
+    else if (Parallel::usingDevice() == false) { //G5*
       should_gather = true; //G5 R2: set final ngc = ngc, gather ghost cells and return. Do not worry about status
     }
     else {
@@ -3276,6 +3504,9 @@ OnDemandDataWarehouse::getGridVar(       GridVariableBase & var
             std::cout << " Bad range: " << iter->low << " " << iter->high
                       << " source var range: "  << iter->validNeighbor->getLow() << " " << iter->validNeighbor->getHigh()
                       << std::endl;
+            if (shared_halo) {
+              shared_halo->m_state.store(HALO_EMPTY, std::memory_order_release);  // do not leave the waiters spinning
+            }
             throw e;
           }
           delete srcvar;
@@ -3284,6 +3515,9 @@ OnDemandDataWarehouse::getGridVar(       GridVariableBase & var
       if (Parallel::usingDevice() && no_reallocation_needed == true && numGhostCells == label->getMaxDeviceGhost()) {//this is need because rmcrt task graph might have different values of getMaxDeviceGhost. if condition avoids the conflict
         setValidWithGhostsOnCPU(label->getName().c_str(), patch->getID(), matlIndex, patch->getLevel()->getID() ); //ghosts are ready
       }
+      if (shared_halo) {
+        shared_halo->m_state.store(HALO_VALID, std::memory_order_release);
+      }
     }
     else { //threads which does not get to copy the data should wait until copy is completed.
       while (isValidWithGhostsOnCPU(label->getName().c_str(), patch->getID(), matlIndex, patch->getLevel()->getID()) == false );
@@ -3369,6 +3603,8 @@ OnDemandDataWarehouse::transferFrom(       DataWarehouse
         case TypeDescription::SFCXVariable :
         case TypeDescription::SFCYVariable :
         case TypeDescription::SFCZVariable : {
+          invalidateGhostCache( label, matl );
+
           //See if it exists in the CPU or GPU
           bool found = false;
           if (fromDW->m_var_DB.exists(label, matl, patch)) {
@@ -3482,12 +3718,15 @@ OnDemandDataWarehouse::logMemoryUse(       std::ostream  & out
   m_var_DB.logMemoryUse(out, total, tag, dwid);
 
   // Log the psets.
-  for (psetDBType::iterator iter = m_pset_db.begin(); iter != m_pset_db.end(); iter++) {
-    ParticleSubset* pset = iter->second;
-    std::ostringstream elems;
-    elems << pset->numParticles();
-    logMemory(out, total, tag, "particles", "ParticleSubset", pset->getPatch(), pset->getMatlIndex(), elems.str(),
-              pset->numParticles() * sizeof(particleIndex), pset->getPointer(), dwid);
+  for (auto & shard : m_pset_db) {
+    std::lock_guard<Uintah::MasterLock> pset_shard_lock(shard.m_lock);
+    for (psetDBType::iterator iter = shard.m_psets.begin(); iter != shard.m_psets.end(); iter++) {
+      ParticleSubset* pset = iter->second;
+      std::ostringstream elems;
+      elems << pset->numParticles();
+      logMemory(out, total, tag, "particles", "ParticleSubset", pset->getPatch(), pset->getMatlIndex(), elems.str(),
+                pset->numParticles() * sizeof(particleIndex), pset->getPointer(), dwid);
+    }
   }
 }
 
@@ -3505,113 +3744,112 @@ OnDemandDataWarehouse::checkGetAccess( const VarLabel         * label
 
 #if SCI_ASSERTION_LEVEL >= 1
 
-  std::map<std::thread::id, RunningTaskInfo>* runningTasks = getRunningTasksInfo();
+  // only the task running on this thread is checked
+  RunningTaskInfo* currentTaskInfo = getCurrentTaskInfo();
 
-  if (runningTasks != nullptr) {
-    for (auto iter = runningTasks->begin(); iter != runningTasks->end(); ++iter) {
-      RunningTaskInfo& runningTaskInfo = iter->second;
-      const Task* runningTask = runningTaskInfo.m_task;
+  if (currentTaskInfo != nullptr) {
+    RunningTaskInfo& runningTaskInfo = *currentTaskInfo;
+    const Task* runningTask = runningTaskInfo.m_task;
 
-      // don't check if done outside of any task (i.e. SimulationController)
-      if (runningTask == nullptr) {
-        return;
-      }
+    // don't check if done outside of any task (i.e. SimulationController)
+    if (runningTask == nullptr) {
+      return;
+    }
 
-      IntVector lowOffset, highOffset;
-      Patch::getGhostOffsets(label->typeDescription()->getType(), gtype, numGhostCells, lowOffset, highOffset);
+    IntVector lowOffset, highOffset;
+    Patch::getGhostOffsets(label->typeDescription()->getType(), gtype, numGhostCells, lowOffset, highOffset);
 
-      VarAccessMap& runningTaskAccesses = runningTaskInfo.m_accesses;
+    VarAccessMap& runningTaskAccesses = runningTaskInfo.m_accesses;
 
-      std::map<VarLabelMatl<Patch>, AccessInfo>::iterator findIter;
-      findIter = runningTaskAccesses.find(VarLabelMatl<Patch>(label, matlIndex, patch));
+    std::map<VarLabelMatl<Patch>, AccessInfo>::iterator findIter;
+    findIter = runningTaskAccesses.find(VarLabelMatl<Patch>(label, matlIndex, patch));
 
-      if (!hasGetAccess(runningTask, label, matlIndex, patch, lowOffset, highOffset, &runningTaskInfo) && !hasPutAccess(runningTask, label, matlIndex, patch)) {
+    if (!hasGetAccess(runningTask, label, matlIndex, patch, lowOffset, highOffset, &runningTaskInfo) && !hasPutAccess(runningTask, label, matlIndex, patch)) {
 
-        // If it was accessed by the current task already, then it should have get access
-        // (i.e. if you put it in, you should be able to get it right back out).
-        if (findIter != runningTaskAccesses.end() && lowOffset == IntVector(0, 0, 0) && highOffset == IntVector(0, 0, 0)) {
-          return;  // allow non ghost cell get if any access (get, put, or modify) is allowed
-        }
+      // If it was accessed by the current task already, then it should have get access
+      // (i.e. if you put it in, you should be able to get it right back out).
+      if (findIter != runningTaskAccesses.end() && lowOffset == IntVector(0, 0, 0) && highOffset == IntVector(0, 0, 0)) {
+        return;  // allow non ghost cell get if any access (get, put, or modify) is allowed
+      }
 
-        if (runningTask == nullptr || !(std::string(runningTask->getName()) == "Relocate::relocateParticles" || std::string(runningTask->getName()) == "SchedulerCommon::copyDataToNewGrid")) {
-          std::string has{};
-          switch (getWhichDW(&runningTaskInfo)) {
-            case Task::NewDW : {
-              has = "Task::NewDW";
-              break;
-            }
-            case Task::OldDW : {
-              has = "Task::OldDW";
-              break;
-            }
-            case Task::ParentNewDW : {
-              has = "Task::ParentNewDW";
-              break;
-            }
-            case Task::ParentOldDW : {
-              has = "Task::ParentOldDW";
-              break;
-            }
-            default : {
-              has = "UnknownDW";
-            }
+      if (runningTask == nullptr || !(std::string(runningTask->getName()) == "Relocate::relocateParticles" || std::string(runningTask->getName()) == "SchedulerCommon::copyDataToNewGrid")) {
+        std::string has{};
+        switch (getWhichDW(&runningTaskInfo)) {
+          case Task::NewDW : {
+            has = "Task::NewDW";
+            break;
+          }
+          case Task::OldDW : {
+            has = "Task::OldDW";
+            break;
+          }
+          case Task::ParentNewDW : {
+            has = "Task::ParentNewDW";
+            break;
+          }
+          case Task::ParentOldDW : {
+            has = "Task::ParentOldDW";
+            break;
           }
+          default : {
+            has = "UnknownDW";
+          }
+        }
 
-          has += " datawarehouse get";
+        has += " datawarehouse get";
 
-          if (numGhostCells > 0) {
-            std::ostringstream ghost_str;
-            ghost_str << " for " << numGhostCells << " layer";
+        if (numGhostCells > 0) {
+          std::ostringstream ghost_str;
+          ghost_str << " for " << numGhostCells << " layer";
 
-            if (numGhostCells > 1) {
-              ghost_str << "s";
-            }
-            ghost_str << " of ghosts around " << Ghost::getGhostTypeName(gtype);
-            has += ghost_str.str();
+          if (numGhostCells > 1) {
+            ghost_str << "s";
           }
-          std::string needs = "task requires";
+          ghost_str << " of ghosts around " << Ghost::getGhostTypeName(gtype);
+          has += ghost_str.str();
+        }
+        std::string needs = "task requires";
 #if 1
-          SCI_THROW(DependencyException(runningTask, label, matlIndex, patch, has, needs, __FILE__, __LINE__));
+        SCI_THROW(DependencyException(runningTask, label, matlIndex, patch, has, needs, __FILE__, __LINE__));
 #else
-          if ( d_myworld->myRank() == 0 ) {
-            DOUT(true, DependencyException::makeMessage(runningTask, label, matlIndex, patch, has, needs));
-          }
-#endif
+        if ( d_myworld->myRank() == 0 ) {
+          DOUT(true, DependencyException::makeMessage(runningTask, label, matlIndex, patch, has, needs));
         }
+#endif
       }
-      else {
-        // access granted
-        if (findIter == runningTaskAccesses.end()) {
-          AccessInfo& accessInfo = runningTaskAccesses[VarLabelMatl<Patch>(label, matlIndex, patch)];
-          accessInfo.accessType = GetAccess;
-          accessInfo.encompassOffsets(lowOffset, highOffset);
-
-          int ID = 0;
-          if (patch) {
-            ID = patch->getID();
-          }
-          std::string varname = "noname";
-          if (label) {
-            varname = label->getName();
-          }
-          if (g_dw_get_put_dbg.active()) {
-            std::ostringstream mesg;
-            mesg << " Task running is: " << runningTask->getName();
-            mesg << std::left;
-            mesg.width(10);
-            mesg << "\t" << varname;
-            mesg << std::left;
-            mesg.width(10);
-            mesg << " \t on patch " << ID << " and matl: " << matlIndex << " has been gotten\n";
-            DOUTR(true , mesg.str());
-          }
+    }
+    else {
+      // access granted
+      if (findIter == runningTaskAccesses.end()) {
+        AccessInfo& accessInfo = runningTaskAccesses[VarLabelMatl<Patch>(label, matlIndex, patch)];
+        accessInfo.accessType = GetAccess;
+        accessInfo.encompassOffsets(lowOffset, highOffset);
+
+        int ID = 0;
+        if (patch) {
+          ID = patch->getID();
         }
-        else {
-          findIter->second.encompassOffsets(lowOffset, highOffset);
+        std::string varname = "noname";
+        if (label) {
+          varname = label->getName();
+        }
+        if (g_dw_get_put_dbg.active()) {
+          std::ostringstream mesg;
+          mesg << " Task running is: " << runningTask->getName();
+          mesg << std::left;
+          mesg.width(10);
+          mesg << "\t" << varname;
+          mesg << std::left;
+          mesg.width(10);
+          mesg << " \t on patch " << ID << " and matl: " << matlIndex << " has been gotten\n";
+          DOUTR(true , mesg.str());
         }
       }
+      else {
+        findIter->second.encompassOffsets(lowOffset, highOffset);
+      }
     }
-  }  // running task loop
+  }  // running task
 
 #endif // end #if 1
 
@@ -3631,65 +3869,64 @@ OnDemandDataWarehouse::checkPutAccess( const VarLabel * label
 
 #if SCI_ASSERTION_LEVEL >= 1
 
-  std::map<std::thread::id, RunningTaskInfo>* runningTasks = getRunningTasksInfo();
+  // only the task running on this thread is checked
+  RunningTaskInfo* currentTaskInfo = getCurrentTaskInfo();
 
-  if (runningTasks != nullptr) {
-    for (auto iter = runningTasks->begin(); iter != runningTasks->end(); ++iter) {
-      RunningTaskInfo& runningTaskInfo = iter->second;
-      const Task* runningTask = runningTaskInfo.m_task;
+  if (currentTaskInfo != nullptr) {
+    RunningTaskInfo& runningTaskInfo = *currentTaskInfo;
+    const Task* runningTask = runningTaskInfo.m_task;
 
-      // don't check if outside of any task (i.e. SimulationController)
-      if (runningTask == nullptr) {
-        return;
-      }
+    // don't check if outside of any task (i.e. SimulationController)
+    if (runningTask == nullptr) {
+      return;
+    }
 
-      VarAccessMap& runningTaskAccesses = runningTaskInfo.m_accesses;
+    VarAccessMap& runningTaskAccesses = runningTaskInfo.m_accesses;
 
-      if (!hasPutAccess(runningTask, label, matlIndex, patch)) {
-        if (std::string(runningTask->getName()) != "Relocate::relocateParticles") {
-          std::string has{};
-          std::string needs{};
-          switch (getWhichDW(&runningTaskInfo)) {
-            case Task::NewDW : {
-              has = "Task::NewDW";
-              break;
-            }
-            case Task::OldDW : {
-              has = "Task::OldDW";
-              break;
-            }
-            case Task::ParentNewDW : {
-              has = "Task::ParentNewDW";
-              break;
-            }
-            case Task::ParentOldDW : {
-              has = "Task::ParentOldDW";
-              break;
-            }
-            default : {
-              has = "UnknownDW";
-            }
+    if (!hasPutAccess(runningTask, label, matlIndex, patch)) {
+      if (std::string(runningTask->getName()) != "Relocate::relocateParticles") {
+        std::string has{};
+        std::string needs{};
+        switch (getWhichDW(&runningTaskInfo)) {
+          case Task::NewDW : {
+            has = "Task::NewDW";
+            break;
           }
-          if (replace) {
-            has += " datawarehouse put";
-            needs = "task computes(replace)";
+          case Task::OldDW : {
+            has = "Task::OldDW";
+            break;
           }
-          else {
-            has += " datawarehouse put";
-            needs = "task computes";
+          case Task::ParentNewDW : {
+            has = "Task::ParentNewDW";
+            break;
+          }
+          case Task::ParentOldDW : {
+            has = "Task::ParentOldDW";
+            break;
           }
+          default : {
+            has = "UnknownDW";
+          }
+        }
+        if (replace) {
+          has += " datawarehouse put";
+          needs = "task computes(replace)";
+        }
+        else {
+          has += " datawarehouse put";
+          needs = "task computes";
+        }
 #if 1
-          SCI_THROW(DependencyException(runningTask, label, matlIndex, patch, has, needs, __FILE__, __LINE__));
+        SCI_THROW(DependencyException(runningTask, label, matlIndex, patch, has, needs, __FILE__, __LINE__));
 #else
-          if ( d_myworld->myRank() == 0 ) {
-            DOUT(true, DependencyException::makeMessage(runningTask, label, matlIndex, patch, has, needs));
-          }
-#endif
+        if ( d_myworld->myRank() == 0 ) {
+          DOUT(true, DependencyException::makeMessage(runningTask, label, matlIndex, patch, has, needs));
         }
+#endif
       }
-      else {
-        runningTaskAccesses[VarLabelMatl<Patch>(label, matlIndex, patch)].accessType = replace ? ModifyAccess : PutAccess;
-      }
+    }
+    else {
+      runningTaskAccesses[VarLabelMatl<Patch>(label, matlIndex, patch)].accessType = replace ? ModifyAccess : PutAccess;
     }
   }
 
@@ -3757,6 +3994,16 @@ OnDemandDataWarehouse::hasPutAccess( const Task     * runningTask
   return runningTask->hasComputes( label, matlIndex, patch );
 }
 
+//______________________________________________________________________
+//
+OnDemandDataWarehouse::RunningTaskList&
+OnDemandDataWarehouse::getThreadRunningTasks()
+{
+  // each thread only ever sees the tasks it runs itself, so the access checks never take a lock
+  static thread_local RunningTaskList running_tasks{};
+  return running_tasks;
+}
+
 //______________________________________________________________________
 //
 void
@@ -3764,12 +4011,15 @@ OnDemandDataWarehouse::pushRunningTask( const Task
                                       ,       std::vector<OnDemandDataWarehouseP>* dws
                                       )
 {
-  std::lock_guard<Uintah::MasterLock> push_lock(g_running_tasks_lock);
-
   ASSERT(task);
 
-  // true if the element was inserted, false if already exists
-  bool inserted = m_running_tasks.insert(std::make_pair(std::this_thread::get_id(), RunningTaskInfo(task, dws))).second;
+  RunningTaskList& running_tasks = getThreadRunningTasks();
+
+  // only inserted if this thread is not already running a task on this DW
+  bool inserted = (getCurrentTaskInfo() == nullptr);
+  if (inserted) {
+    running_tasks.emplace_back(this, RunningTaskInfo(task, dws));
+  }
 
   DOUT(g_check_accesses, "Rank-" << Parallel::getMPIRank() << " TID-" << std::this_thread::get_id() << "  Task: " << task->getName() << ((inserted) ? " was pushed for access check." : " not pushed, element exists."));
 
@@ -3780,30 +4030,15 @@ OnDemandDataWarehouse::pushRunningTask( const Task
 void
 OnDemandDataWarehouse::popRunningTask()
 {
-  std::lock_guard<Uintah::MasterLock> pop_lock(g_running_tasks_lock);
-
-  auto iter = m_running_tasks.find(std::this_thread::get_id());
-  if (iter != m_running_tasks.end()) {
-    size_t num_erased = m_running_tasks.erase(std::this_thread::get_id());
-    DOUT(g_check_accesses, "Rank-" << Parallel::getMPIRank() << " TID-" << std::this_thread::get_id()
-                                   << "  Task: " << iter->second.m_task->getName() << " removed ("
-                                   << num_erased << " total element(s))");
-  }
-}
-
-//______________________________________________________________________
-//
-inline std::map<std::thread::id, OnDemandDataWarehouse::RunningTaskInfo>*
-OnDemandDataWarehouse::getRunningTasksInfo()
-{
-  std::lock_guard<Uintah::MasterLock> get_running_task_lock(g_running_tasks_lock);
-
-
-  if (m_running_tasks.empty()) {
-    return nullptr;
-  }
-  else {
-    return &m_running_tasks;
+  RunningTaskList& running_tasks = getThreadRunningTasks();
+
+  for (auto iter = running_tasks.begin(); iter != running_tasks.end(); ++iter) {
+    if (iter->first == this) {
+      DOUT(g_check_accesses, "Rank-" << Parallel::getMPIRank() << " TID-" << std::this_thread::get_id()
+                                     << "  Task: " << iter->second.m_task->getName() << " removed");
+      running_tasks.erase(iter);
+      return;
+    }
   }
 }
 
@@ -3812,9 +4047,7 @@ OnDemandDataWarehouse::getRunningTasksInfo()
 inline bool
 OnDemandDataWarehouse::hasRunningTask()
 {
-  std::lock_guard<Uintah::MasterLock> has_running_task_lock(g_running_tasks_lock);
-
-  return (m_running_tasks.find(std::this_thread::get_id()) != m_running_tasks.end());
+  return (getCurrentTaskInfo() != nullptr);
 }
 
 //______________________________________________________________________
@@ -3822,16 +4055,13 @@ OnDemandDataWarehouse::hasRunningTask()
 inline OnDemandDataWarehouse::RunningTaskInfo*
 OnDemandDataWarehouse::getCurrentTaskInfo()
 {
-  std::lock_guard<Uintah::MasterLock> get_running_task_lock(g_running_tasks_lock);
-
-  auto iter = m_running_tasks.find(std::this_thread::get_id());
-
-  if (iter == m_running_tasks.end()) {
-    return nullptr;
-  }
-  else {
-    return &(m_running_tasks.find(std::this_thread::get_id())->second);
+  // a thread has at most one entry per DW it is running a task on (a handful at most)
+  for (auto & running_task : getThreadRunningTasks()) {
+    if (running_task.first == this) {
+      return &running_task.second;
+    }
   }
+  return nullptr;
 }
 
 //______________________________________________________________________
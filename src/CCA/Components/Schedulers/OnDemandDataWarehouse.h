@@ -39,8 +39,11 @@
 #include <Core/Parallel/MasterLock.h>
 #include <Core/Parallel/UintahMPI.h>
 
+#include <array>
+#include <atomic>
 #include <iosfwd>
 #include <map>
+#include <tuple>
 #include <vector>
 
 
@@ -60,6 +63,19 @@ inline const Level* getRealDomain( const Level * level )
   return level;
 }
 
+// dense integer ids of the DWDatabase domains, see KeyDatabase::freeze().
+// Only unique within a grid; KeyDatabase also compares the domain itself.
+inline int getDenseDomainID( const Patch * patch )
+{
+  return patch->getID();
+}
+
+inline int getDenseDomainID( const Level * level )
+{
+  // level-independent variables are stored with a null level
+  return (level != nullptr) ? level->getIndex() + 1 : 0;
+}
+
 
 class BufferInfo;
 class DependencyBatch;
@@ -1025,6 +1041,12 @@ public:
 
   static bool s_combine_memory;
 
+  // Cache the ghosted windows assembled by get() for the lifetime of this DW (<ghost_gather_cache> in the Scheduler block)
+  static bool s_use_ghost_cache;
+
+  // Allocate grid variables with the largest ghost region any host task requires of them (<halo_padded_allocation> in the Scheduler block)
+  static bool s_halo_padded_allocation;
+
   //DS: 01042020: fix for OnDemandDW race condition
   //bool compareAndSwapAllocateOnCPU(char const* label, const int patchID, const int matlIndx, const int levelIndx);
   bool compareAndSwapSetValidOnCPU(char const* label, int patchID, int matlIndx, int levelIndx);
@@ -1121,6 +1143,30 @@ private:
                  ,       int                exactWindow=0 //reallocate even if existing window is larger than requested. Exactly match dimensions
                  );
 
+  // Ghost gather cache: the windows assembled by getGridVar for (label, matl, patch, gtype, numGhostCells),
+  // handed out read-only to later getters and dropped for a (label, matl) whenever it is written.
+  bool getCachedGhostWindow(       constGridVariableBase & constVar
+                           , const VarLabel              * label
+                           ,       int                     matlIndex
+                           , const Patch                 * patch
+                           ,       Ghost::GhostType        gtype
+                           ,       int                     numGhostCells
+                           );
+
+  void putCachedGhostWindow(       GridVariableBase & var
+                           , const VarLabel         * label
+                           ,       int                matlIndex
+                           , const Patch            * patch
+                           ,       Ghost::GhostType   gtype
+                           ,       int                numGhostCells
+                           );
+
+  void invalidateGhostCache( const VarLabel * label
+                           ,       int        matlIndex
+                           );
+
+  void clearGhostCache();
+
   inline Task::WhichDW getWhichDW( RunningTaskInfo * info );
 
   // These will throw an exception if access is not allowed for the current task.
@@ -1185,37 +1231,70 @@ private:
 #endif
 
 
+  using ghostWindowKey       = std::tuple<const Patch*, int, int>;  // patch, ghost type, num ghost cells
+  using ghostCacheDBType     = std::map<std::pair<const VarLabel*, int>, std::map<ghostWindowKey, GridVariableBase*> >;
+
+  // The halo of a halo padded variable is shared by every task that gets the variable with
+  // ghost cells, so it is gathered once per version of the variable (see getGridVar).
+  enum HostHaloState { HALO_EMPTY = 0, HALO_GATHERING, HALO_VALID };
+
+  struct HostHalo {
+    std::atomic<int>  m_state           { HALO_EMPTY };
+    Ghost::GhostType  m_gtype           { Ghost::None };  // the region gathered, set before HALO_VALID
+    int               m_num_ghost_cells { 0 };
+  };
+
+  using hostHaloKey          = std::tuple<const VarLabel*, int, const Patch*>;  // label, matl, patch
+  using hostHaloDBType       = std::map<hostHaloKey, HostHalo>;
+
+  HostHalo & getHostHalo( const VarLabel * label
+                        ,       int        matlIndex
+                        , const Patch    * patch
+                        );
+
   using psetDBType           = std::multimap<PSPatchMatlGhost, ParticleSubset*>;
+
+  // particle subsets are sharded by (real) patch, each shard with its own lock,
+  // so tasks on different patches never contend for the pset databases
+  struct psetDBShard {
+    Uintah::MasterLock m_lock   {};
+    psetDBType         m_psets  {};
+  };
+  static constexpr int s_num_pset_shards = 32;   // must be a power of two
+  using psetShardedDBType    = std::array<psetDBShard, s_num_pset_shards>;
+
+  static psetDBShard& getPSetShard(       psetShardedDBType & db
+                                  , const Patch             * realPatch
+                                  );
+
   using psetAddDBType        = std::map<std::pair<int, const Patch*>, std::map<const VarLabel*, ParticleVariableBase*>*>;
   using particleQuantityType = std::map<std::pair<int, const Patch*>, int> ;
 
-  ParticleSubset* queryPSetDB(       psetDBType & db
-                             , const Patch      * patch
-                             ,       int          matlIndex
-                             ,       IntVector    low
-                             ,       IntVector    high
-                             , const VarLabel   * pos_var
-                             ,       bool         exact = false
+  ParticleSubset* queryPSetDB(       psetShardedDBType & db
+                             , const Patch             * patch
+                             ,       int                 matlIndex
+                             ,       IntVector           low
+                             ,       IntVector           high
+                             , const VarLabel          * pos_var
+                             ,       bool                exact = false
                              );
 
-  void insertPSetRecord(       psetDBType     & subsetDB
-                       , const Patch          * patch
-                       ,       IntVector        low
-                       ,       IntVector        high
-                       ,       int              matlIndex
-                       ,       ParticleSubset * psubset
+  void insertPSetRecord(       psetShardedDBType & subsetDB
+                       , const Patch             * patch
+                       ,       IntVector           low
+                       ,       IntVector           high
+                       ,       int                 matlIndex
+                       ,       ParticleSubset    * psubset
                        );
 
 
   inline bool hasRunningTask();
 
-  inline std::map<std::thread::id, OnDemandDataWarehouse::RunningTaskInfo>* getRunningTasksInfo();
-
   inline RunningTaskInfo* getCurrentTaskInfo();
 
-
-  // holds info on the running task for each std::thread::id
-  std::map<std::thread::id, RunningTaskInfo> m_running_tasks {};
+  // the tasks the calling thread is running, one entry per DW (thread_local, set in DetailedTask::doit via pushRunningTask)
+  using RunningTaskList = std::vector<std::pair<const OnDemandDataWarehouse*, RunningTaskInfo> >;
+  static RunningTaskList& getThreadRunningTasks();
 
   ScrubMode m_scrub_mode {DataWarehouse::ScrubNone};
 
@@ -1224,10 +1303,14 @@ private:
   KeyDatabase<Patch>    m_var_key_DB   {};
   KeyDatabase<Level>    m_level_key_DB {};
 
-  psetDBType            m_pset_db     {};
-  psetDBType            m_delset_DB   {};
+  psetShardedDBType     m_pset_db     {};
+  psetShardedDBType     m_delset_DB   {};
   psetAddDBType         m_addset_DB   {};
   particleQuantityType  m_foreign_particle_quantities {};
+  ghostCacheDBType      m_ghost_cache_DB {};
+  Uintah::MasterLock    m_ghost_cache_lock {};
+  hostHaloDBType        m_host_halo_DB {};
+  Uintah::MasterLock    m_host_halo_lock {};
   bool                  m_exchange_particle_quantities {true};
 
   // Keep track of when this DW sent some (and which) particle information to another processor
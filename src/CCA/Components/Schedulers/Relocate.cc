@@ -22,15 +22,20 @@
  * IN THE SOFTWARE.
  */
 #include <CCA/Components/Schedulers/Relocate.h>
+#include <CCA/Ports/ApplicationInterface.h>
 #include <CCA/Ports/LoadBalancer.h>
 #include <CCA/Ports/Scheduler.h>
 #include <Core/Containers/Array2.h>
 #include <Core/Grid/DbgOutput.h>
 #include <Core/Grid/Variables/ParticleVariable.h>
+#include <Core/Math/MinMax.h>
 #include <Core/Util/DebugStream.h>
 #include <Core/Util/DOUT.hpp>
 #include <Core/Util/ProgressiveWarning.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
 #include <map>
 #include <set>
 
@@ -46,6 +51,37 @@ namespace {
   Dout g_total_reloc("RELOCATE_SCATTER_DBG", "Schedulers", "prints info on particle scatter ops", false);
 
   DebugStream coutdbg("RELOCATE_DBG", "Schedulers", "prints particle relocation neighbor patches", false);
+
+  Dout g_cell_sort_dbg("RELOCATE_CELL_SORT", "Schedulers", "reports the patches whose particles were reordered by cell", false);
+
+  //______________________________________________________________________
+  // Interleave the low 21 bits of each cell index
+  inline uint64_t
+  spreadBits( uint64_t v )
+  {
+    v &= 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffffULL;
+    v = (v | v << 16) & 0x1f0000ff0000ffULL;
+    v = (v | v << 8)  & 0x100f00f00f00f00fULL;
+    v = (v | v << 4)  & 0x10c30c30c30c30c3ULL;
+    v = (v | v << 2)  & 0x1249249249249249ULL;
+    return v;
+  }
+
+  //______________________________________________________________________
+  // Copy 'var' into a new variable on 'dest' so that dest[i] = var[order[i]]
+  ParticleVariableBase*
+  reorderParticles( ParticleVariableBase * var,
+                    ParticleSubset       * dest,
+                    ParticleSubset       * order )
+  {
+    std::vector<ParticleSubset*>       subsets( 1, order );
+    std::vector<ParticleVariableBase*> srcs( 1, var );
+
+    ParticleVariableBase* sorted = var->clone();
+    sorted->gather( dest, subsets, srcs, 0 );
+    return sorted;
+  }
 }
 
 Relocate::~Relocate()
@@ -285,6 +321,7 @@ Relocate::scheduleParticleRelocation(       Scheduler
   t->setType(Task::OncePerProc);
   sched->addTask(t, patches, matls);
   m_lb = lb;
+  m_sched = sched;
 }
 
 //______________________________________________________________________
@@ -380,6 +417,7 @@ Relocate::scheduleParticleRelocation( Scheduler
   t->setType(Task::OncePerProc);
   sched->addTask(t, patches, matls);
   m_lb = lb;
+  m_sched = sched;
 }
 //______________________________________________________________________
 //
@@ -905,6 +943,132 @@ Relocate::findNeighboringPatches(const Patch* patch,
     AllNeighborPatches.push_back(neighbor);
   }
 }
+
+//______________________________________________________________________
+//
+bool
+Relocate::cellSortThisTimeStep() const
+{
+  if (m_cell_sort_interval <= 0 || !m_sched) {
+    return false;
+  }
+  return (m_sched->getApplication()->getTimeStep() % m_cell_sort_interval) == 0;
+}
+
+//______________________________________________________________________
+// Returns the particle order that sorts the particles of posvar by cell,
+// or nullptr if they are already in that order.  The caller owns the subset.
+ParticleSubset*
+Relocate::cellSortOrder( const Patch          * patch,
+                         int                    matl,
+                         ParticleVariableBase * posvar ) const
+{
+  ParticleVariable<Point>* px   = dynamic_cast<ParticleVariable<Point>*>(posvar);
+  ParticleSubset*          pset = posvar->getParticleSubset();
+
+  // The reordered variables are written back onto a 0..n-1 subset
+  unsigned int numParticles = pset->numParticles();
+  if (!px || numParticles < 2 || !pset->isContiguous() || pset->getFirst() != 0) {
+    return nullptr;
+  }
+
+  const Level* level = patch->getLevel();
+  IntVector    low   = patch->getExtraCellLowIndex();
+  IntVector    high  = patch->getExtraCellHighIndex() - IntVector(1,1,1);
+  IntVector    size  = high - low + IntVector(1,1,1);
+
+  std::vector<std::pair<uint64_t, particleIndex> > keys;
+  keys.reserve(numParticles);
+
+  bool inOrder = true;
+  for (ParticleSubset::iterator iter = pset->begin(); iter != pset->end(); iter++) {
+    particleIndex idx = *iter;
+    IntVector c = Max(low, Min(high, level->getCellIndex((*px)[idx]))) - low;
+
+    uint64_t key;
+    if (m_cell_sort_morton) {
+      key = spreadBits(c.x()) | (spreadBits(c.y()) << 1) | (spreadBits(c.z()) << 2);
+    }
+    else {
+      key = ((uint64_t)c.z() * size.y() + c.y()) * size.x() + c.x();
+    }
+
+    if (!keys.empty() && key < keys.back().first) {
+      inOrder = false;
+    }
+    keys.push_back(std::make_pair(key, idx));
+  }
+
+  if (inOrder) {
+    return nullptr;
+  }
+
+  // particles in the same cell keep their relative order
+  std::stable_sort(keys.begin(), keys.end(),
+                   [](const std::pair<uint64_t, particleIndex>& a, const std::pair<uint64_t, particleIndex>& b) {
+                     return a.first < b.first;
+                   });
+
+  ParticleSubset* order = scinew ParticleSubset(0, matl, patch);
+  order->expand(numParticles);
+  for (unsigned int i = 0; i < numParticles; i++) {
+    order->addParticle(keys[i].second);
+  }
+
+  DOUT(g_cell_sort_dbg, "Rank-" << Parallel::getMPIRank() << " reordered " << numParticles
+                         << " particles by cell on patch " << patch->getID() << " matl " << matl);
+
+  return order;
+}
+
+//______________________________________________________________________
+// Carry the shell scan bins of one patch/material over to the particle
+// numbering the relocation just produced: the kept particles, in order,
+// then everything that arrived, which is examined at every relocation
+// until the next full scan.
+void
+Relocate::updateShellScan( const Patch  * patch,
+                           int            matl,
+                           ShellPass    & pass,
+                           unsigned int   numKept,
+                           unsigned int   numParticles,
+                           bool           reordered )
+{
+  std::pair<int, int> key(patch->getID(), matl);
+
+  if (!pass.track || reordered) {
+    m_shell_scans.erase(key);
+    return;
+  }
+
+  ShellScan& scan   = m_shell_scans[key];
+  scan.timestep     = m_sched->getApplication()->getTimeStep();
+  scan.step         = pass.step;
+  scan.numParticles = numParticles;
+  scan.bands.resize(m_shell_interval - 1);
+
+  for (int b = 0; b < m_shell_interval - 1; b++) {
+    std::vector<particleIndex>& band = scan.bands[b];
+    band.clear();
+
+    std::vector<particleIndex>::const_iterator removed_iter = pass.removed.begin();
+    for (size_t i = 0; i < pass.bands[b].size(); i++) {
+      particleIndex idx = pass.bands[b][i];
+      while (removed_iter != pass.removed.end() && *removed_iter < idx) {
+        removed_iter++;
+      }
+      if (removed_iter != pass.removed.end() && *removed_iter == idx) {
+        continue;
+      }
+      band.push_back(idx - (particleIndex)(removed_iter - pass.removed.begin()));
+    }
+  }
+
+  for (particleIndex idx = numKept; idx < (particleIndex)numParticles; idx++) {
+    scan.bands[0].push_back(idx);
+  }
+}
+
 //______________________________________________________________________
 //
 void
@@ -916,6 +1080,9 @@ Relocate::relocateParticlesModifies( const ProcessorGroup* pg,
                                      const Level* coarsestLevelwithParticles )
 {
   int total_reloc[3] = {0,0,0};
+  bool sort_by_cell   = cellSortThisTimeStep();
+  bool shell_scan     = m_shell_interval > 1 && m_sched;
+  int  timestep       = shell_scan ? m_sched->getApplication()->getTimeStep() : 0;
   if (patches->size() != 0)
   {
     printTask(patches, patches->get(0),coutdbg,"Relocate::relocateParticles");
@@ -928,6 +1095,8 @@ Relocate::relocateParticlesModifies( const ProcessorGroup* pg,
     
     Array2<ParticleSubset*> keep_psets(patches->size(), numMatls);
     keep_psets.initialize(0);
+
+    std::vector<ShellPass> shell_passes(shell_scan ? patches->size() * numMatls : 0);
     
     for(int p=0;p<patches->size();p++){
       const Patch* patch = patches->get(p);
@@ -964,12 +1133,9 @@ Relocate::relocateParticlesModifies( const ProcessorGroup* pg,
         constParticleVariable<Point> px;
         new_dw->get(px, reloc_old_posLabel, pset);
         
-        ParticleSubset* keep_pset    = scinew ParticleSubset(0, -1, 0);
+        ParticleSubset* keep_pset    = nullptr;
         ParticleSubset* delete_pset  = new_dw->getDeleteSubset(matl, patch);
         
-        keep_pset->expand(numParticles);
-        
-        
         // Look for particles that left the patch,
         // and if they are not in the delete set, put them in relocset
         
@@ -984,11 +1150,18 @@ Relocate::relocateParticlesModifies( const ProcessorGroup* pg,
         const Patch* PP_ToPatch_CL = 0;   // on coarse level
         const Patch* PP_ToPatch    = 0;
         
-        
-        for(ParticleSubset::iterator iter = pset->begin(); iter != pset->end(); iter++){
-          particleIndex idx = *iter;
+        //__________________________________
+        // Find where particle idx goes; true if it stays on this patch.
+        // Particles must be examined in increasing order.
+        auto examine = [&]( particleIndex idx ) -> bool {
           
           const Patch* toPatch = 0; // patch to relocate particles to
+          bool stays = false;
+          
+          // deleted particles that were not examined
+          while (delete_iter != delete_pset->end() && *delete_iter < idx) {
+            delete_iter++;
+          }
           
           //__________________________________
           // Does this particle belong to the delete particle set?
@@ -1010,7 +1183,7 @@ Relocate::relocateParticlesModifies( const ProcessorGroup* pg,
           else if(patch->containsPoint(px[idx])){
             // is particle going to a finer patch?  Note, a particle does not have to leave the current patch
             // to go to a finer patch
-            keep_pset->addParticle(idx);
+            stays = true;
           }
           
           //__________________________________
@@ -1056,11 +1229,106 @@ Relocate::relocateParticlesModifies( const ProcessorGroup* pg,
             ScatterRecord* record = scatter_records.findOrInsertRecord(patch, toPatch, matl, toLevelIndex, pset);
             record->send_pset->addParticle(idx);
           }
-        }  // pset loop
+          return stays;
+        };
+        
+        //__________________________________
+        // Can this relocation look at the particles near the faces only?
+        // Not when particles may go to a finer level from anywhere, nor when
+        // the particles are not the ones the last relocation left here.
+        ShellPass* pass = nullptr;
+        ShellScan* scan = nullptr;
+        
+        if (shell_scan && !fineLevel) {
+          pass = &shell_passes[p * numMatls + m];
+          pass->track = true;
+          
+          std::map<std::pair<int, int>, ShellScan>::iterator found = m_shell_scans.find(std::make_pair(patch->getID(), matl));
+          if (found != m_shell_scans.end()                  &&
+              found->second.timestep     == timestep - 1    &&
+              found->second.step + 1     <  m_shell_interval &&
+              found->second.numParticles == numParticles    &&
+              (numParticles == 0 || (pset->isContiguous() && pset->getFirst() == 0))) {
+            scan = &found->second;
+          }
+        }
+        
+        if (scan) {
+          // Particles fewer than 'step' cells in may have left
+          pass->step = scan->step + 1;
+          
+          std::vector<particleIndex> candidates;
+          for (int b = 0; b < pass->step; b++) {
+            candidates.insert(candidates.end(), scan->bands[b].begin(), scan->bands[b].end());
+          }
+          std::sort(candidates.begin(), candidates.end());
+          
+          std::vector<particleIndex> left;
+          for (size_t i = 0; i < candidates.size(); i++) {
+            if (!examine(candidates[i])) {
+              left.push_back(candidates[i]);
+            }
+          }
+          
+          // Deleted particles go too, examined or not
+          std::merge(left.begin(), left.end(), delete_pset->begin(), delete_pset->end(),
+                     std::back_inserter(pass->removed));
+          pass->removed.erase(std::unique(pass->removed.begin(), pass->removed.end()), pass->removed.end());
+          pass->bands.swap(scan->bands);
+          
+          if (pass->removed.empty()) {
+            keep_pset = pset;
+          }
+          else {
+            keep_pset = scinew ParticleSubset(0, -1, 0);
+            keep_pset->expand(numParticles - pass->removed.size());
+            
+            std::vector<particleIndex>::const_iterator removed_iter = pass->removed.begin();
+            for (particleIndex idx = 0; idx < (particleIndex)numParticles; idx++) {
+              if (removed_iter != pass->removed.end() && *removed_iter == idx) {
+                removed_iter++;
+              }
+              else {
+                keep_pset->addParticle(idx);
+              }
+            }
+          }
+        }
+        else {
+          keep_pset = scinew ParticleSubset(0, -1, 0);
+          keep_pset->expand(numParticles);
+          
+          // Bin the particles that stay by their distance from the faces
+          IntVector cellLow  = patch->getCellLowIndex();
+          IntVector cellHigh = patch->getCellHighIndex() - IntVector(1,1,1);
+          if (pass) {
+            pass->bands.resize(m_shell_interval - 1);
+          }
+          
+          for(ParticleSubset::iterator iter = pset->begin(); iter != pset->end(); iter++){
+            particleIndex idx = *iter;
+            
+            if (examine(idx)) {
+              keep_pset->addParticle(idx);
+              
+              if (pass) {
+                IntVector lo = level->getCellIndex(px[idx]) - cellLow;
+                IntVector hi = cellHigh - lo - cellLow;
+                int margin   = Min(Min(lo.x(), lo.y(), lo.z()), Min(hi.x(), hi.y(), hi.z()));
+                if (margin < m_shell_interval - 1) {
+                  pass->bands[Max(margin, 0)].push_back(idx);
+                }
+              }
+            }
+            else if (pass) {
+              pass->removed.push_back(idx);
+            }
+          }  // pset loop
+        }
         
         //__________________________________
         //  No particles have left the patch
-        if(keep_pset->numParticles() == numParticles){
+        if(keep_pset != pset && keep_pset->numParticles() == numParticles){
           delete keep_pset;
           keep_pset=pset;
         }
@@ -1133,6 +1401,8 @@ Relocate::relocateParticlesModifies( const ProcessorGroup* pg,
         }
         
         ParticleSubset* orig_pset = old_dw->getParticleSubset(matl, toPatch);
+        unsigned int    numNew    = orig_pset->numParticles();
+        bool            reordered = false;
         
         //__________________________________
         // Particles haven't moved, carry the old data forward
@@ -1142,13 +1412,31 @@ Relocate::relocateParticlesModifies( const ProcessorGroup* pg,
           
           // particle position
           ParticleVariableBase* posvar = new_dw->getParticleVariable(reloc_old_posLabel, orig_pset);
-          new_dw->put(*posvar, reloc_new_posLabel);
+          ParticleSubset* cell_order = sort_by_cell ? cellSortOrder(toPatch, matl, posvar) : nullptr;
+
+          if (cell_order) {
+            ParticleVariableBase* sorted = reorderParticles(posvar, orig_pset, cell_order);
+            new_dw->put(*sorted, reloc_new_posLabel);
+            delete sorted;
+            reordered = true;
+          }
+          else {
+            new_dw->put(*posvar, reloc_new_posLabel);
+          }
           
           // all other variables
           for(int v=0;v<numVars;v++){
             ParticleVariableBase* var = new_dw->getParticleVariable(reloc_old_labels[m][v], orig_pset);
-            new_dw->put(*var, reloc_new_labels[m][v]);
+            if (cell_order) {
+              ParticleVariableBase* sorted = reorderParticles(var, orig_pset, cell_order);
+              new_dw->put(*sorted, reloc_new_labels[m][v]);
+              delete sorted;
+            }
+            else {
+              new_dw->put(*var, reloc_new_labels[m][v]);
+            }
           }
+          delete cell_order;
         } else {
           
           //__________________________________
@@ -1183,6 +1471,7 @@ Relocate::relocateParticlesModifies( const ProcessorGroup* pg,
           totalParticles+=numRemote;
           
           ParticleSubset* newsubset = new_dw->createParticleSubset(totalParticles, matl, toPatch);
+          numNew = totalParticles;
           
           //__________________________________
           // particle position
@@ -1277,6 +1566,25 @@ Relocate::relocateParticlesModifies( const ProcessorGroup* pg,
           newsubset->sort(vars[v] /* particleID variable */);
 #endif
           
+          //__________________________________
+          // Optionally reorder the particles by cell
+          if (sort_by_cell) {
+            ParticleSubset* cell_order = cellSortOrder(toPatch, matl, newpos);
+            if (cell_order) {
+              ParticleVariableBase* sorted = reorderParticles(newpos, newsubset, cell_order);
+              delete newpos;
+              newpos = sorted;
+
+              for(int v=0;v<numVars;v++){
+                sorted = reorderParticles(vars[v], newsubset, cell_order);
+                delete vars[v];
+                vars[v] = sorted;
+              }
+              delete cell_order;
+              reordered = true;
+            }
+          }
+
           // Put the data back in the data warehouse
           new_dw->put(*newpos, reloc_new_posLabel);
           
@@ -1287,6 +1595,11 @@ Relocate::relocateParticlesModifies( const ProcessorGroup* pg,
             delete vars[v];
           }
         }  // particles have moved
+        
+        if (shell_scan) {
+          updateShellScan(toPatch, matl, shell_passes[p * numMatls + m], keep_pset->numParticles(), numNew, reordered);
+        }
+        
         if(keep_pset->removeReference()){
           delete keep_pset;
         }
@@ -1297,6 +1610,19 @@ Relocate::relocateParticlesModifies( const ProcessorGroup* pg,
 
   }  // patch size !-= 0
   
+  // Forget patches this rank has stopped relocating
+  if (shell_scan) {
+    std::map<std::pair<int, int>, ShellScan>::iterator iter = m_shell_scans.begin();
+    while (iter != m_shell_scans.end()) {
+      if (iter->second.timestep < timestep - 1) {
+        iter = m_shell_scans.erase(iter);
+      }
+      else {
+        ++iter;
+      }
+    }
+  }
+  
   if (pg->nRanks() > 1){
     finalizeCommunication();
   }
@@ -1331,6 +1657,7 @@ Relocate::relocateParticles(const ProcessorGroup* pg,
                             const Level* coarsestLevelwithParticles)
 {
   int total_reloc[3] = {0,0,0};
+  bool sort_by_cell   = cellSortThisTimeStep();
   if (patches->size() != 0) {
     printTask(patches, patches->get(0),coutdbg,"Relocate::relocateParticles");
     int me = pg->myRank();
@@ -1568,14 +1895,31 @@ Relocate::relocateParticles(const ProcessorGroup* pg,
           // particle position
           ParticleVariableBase* posvar =
                      new_dw->getParticleVariable(reloc_old_posLabel, orig_pset);
-          new_dw->put(*posvar, reloc_new_posLabel);
+          ParticleSubset* cell_order = sort_by_cell ? cellSortOrder(toPatch, matl, posvar) : nullptr;
+
+          if (cell_order) {
+            ParticleVariableBase* sorted = reorderParticles(posvar, orig_pset, cell_order);
+            new_dw->put(*sorted, reloc_new_posLabel);
+            delete sorted;
+          }
+          else {
+            new_dw->put(*posvar, reloc_new_posLabel);
+          }
           
           // all other variables
           for(int v=0;v<numVars;v++){
             ParticleVariableBase* var =
                  new_dw->getParticleVariable(reloc_old_labels[m][v], orig_pset);
-            new_dw->put(*var, reloc_new_labels[m][v]);
+            if (cell_order) {
+              ParticleVariableBase* sorted = reorderParticles(var, orig_pset, cell_order);
+              new_dw->put(*sorted, reloc_new_labels[m][v]);
+              delete sorted;
+            }
+            else {
+              new_dw->put(*var, reloc_new_labels[m][v]);
+            }
           }
+          delete cell_order;
         } else {
 
           // Particles have moved
@@ -1712,6 +2056,24 @@ Relocate::relocateParticles(const ProcessorGroup* pg,
           newsubset->sort(vars[v] /* particleID variable */);
 #endif
   
+          //__________________________________
+          // Optionally reorder the particles by cell
+          if (sort_by_cell) {
+            ParticleSubset* cell_order = cellSortOrder(toPatch, matl, newpos);
+            if (cell_order) {
+              ParticleVariableBase* sorted = reorderParticles(newpos, newsubset, cell_order);
+              delete newpos;
+              newpos = sorted;
+
+              for(int v=0;v<numVars;v++){
+                sorted = reorderParticles(vars[v], newsubset, cell_order);
+                delete vars[v];
+                vars[v] = sorted;
+              }
+              delete cell_order;
+            }
+          }
+
           // Put the data back in the data warehouse
           new_dw->put(*newpos, reloc_new_posLabel);
 
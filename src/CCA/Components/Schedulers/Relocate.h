@@ -28,13 +28,17 @@
 #include <Core/Grid/LevelP.h>
 #include <Core/Grid/Patch.h>
 #include <Core/Grid/Variables/ComputeSet.h>
+#include <Core/Grid/Variables/ParticleSubset.h>
 #include <Core/Parallel/UintahMPI.h>
 
+#include <map>
 #include <vector>
 
 namespace Uintah {
   class DataWarehouse;
   class LoadBalancer;
+  class ParticleSubset;
+  class ParticleVariableBase;
   class ProcessorGroup;
   class Scheduler;
   class VarLabel;
@@ -102,6 +106,23 @@ class Relocate {
 
     const MaterialSet* getMaterialSet() const { return reloc_matls;}
 
+    //////////
+    // Reorder the relocated particles of each patch/material by the cell that
+    // contains them, every 'interval' timesteps (0 disables).  Cells are ordered
+    // z-y-x lexicographically (the grid variable layout) or along a Morton curve.
+    void setCellSort( int interval, bool morton ) {
+      m_cell_sort_interval = interval;
+      m_cell_sort_morton   = morton;
+    }
+
+    //////////
+    // Look for particles that left a patch only near its faces.  A full scan
+    // bins every particle by its distance from the patch faces in whole cells;
+    // the k-th relocation after it only examines particles fewer than k cells
+    // in, and every 'interval'-th relocation is a full scan again.  Only valid
+    // if no particle moves a whole cell in one timestep (0 or 1 disables).
+    void setShellScan( int interval ) { m_shell_interval = interval; }
+
 
   private:
 
@@ -140,6 +161,35 @@ class Relocate {
    
     void finalizeCommunication();
 
+    bool cellSortThisTimeStep() const;
+
+    ParticleSubset* cellSortOrder( const Patch          * patch,
+                                   int                    matl,
+                                   ParticleVariableBase * posvar ) const;
+
+    // Shell scan state of one patch/material, left by the last relocation
+    struct ShellScan {
+      int                                      timestep{ -1 };
+      int                                      step{ 0 };          // relocations since the full scan
+      unsigned int                             numParticles{ 0 };
+      std::vector<std::vector<particleIndex> > bands;              // [m]: particles m cells inside
+    };
+
+    // What the first pass of relocateParticlesModifies learned about one patch/material
+    struct ShellPass {
+      bool                                     track{ false };
+      int                                      step{ 0 };
+      std::vector<particleIndex>               removed;            // deleted or left, sorted
+      std::vector<std::vector<particleIndex> > bands;              // numbered as before the relocation
+    };
+
+    void updateShellScan( const Patch  * patch,
+                          int            matl,
+                          ShellPass    & pass,
+                          unsigned int   numKept,
+                          unsigned int   numParticles,
+                          bool           reordered );
+
     const VarLabel                             * reloc_old_posLabel{ nullptr };
     std::vector<std::vector<const VarLabel*> >   reloc_old_labels;
     const VarLabel                             * reloc_new_posLabel{ nullptr };
@@ -147,6 +197,11 @@ class Relocate {
     const VarLabel                             * particleIDLabel_{   nullptr };
     const MaterialSet                          * reloc_matls{        nullptr };
     LoadBalancer                               * m_lb{               nullptr };
+    Scheduler                                  * m_sched{            nullptr };
+    int                                          m_cell_sort_interval{ 0 };
+    bool                                         m_cell_sort_morton{   false };
+    int                                          m_shell_interval{     0 };
+    std::map<std::pair<int, int>, ShellScan>     m_shell_scans;    // (patch ID, matl)
     std::vector<char*>                          recvbuffers;
     std::vector<char*>                          sendbuffers;
     std::vector<MPI_Request>                    sendrequests;
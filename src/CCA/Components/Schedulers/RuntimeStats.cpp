@@ -24,9 +24,11 @@
 
 #include <CCA/Components/Schedulers/RuntimeStats.hpp>
 #include <CCA/Components/Schedulers/DetailedTasks.h>
+#include <CCA/Components/Schedulers/NUMAPlacement.h>
 #include <CCA/Components/Schedulers/TaskGraph.h>
 
 #include <Core/Parallel/MasterLock.h>
+#include <Core/Parallel/PackBufferInfo.h>
 #include <Core/Util/DOUT.hpp>
 
 #include <algorithm>
@@ -77,6 +79,9 @@ namespace {
   // [Dout][value_name] = ReportValue
   std::map< Dout, std::map< std::string, ReportValue> > g_report_values;
 
+  // [Dout][name] = (part, rest) value names, see register_percentage
+  std::map< Dout, std::map< std::string, std::pair<std::string, std::string> > > g_report_percentages;
+
   size_t g_num_tasks;
   std::vector< std::string > g_task_names;
   std::unique_ptr< std::atomic<int64_t>[] > g_task_exec_times{nullptr};
@@ -106,6 +111,18 @@ void RuntimeStats::register_report( Dout const& dout
   }
 }
 
+void RuntimeStats::register_percentage( Dout const& dout
+                                      , std::string const& name
+                                      , std::string const& part
+                                      , std::string const& rest
+                                      )
+{
+  if (mpi_stats || exec_times || wait_times || task_stats) {
+    std::unique_lock<Uintah::MasterLock> lock(g_report_lock);
+    g_report_percentages[dout][name] = std::make_pair(part, rest);
+  }
+}
+
 
 std::atomic<int64_t> * RuntimeStats::get_atomic_exec_ptr( DetailedTask const* t)
 {
@@ -489,6 +506,46 @@ void RuntimeStats::report( MPI_Comm comm )
                    , []() { return ExecTimer::max(); }
                    , []() { ExecTimer::reset_tag(); }
                    );
+    register_report( task_stats
+                   , "Pack"
+                   , RuntimeStats::Time
+                   , []() { return PackBufferInfo::PackTimer::max(); }
+                   , []() { PackBufferInfo::PackTimer::reset_tag(); }
+                   );
+    register_report( task_stats
+                   , "Unpack"
+                   , RuntimeStats::Time
+                   , []() { return PackBufferInfo::UnpackTimer::max(); }
+                   , []() { PackBufferInfo::UnpackTimer::reset_tag(); }
+                   );
+    register_report( task_stats
+                   , "Packed"
+                   , RuntimeStats::Memory
+                   , []() { return PackBufferInfo::packedBytes(); }
+                   , []() { PackBufferInfo::resetPackedBytes(); }
+                   );
+
+    if (NUMAPlacement::isEnabled()) {
+      // patch task executions by a thread on the NUMA node of the patch's data, and on
+      // another node; these count executions by the thread's node, not memory accesses
+      register_report( task_stats
+                     , "NUMA Local"
+                     , RuntimeStats::Count
+                     , []() { return NUMAPlacement::getLocalCount(); }
+                     , []() { NUMAPlacement::resetLocalCount(); }
+                     );
+      register_report( task_stats
+                     , "NUMA Remote"
+                     , RuntimeStats::Count
+                     , []() { return NUMAPlacement::getRemoteCount(); }
+                     , []() { NUMAPlacement::resetRemoteCount(); }
+                     );
+      register_percentage( task_stats
+                         , "NUMA Remote %"
+                         , "NUMA Remote"
+                         , "NUMA Local"
+                         );
+    }
   }
 
   std::unique_lock<Uintah::MasterLock> lock(g_report_lock);
@@ -592,11 +649,19 @@ void RuntimeStats::report( MPI_Comm comm )
     printf("\n________________________________________________________________________________");
     for (auto const& group : g_report_values) {
 
+      auto const percentages = g_report_percentages.find(group.first);
+
       int w_desc = 14;
       for (auto const& value : group.second ) {
         const int s = static_cast<int>(value.first.size()) + 1;
         w_desc = s < w_desc ? w_desc : s;
       }
+      if (percentages != g_report_percentages.end()) {
+        for (auto const& percentage : percentages->second) {
+          const int s = static_cast<int>(percentage.first.size()) + 1;
+          w_desc = s < w_desc ? w_desc : s;
+        }
+      }
 
       const std::string & group_name = group.first.name() +
                                        (group.first.active() ? ":+" : ":-");
@@ -652,6 +717,27 @@ void RuntimeStats::report( MPI_Comm comm )
               );
         }
       }
+
+      // from the totals over all ranks
+      if (percentages != g_report_percentages.end()) {
+        for (auto const& percentage : percentages->second) {
+          auto const part = group.second.find(percentage.second.first);
+          auto const rest = group.second.find(percentage.second.second);
+          if (part == group.second.end() || rest == group.second.end()) {
+            continue;
+          }
+
+          const int64_t part_total = global_data[4 * part->second.m_index + SUM];
+          const int64_t total      = part_total + global_data[4 * rest->second.m_index + SUM];
+
+          if (total > 0) {
+            printf("%*s:%*.1f\n"
+                , w_desc-1, percentage.first.c_str()
+                , w_num, (100.0 * part_total) / total
+                );
+          }
+        }
+      }
     }
 
     printf("\n");
@@ -659,6 +745,7 @@ void RuntimeStats::report( MPI_Comm comm )
 
   // clear the registered report values
   g_report_values.clear();
+  g_report_percentages.clear();
 }
 
 } // namespace Uintah
@@ -62,6 +62,14 @@ public:
                              , std::function<void()> clear_value = [](){}
                              );
 
+  // Reports 100 * part / (part + rest) of the totals over all ranks of the values
+  // 'part' and 'rest', registered with register_report in the same group.
+  static void register_percentage( Dout const& dout
+                                 , std::string const & name
+                                 , std::string const & part
+                                 , std::string const & rest
+                                 );
+
   // used to declare timers
   template <typename Tag> using TripTimer = Timers::ThreadTrip< Tag >;
 
@@ -25,6 +25,8 @@
 #include <CCA/Components/Schedulers/SchedulerCommon.h>
 
 #include <CCA/Components/Schedulers/DetailedTasks.h>
+#include <CCA/Components/Schedulers/MemoryLog.h>
+#include <CCA/Components/Schedulers/NUMAPlacement.h>
 #include <CCA/Components/Schedulers/OnDemandDataWarehouse.h>
 #include <CCA/Components/Schedulers/OnDemandDataWarehouseP.h>
 #include <CCA/Components/Schedulers/TaskGraph.h>
@@ -39,6 +41,7 @@
 #include <Core/Exceptions/ProblemSetupException.h>
 #include <Core/Grid/Patch.h>
 #include <Core/Grid/Task.h>
+#include <Core/Grid/Variables/HostMemoryPool.h>
 #include <Core/Grid/Variables/LocallyComputedPatchVarMap.h>
 #include <Core/Grid/Variables/PerPatch.h>
 #include <Core/Grid/Variables/CellIterator.h>
@@ -344,6 +347,40 @@ SchedulerCommon::finalizeNodes( int process /* = 0 */ )
   m_graph_nodes = nullptr;
 }
 
+//______________________________________________________________________
+//
+namespace {
+
+// reads <strategy> and <tile_size> of a <LoopTiling> or <LoopTiling><task> block,
+// leaving whatever is not specified as it was
+void
+parseLoopTiling(       ProblemSpecP   ps
+               ,       LoopTiling   & tiling
+               )
+{
+  std::string strategy;
+  if (ps->get("strategy", strategy) != nullptr) {
+    if (strategy == "tiled") {
+      tiling.strategy = LoopTiling::Tiled;
+    }
+    else if (strategy == "flat") {
+      tiling.strategy = LoopTiling::Flat;
+    }
+    else {
+      throw ProblemSetupException("Unknown LoopTiling strategy '" + strategy + "', expected 'flat' or 'tiled'", __FILE__, __LINE__);
+    }
+  }
+
+  IntVector tile;
+  if (ps->get("tile_size", tile) != nullptr) {
+    for (int d = 0; d < 3; ++d) {
+      tiling.tile[d] = tile[d];
+    }
+  }
+}
+
+}
+
 //______________________________________________________________________
 //
 void
@@ -366,6 +403,80 @@ SchedulerCommon::problemSetup( const ProblemSpecP     & prob_spec
       proc0cout << "Using large, combined MPI messages\n";
     }
 
+    params->getWithDefault("packed_messages", m_use_packing, true);
+
+    if (m_use_packing) {
+      proc0cout << "Using packed MPI messages\n";
+    }
+    else {
+      proc0cout << "Using MPI derived datatypes for messages (no packing)\n";
+    }
+
+    params->getWithDefault("halo_padded_allocation", OnDemandDataWarehouse::s_halo_padded_allocation, false);
+
+    if (OnDemandDataWarehouse::s_halo_padded_allocation) {
+      proc0cout << "Allocating grid variables with the largest ghost region required by any task\n";
+    }
+
+    params->getWithDefault("ghost_gather_cache", OnDemandDataWarehouse::s_use_ghost_cache, false);
+
+    if (OnDemandDataWarehouse::s_use_ghost_cache) {
+      proc0cout << "Caching assembled ghost cell windows in the data warehouse\n";
+    }
+
+    bool use_host_memory_pool = false;
+    params->getWithDefault("host_memory_pool", use_host_memory_pool, false);
+    HostMemoryPool::setEnabled(use_host_memory_pool);
+
+    if (use_host_memory_pool) {
+      proc0cout << "Recycling host grid and particle variable storage through the host memory pool\n";
+    }
+
+    bool use_numa_placement = false;
+    params->getWithDefault("numa_placement", use_numa_placement, false);
+
+    if (use_numa_placement) {
+      NUMAPlacement::initialize(Parallel::getNumPartitions());
+      if (NUMAPlacement::isEnabled()) {
+        proc0cout << "Placing patch variables on the NUMA node of their partition (" << NUMAPlacement::getNumNodes() << " nodes, "
+                  << Parallel::getNumPartitions() << " partitions)\n";
+      }
+      else {
+        proc0cout << "NUMA placement requested, but it needs more than one NUMA node and more than one partition, not enabled\n";
+      }
+    }
+
+    params->getWithDefault("persistent_comm_plans", m_use_persistent_comm, false);
+
+    if (m_use_persistent_comm) {
+      if (!m_use_packing) {
+        throw ProblemSetupException("persistent_comm_plans requires packed_messages", __FILE__, __LINE__);
+      }
+      proc0cout << "Using persistent MPI communication plans (rebuilt when the task graph is recompiled)\n";
+    }
+
+    ProblemSpecP tiling = params->findBlock("LoopTiling");
+    if (tiling) {
+      LoopTiling defaultTiling = Task::getDefaultLoopTiling();
+      parseLoopTiling(tiling, defaultTiling);
+      Task::setDefaultLoopTiling(defaultTiling);
+
+      proc0cout << "Default OpenMP loop execution: " << ((defaultTiling.strategy == LoopTiling::Tiled) ? "tiled" : "flat");
+      if (defaultTiling.strategy == LoopTiling::Tiled) {
+        proc0cout << ", tile size " << IntVector(defaultTiling.tile[0], defaultTiling.tile[1], defaultTiling.tile[2]);
+      }
+      proc0cout << "\n";
+
+      for (ProblemSpecP task = tiling->findBlock("task"); task != nullptr; task = task->findNextBlock("task")) {
+        std::string name;
+        task->getAttribute("name", name);
+        LoopTiling taskTiling = defaultTiling;
+        parseLoopTiling(task, taskTiling);
+        m_task_loop_tiling[name] = taskTiling;
+        proc0cout << "--  OpenMP loop execution for task " << name << ": " << ((taskTiling.strategy == LoopTiling::Tiled) ? "tiled" : "flat") << "\n";
+      }
+    }
+
     ProblemSpecP track = params->findBlock("VarTracker");
     if (track) {
       track->require("start_time", m_tracking_start_time);
@@ -896,6 +1007,23 @@ SchedulerCommon::addTask(       Task        * task
     }
   }
 
+  // Store max ghost cell count for each variable across all host tasks so allocateAndPut can allocate the final halo up front.
+  // Same rules as the device version above: skip the RMCRT task graph and SHRT_MAX (distal) requirements.
+  if (OnDemandDataWarehouse::s_halo_padded_allocation && tg_num != 1) {
+    for (auto dep = task->getModifies(); dep != nullptr; dep = dep->m_next) {
+      if (dep->m_num_ghost_cells != SHRT_MAX && dep->m_num_ghost_cells > dep->m_var->getMaxHostGhost()) {
+        dep->m_var->setMaxHostGhost(dep->m_num_ghost_cells);
+        dep->m_var->setMaxHostGhostType(dep->m_gtype);
+      }
+    }
+    for (auto dep = task->getRequires(); dep != nullptr; dep = dep->m_next) {
+      if (dep->m_num_ghost_cells != SHRT_MAX && dep->m_num_ghost_cells > dep->m_var->getMaxHostGhost()) {
+        dep->m_var->setMaxHostGhost(dep->m_num_ghost_cells);
+        dep->m_var->setMaxHostGhostType(dep->m_gtype);
+      }
+    }
+  }
+
   //return without actually adding tasks to the taskgraph if its a ghost cells collection phase. Set in AMRSimulationController
   if(m_max_ghost_cell_collection_phase){
     //ideally task should be deleted for max ghost cell collection phase, but encountered double free error. So
@@ -929,6 +1057,14 @@ SchedulerCommon::addTask(       Task        * task
 
 
 
+  // Per-task loop execution from the input file
+  if (!m_task_loop_tiling.empty()) {
+    auto iter = m_task_loop_tiling.find(task->getName());
+    if (iter != m_task_loop_tiling.end()) {
+      task->setLoopTiling(iter->second);
+    }
+  }
+
   // Save the DW map
   task->setMapping(m_dwmap);
 
@@ -1243,6 +1379,12 @@ SchedulerCommon::advanceDataWarehouse( const GridP & grid
 
   ASSERT(m_dws.size() >= 2);
 
+  // Buffers that sat in the pool for the whole last timestep are not coming back, release them
+  // before the oldest DW goes away and refills the pool.
+  if (HostMemoryPool::isEnabled()) {
+    HostMemoryPool::releaseUnused();
+  }
+
   // TODO: This can cost roughly 1 millisecond of time.  Find a way to reuse data warehouses if possible?  Brad March 6 2018
   // The last becomes last old, and the rest are new
   m_dws[m_num_old_dws - 1] = m_dws[m_dws.size() - 1];
@@ -1398,6 +1540,13 @@ SchedulerCommon::logMemoryUse()
     }
   }
 
+  if (HostMemoryPool::isEnabled()) {
+    std::ostringstream elems;
+    elems << "hits=" << HostMemoryPool::getHits() << " misses=" << HostMemoryPool::getMisses()
+          << " in_use=" << HostMemoryPool::getBytesInUse() << " high_water=" << HostMemoryPool::getHighWater();
+    logMemory(*m_mem_logfile, total, "HostMemoryPool", "cached", "buffers", nullptr, -1, elems.str(), HostMemoryPool::getBytesCached(), 0);
+  }
+
   *m_mem_logfile << "Total: " << total << '\n';
   m_mem_logfile->flush();
 }
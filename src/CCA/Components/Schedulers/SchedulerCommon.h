@@ -157,6 +157,10 @@ class SchedulerCommon : public Scheduler, public UintahParallelComponent {
 
     virtual bool useSmallMessages() { return m_use_small_messages; }
 
+    virtual bool usePacking() { return m_use_packing; }
+
+    virtual bool usePersistentComm() { return m_use_persistent_comm; }
+
     /// Get all of the requires needed from the old data warehouse (carried forward).
     virtual const std::vector<const Task::Dependency*>&         getInitialRequires()     const { return m_init_requires; }
     virtual const std::set<const VarLabel*, VarLabel::Compare>& getInitialRequiredVars() const { return m_init_required_vars; }
@@ -247,6 +251,9 @@ class SchedulerCommon : public Scheduler, public UintahParallelComponent {
 
     virtual void setPositionVar( const VarLabel* posLabel ) { m_reloc_new_pos_label = posLabel; }
 
+    virtual void setParticleCellSort( int interval, bool morton ) { m_relocate_1.setCellSort( interval, morton ); }
+    virtual void setParticleShellScan( int interval ) { m_relocate_1.setShellScan( interval ); }
+
     virtual void scheduleAndDoDataCopy( const GridP & grid );
 
     // Clear the recorded task monitoring attribute values.
@@ -275,6 +282,10 @@ class SchedulerCommon : public Scheduler, public UintahParallelComponent {
 
     const std::set<std::string>& getNoScrubVars() { return m_no_scrub_vars;}
 
+    virtual void setTimeStepNoScrubVars( const std::set<std::string> & vars ) { m_time_step_no_scrub_vars = vars; }
+
+    const std::set<std::string>& getTimeStepNoScrubVars() { return m_time_step_no_scrub_vars;}
+
     const std::set<std::string>& getCopyDataVars() { return m_copy_data_vars;}
 
     const std::set<std::string>& getNotCopyDataVars() { return m_no_copy_data_vars;}
@@ -388,6 +399,9 @@ class SchedulerCommon : public Scheduler, public UintahParallelComponent {
     // vars manually set not to scrub (normally when needed between a normal taskgraph and the regridding phase)
     std::set<std::string> m_no_scrub_vars;
 
+    // vars not to scrub on the current time step only (e.g. output that is written after the time step)
+    std::set<std::string> m_time_step_no_scrub_vars;
+
     // treat variable as an "old" var - will be checkpointed, copied, and only scrubbed from an OldDW
     std::set<std::string> m_treat_as_old_vars;
 
@@ -422,6 +436,18 @@ class SchedulerCommon : public Scheduler, public UintahParallelComponent {
     // whether or not to send a small message (takes more work to organize)
     // or a larger one (more communication time)
     bool m_use_small_messages{true};
+
+    // whether or not to pack messages into a contiguous buffer (PackBufferInfo)
+    // or to send straight from the variables with MPI derived datatypes (BufferInfo)
+    bool m_use_packing{true};
+
+    // whether or not to replay persistent MPI requests (MPI_Send_init/MPI_Recv_init)
+    // bound to per-batch packed buffers instead of posting new ones each timestep
+    bool m_use_persistent_comm{false};
+
+    // per-task loop execution settings from the <LoopTiling> input block, applied in addTask
+    std::map<std::string, LoopTiling> m_task_loop_tiling;
+
     bool m_emit_task_graph{false};
     int  m_num_task_graphs{1};
     int  m_num_tasks{0};
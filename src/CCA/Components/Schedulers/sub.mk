@@ -39,6 +39,7 @@ SRCS += \
         $(SRCDIR)/KokkosOpenMPScheduler.cc    \
         $(SRCDIR)/MemoryLog.cc                \
         $(SRCDIR)/MPIScheduler.cc             \
+        $(SRCDIR)/NUMAPlacement.cc            \
         $(SRCDIR)/OnDemandDataWarehouse.cc    \
         $(SRCDIR)/Relocate.cc                 \
         $(SRCDIR)/RuntimeStats.cc             \
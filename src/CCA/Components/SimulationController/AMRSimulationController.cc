@@ -37,6 +37,7 @@
 #include <Core/Grid/Level.h>
 #include <Core/Grid/Patch.h>
 #include <Core/Grid/MaterialManager.h>
+#include <Core/Grid/Variables/GridVariableBase.h>
 #include <Core/OS/ProcessInfo.h>
 #include <Core/Parallel/Parallel.h>
 #include <Core/Parallel/ProcessorGroup.h>
@@ -777,6 +778,9 @@ AMRSimulationController::doRegridding( bool initialTimeStep )
   if (m_current_gridP != oldGrid) {
 
     m_application->setRegridTimeStep( true );
+
+    // the old grid's window shapes are unlikely to come back
+    GridVariableBase::freeMPIWindowTypes();
      
     m_loadBalancer->possiblyDynamicallyReallocate(m_current_gridP, lbstate);
 
@@ -100,6 +100,7 @@ WARNING
     friend class KokkosScheduler;
     friend class UnifiedScheduler;
     friend class DetailedTasks;
+    friend class Relocate;
 
     friend class LoadBalancersCommon;
     friend class DynamicLoadBalancer;
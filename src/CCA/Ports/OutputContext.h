@@ -27,6 +27,8 @@
 
 #include <Core/ProblemSpec/ProblemSpec.h>
 
+#include <string>
+
 namespace Uintah {
    /**************************************
      
@@ -69,6 +71,9 @@ namespace Uintah {
       long cur;
       ProblemSpecP varnode;
       bool outputDoubleAsFloat;
+      // When set, emit appends to this buffer instead of writing to fd;
+      // cur still advances as if the bytes had been written.
+      std::string* buffer {nullptr};
    private:
       OutputContext(const OutputContext&);
       OutputContext& operator=(const OutputContext&);
@@ -172,6 +172,13 @@ class Scheduler : public UintahParallelPort {
 //        protected:
 
     virtual void setPositionVar( const VarLabel * posLabel ) = 0;
+
+    // Reorder the relocated particles by cell every 'interval' timesteps (0 = never)
+    virtual void setParticleCellSort( int interval, bool morton ) = 0;
+
+    // Only examine particles near the patch faces for relocation, with a full
+    // scan every 'interval' timesteps (0 = always scan every particle)
+    virtual void setParticleShellScan( int interval ) = 0;
     
     using VarLabelList = std::vector<std::vector<const VarLabel*> >;
     virtual void scheduleParticleRelocation( const LevelP       & coarsestLevelwithParticles
@@ -217,6 +224,9 @@ class Scheduler : public UintahParallelPort {
                                          ,       bool          noCheckpoint
                                          ) = 0;
 
+    // Variables not to scrub during the next time step(s) only; replaces the previous set.
+    virtual void setTimeStepNoScrubVars( const std::set<std::string> & vars ) = 0;
+
     // Get the SuperPatch (set of connected patches making a larger rectangle)
     // for the given label and patch and find the largest extents encompassing
     // the expected ghost cells (requiredLow, requiredHigh) and the requested
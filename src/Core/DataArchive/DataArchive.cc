@@ -52,6 +52,7 @@
 
 #include <libxml/xmlreader.h>
 
+#include <cstring>
 #include <iostream>
 #include <sstream>
 
@@ -60,6 +61,7 @@
 #include <fcntl.h>
 
 #include <sys/param.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 using namespace std;
@@ -1117,8 +1119,8 @@ DataArchive::query(       Variable     & var,
     // If this is a virtual patch, grab the real patch, but only do that here - in the next query, we want
     // the data to be returned in the virtual coordinate space.
 
-    vector<VarnameMatlPatch>::iterator iter = std::find( timedata.d_datafileInfoIndex.begin(), timedata.d_datafileInfoIndex.end(), VarnameMatlPatch(name, matlIndex, patchid ) );
-    if( iter == timedata.d_datafileInfoIndex.end() ) { // Previously used the hashmap lookup( timedata.d_datafileInfo.lookup() )
+    dfi = timedata.findDatafileInfo( VarnameMatlPatch( name, matlIndex, patchid ) );
+    if( dfi == nullptr ) {
       cerr << "VARIABLE NOT FOUND: " << name 
            << ", material index " << matlIndex 
            << ", Level " << patch->getLevel()->getIndex() 
@@ -1127,9 +1129,6 @@ DataArchive::query(       Variable     & var,
 
       throw InternalError("DataArchive::query:Variable not found", __FILE__, __LINE__);
     }
-    
-    int pos = std::distance( timedata.d_datafileInfoIndex.begin(), iter );
-    dfi = &timedata.d_datafileInfoValue[ pos ];
   }
 
   const TypeDescription* td = var.virtualGetTypeDescription();
@@ -2090,13 +2089,28 @@ DataArchive::TimeData::init()
         }
 
         if( level >= d_xmlFilenames.size() ) {
-          d_xmlFilenames.resize( level +1 );
-          d_xmlParsed.resize(    level + 1 );
+          d_xmlFilenames.resize(  level +1 );
+          d_xmlParsed.resize(     level + 1 );
+          d_xmlFileOfProc.resize( level + 1 );
         }
 
         string filename = d_ts_directory + datafile;
         d_xmlFilenames[ level ].push_back( filename );
         d_xmlParsed[    level ].push_back( false );
+
+        const int fileIndex = d_xmlFilenames[ level ].size() - 1;
+
+        if( proc != "" ) {
+          d_xmlFileOfProc[ level ][ atoi( proc.c_str() ) ] = fileIndex;
+        }
+
+        const string ranks = attributes[ "ranks" ];
+        if( ranks != "" ) {
+          ConsecutiveRangeSet ranksInFile( ranks );
+          for( ConsecutiveRangeSet::iterator rank = ranksInFile.begin(); rank != ranksInFile.end(); ++rank ) {
+            d_xmlFileOfProc[ level ][ *rank ] = fileIndex;
+          }
+        }
       }
     }
     else {
@@ -2120,11 +2134,13 @@ DataArchive::TimeData::purgeCache()
 
   d_datafileInfoIndex.clear();
   d_datafileInfoValue.clear();
+  d_datafileInfoPos.clear();
   
   d_patchInfo.clear();
   d_varInfo.clear();
   d_xmlFilenames.clear();
   d_xmlParsed.clear();
+  d_xmlFileOfProc.clear();
   d_initialized = false;
 }
 
@@ -2133,6 +2149,10 @@ DataArchive::TimeData::purgeCache()
 void
 DataArchive::TimeData::parseFile( const string & filename, int levelNum, int basePatch )
 {
+  if( parseIndexFile( filename, levelNum, basePatch ) ) {
+    return;
+  }
+
   // Parse the file.
   ProblemSpecP top = ProblemSpecReader().readInputFile( filename );
 
@@ -2156,14 +2176,6 @@ DataArchive::TimeData::parseFile( const string & filename, int levelNum, int bas
         throw InternalError( "Cannot get index", __FILE__, __LINE__ );
       }
 
-      if( addMaterials ) {
-        // Record that the material exists.  index+1 to use matl -1
-        if (index+1 >= (int)d_matlInfo[levelNum].size()) {
-          d_matlInfo[ levelNum ].resize( index + 2 );
-        }
-        d_matlInfo[ levelNum ][ index ] = true;
-      }
-
       map<string,string> attributes;
       vnode->getAttributes(attributes);
 
@@ -2193,58 +2205,201 @@ DataArchive::TimeData::parseFile( const string & filename, int levelNum, int bas
       vnode->get( "boundaryLayer", boundary );
       vnode->get( "numParticles", numParticles );
 
-      if( d_varInfo.find(varname) == d_varInfo.end() ) {
-        VarData& varinfo      = d_varInfo[varname];
-        varinfo.type          = type;
-        varinfo.compression   = compressionMode;
-        varinfo.boundaryLayer = boundary;
-        varinfo.filename      = filename;
-      }
-      else if (compressionMode != "") {
-        // For particles variables of size 0, the uda doesn't say it
-        // has a compressionMode...  (FYI, why is this?  Because it is
-        // ambiguous... if there is no data, is it compressed?)
-        //
-        // To the best of my understanding, we only look at the variables stats
-        // the first time we encounter it... even if there are multiple materials.
-        // So we run into a problem is the variable has 0 data the first time it
-        // is looked at... The problem there is that it doesn't mark it as being
-        // compressed, and therefore the next time we see that variable (eg, in
-        // another material) we (used to) assume it was not compressed... the
-        // following lines compenstate for this problem:
-        VarData& varinfo = d_varInfo[varname];
-        varinfo.compression = compressionMode;
-      }
+      addVariable( varname, index, patchid, type, compressionMode, filename, boundary,
+                   start, end, numParticles, levelNum, basePatch, addMaterials );
+    }
+    else if( vnode->getNodeType() != ProblemSpec::TEXT_NODE ) {
+      cerr << "WARNING: Unknown element in Variables section: " << vnode->getNodeName() << '\n';
+    }
+  }
+} // end TimeData::parseFile()
 
-      if (levelNum == -1) { // global file (reduction vars)
-        d_globaldata = filename;
-      }
-      else {
-        ASSERTRANGE( patchid-basePatch, 0, (int)d_patchInfo[levelNum].size() );
+//______________________________________________________________________
+// Reads the pNNNNN.idx next to the pNNNNN.xml 'filename' in one read
+// call. See DataArchive::INDEX_MAGIC_NUMBER for the layout.
+bool
+DataArchive::TimeData::parseIndexFile( const string & filename, int levelNum, int basePatch )
+{
+  const string::size_type suffix = filename.rfind( ".xml" );
+  if( suffix == string::npos || suffix + 4 != filename.size() ) {
+    return false;
+  }
+  const string indexFilename = filename.substr( 0, suffix ) + ".idx";
 
-        PatchData& patchinfo = d_patchInfo[levelNum][patchid-basePatch];
-        if (!patchinfo.parsed) {
-          patchinfo.parsed = true;
-          patchinfo.datafilename = filename;
-        }
-      }
-      VarnameMatlPatch vmp(varname, index, patchid);
-      DataFileInfo     dummy;
+  int fd = open( indexFilename.c_str(), O_RDONLY );
+  if( fd == -1 ) {
+    return false;
+  }
 
-      if( std::find( d_datafileInfoIndex.begin(), d_datafileInfoIndex.end(), vmp ) != d_datafileInfoIndex.end() ) {
-        // cerr << "Duplicate variable name: " << name << endl;
-      }
-      else {
-        DataFileInfo dfi( start, end, numParticles );
-        d_datafileInfoIndex.push_back( vmp );
-        d_datafileInfoValue.push_back( dfi );
+  vector<char> buffer;
+  struct stat st;
+  struct stat xmlSt;
+
+  if( fstat( fd, &st ) == 0 ) {
+
+    // An index older than the xml is left from an earlier output (e.g.
+    // one run with <binaryIndex> that was overwritten without it).
+    if( stat( filename.c_str(), &xmlSt ) == 0 && st.st_mtime < xmlSt.st_mtime ) {
+      close( fd );
+      return false;
+    }
+
+    buffer.resize( st.st_size );
+
+    size_t have = 0;
+    while( have < buffer.size() ) {
+      ssize_t s = read( fd, &buffer[ have ], buffer.size() - have );
+      if( s <= 0 ) {
+        break;
       }
+      have += s;
     }
-    else if( vnode->getNodeType() != ProblemSpec::TEXT_NODE ) {
-      cerr << "WARNING: Unknown element in Variables section: " << vnode->getNodeName() << '\n';
+    buffer.resize( have );
+  }
+  close( fd );
+
+  // Anything unexpected (another byte order, a newer version, a
+  // truncated file) means the xml is parsed instead.
+  size_t pos = 0;
+  auto getUInt = [&]( unsigned int & value ) {
+    if( buffer.size() - pos < sizeof(value) ) {
+      return false;
+    }
+    memcpy( &value, &buffer[ pos ], sizeof(value) );
+    pos += sizeof(value);
+    return true;
+  };
+
+  unsigned int magic, version, numStrings, numEntries;
+
+  if( !getUInt( magic ) || magic != INDEX_MAGIC_NUMBER || !getUInt( version ) || version != INDEX_VERSION ||
+      !getUInt( numStrings ) ) {
+    return false;
+  }
+
+  vector<string> strings( numStrings );
+  for( unsigned int i = 0; i < numStrings; ++i ) {
+    unsigned int length;
+    if( !getUInt( length ) || buffer.size() - pos < length ) {
+      return false;
     }
+    strings[ i ].assign( &buffer[ pos ], length );
+    pos += length;
   }
-} // end TimeData::parseFile()
+
+  if( !getUInt( numEntries ) || ( buffer.size() - pos ) / sizeof(IndexEntry) < numEntries ) {
+    return false;
+  }
+
+  auto validString = [&]( int index ) { return index >= 0 && index < (int) numStrings; };
+
+  // Materials are the same for all patches on a level - only parse them from one file.
+  bool addMaterials = levelNum >= 0 && d_matlInfo[levelNum].size() == 0;
+
+  for( unsigned int i = 0; i < numEntries; ++i ) {
+    IndexEntry entry;
+    memcpy( &entry, &buffer[ pos + i * sizeof(IndexEntry) ], sizeof(IndexEntry) );
+
+    if( !validString( entry.variable ) || !validString( entry.type ) || !validString( entry.filename ) ||
+        ( entry.compression != -1 && !validString( entry.compression ) ) ) {
+      throw InternalError( "DataArchive::parseIndexFile: Corrupt index " + indexFilename, __FILE__, __LINE__ );
+    }
+
+    addVariable( strings[ entry.variable ], entry.matl, entry.patch, strings[ entry.type ],
+                 entry.compression == -1 ? "" : strings[ entry.compression ], strings[ entry.filename ],
+                 IntVector( entry.boundaryLayer[0], entry.boundaryLayer[1], entry.boundaryLayer[2] ),
+                 entry.start, entry.end, entry.numParticles, levelNum, basePatch, addMaterials );
+  }
+
+  return true;
+} // end TimeData::parseIndexFile()
+
+//______________________________________________________________________
+//
+void
+DataArchive::TimeData::addVariable( const string    & varname,
+                                    int               index,
+                                    int               patchid,
+                                    const string    & type,
+                                    const string    & compressionMode,
+                                    const string    & filename,
+                                    const IntVector & boundary,
+                                    long              start,
+                                    long              end,
+                                    int               numParticles,
+                                    int               levelNum,
+                                    int               basePatch,
+                                    bool              addMaterials )
+{
+  if( addMaterials ) {
+    // Record that the material exists.  index+1 to use matl -1
+    if (index+1 >= (int)d_matlInfo[levelNum].size()) {
+      d_matlInfo[ levelNum ].resize( index + 2 );
+    }
+    d_matlInfo[ levelNum ][ index ] = true;
+  }
+
+  if( d_varInfo.find(varname) == d_varInfo.end() ) {
+    VarData& varinfo      = d_varInfo[varname];
+    varinfo.type          = type;
+    varinfo.compression   = compressionMode;
+    varinfo.boundaryLayer = boundary;
+    varinfo.filename      = filename;
+  }
+  else if (compressionMode != "") {
+    // For particles variables of size 0, the uda doesn't say it
+    // has a compressionMode...  (FYI, why is this?  Because it is
+    // ambiguous... if there is no data, is it compressed?)
+    //
+    // To the best of my understanding, we only look at the variables stats
+    // the first time we encounter it... even if there are multiple materials.
+    // So we run into a problem is the variable has 0 data the first time it
+    // is looked at... The problem there is that it doesn't mark it as being
+    // compressed, and therefore the next time we see that variable (eg, in
+    // another material) we (used to) assume it was not compressed... the
+    // following lines compenstate for this problem:
+    VarData& varinfo = d_varInfo[varname];
+    varinfo.compression = compressionMode;
+  }
+
+  if (levelNum == -1) { // global file (reduction vars)
+    d_globaldata = filename;
+  }
+  else {
+    ASSERTRANGE( patchid-basePatch, 0, (int)d_patchInfo[levelNum].size() );
+
+    PatchData& patchinfo = d_patchInfo[levelNum][patchid-basePatch];
+    if (!patchinfo.parsed) {
+      patchinfo.parsed = true;
+      patchinfo.datafilename = filename;
+    }
+  }
+  VarnameMatlPatch vmp(varname, index, patchid);
+
+  if( d_datafileInfoPos.find( vmp ) != d_datafileInfoPos.end() ) {
+    // cerr << "Duplicate variable name: " << name << endl;
+  }
+  else {
+    DataFileInfo dfi( start, end, numParticles );
+    d_datafileInfoPos[ vmp ] = d_datafileInfoIndex.size();
+    d_datafileInfoIndex.push_back( vmp );
+    d_datafileInfoValue.push_back( dfi );
+  }
+} // end TimeData::addVariable()
+
+//______________________________________________________________________
+//
+DataArchive::DataFileInfo *
+DataArchive::TimeData::findDatafileInfo( const VarnameMatlPatch & vmp )
+{
+  auto iter = d_datafileInfoPos.find( vmp );
+  if( iter == d_datafileInfoPos.end() ) {
+    return nullptr;
+  }
+  return &d_datafileInfoValue[ iter->second ];
+}
+
+
 
 //______________________________________________________________________
 //
@@ -2281,9 +2436,14 @@ DataArchive::TimeData::parsePatch( const Patch * patch )
   // If this is a newer uda, the patch info in the grid will store the
   // processor where the data is.
   if( patchinfo.proc != -1 ) {
-    ostringstream file;
-    file << d_ts_directory << "l" << (int) real_patch->getLevel()->getIndex() << "/p" << setw(5) << setfill('0') << (int) patchinfo.proc << ".xml";
-    parseFile( file.str(), levelIndex, levelBasePatchID );
+    // With aggregated output (<outputAggregation>) this is the file
+    // of the rank's aggregator.
+    unordered_map<int, int>::const_iterator listed = d_xmlFileOfProc[levelIndex].find( patchinfo.proc );
+
+    if( listed != d_xmlFileOfProc[levelIndex].end() && !d_xmlParsed[levelIndex][ listed->second ] ) {
+      parseFile( d_xmlFilenames[levelIndex][ listed->second ], levelIndex, levelBasePatchID );
+      d_xmlParsed[levelIndex][ listed->second ] = true;
+    }
 
     // ARS - Commented out because the failure occurs regardless if
     // the l0 refence is present or not.
@@ -2299,7 +2459,8 @@ DataArchive::TimeData::parsePatch( const Patch * patch )
     //                     __FILE__, __LINE__ );
     // }
   }
-  else
+
+  if( !patchinfo.parsed )
   {
     // Try making a guess as to the processor.  First go is to try the
     // processor of the same index as the patch.  Many datasets have
@@ -2313,6 +2474,9 @@ DataArchive::TimeData::parsePatch( const Patch * patch )
     // Failed the guess - parse the entire dataset for this level
     if ( !patchinfo.parsed ) {
       for (unsigned proc = 0; proc < d_xmlFilenames[levelIndex].size(); proc++) {
+        if( d_xmlParsed[levelIndex][proc] ) {
+          continue;
+        }
         parseFile( d_xmlFilenames[levelIndex][proc], levelIndex, levelBasePatchID );
         d_xmlParsed[levelIndex][proc] = true;
       }
@@ -2427,9 +2591,8 @@ DataArchive::queryMaterials( const string & varname,
   for (unsigned i = 0; i < timedata.d_matlInfo[patch->getLevel()->getIndex()].size(); i++) {
     // i-1, since the matlInfo is adjusted to allow -1 as entries
     VarnameMatlPatch vmp( varname, i-1, patch->getRealPatch()->getID() );
-    DataFileInfo dummy;
 
-    if( std::find( timedata.d_datafileInfoIndex.begin(), timedata.d_datafileInfoIndex.end(), vmp ) != timedata.d_datafileInfoIndex.end() ) {
+    if( timedata.findDatafileInfo( vmp ) != nullptr ) {
       matls.addInOrder(i-1);
     }
   }
@@ -2489,9 +2652,8 @@ DataArchive::exists( const string & varname,
   for( unsigned i = 0; i < timedata.d_matlInfo[levelIndex].size(); i++ ) {
     // i-1, since the matlInfo is adjusted to allow -1 as entries
     VarnameMatlPatch vmp( varname, i-1, patch->getRealPatch()->getID() );
-    DataFileInfo dummy;
 
-    if( std::find( timedata.d_datafileInfoIndex.begin(), timedata.d_datafileInfoIndex.end(), vmp ) != timedata.d_datafileInfoIndex.end() ) {
+    if( timedata.findDatafileInfo( vmp ) != nullptr ) {
       d_lock.unlock();
       return true;
     }
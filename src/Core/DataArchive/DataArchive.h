@@ -51,6 +51,7 @@
 
 #include <list>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <fcntl.h>
@@ -297,6 +298,32 @@ public:
   // Used as the first byte of the grid.xml file to designate/verify that it is stored in binary format.
   static const unsigned int GRID_MAGIC_NUMBER{ 0xdeadbeef };
 
+  // Binary variable index (pNNNNN.idx) written next to a pNNNNN.xml
+  // file when the DataArchiver's <binaryIndex> is set. It holds the
+  // same information as the xml and is read with a single read call
+  // instead of an xml parse. Native byte order; a reader that does
+  // not recognize the header falls back to the xml. Layout:
+  //
+  //   unsigned int  INDEX_MAGIC_NUMBER, INDEX_VERSION
+  //   unsigned int  number of strings, then per string its length
+  //                 and characters (no terminator)
+  //   unsigned int  number of entries, then the IndexEntry records
+  static const unsigned int INDEX_MAGIC_NUMBER{ 0x55444149 };  // "UDAI"
+  static const unsigned int INDEX_VERSION{ 1 };
+
+  struct IndexEntry {
+    int       variable;         // string table indices
+    int       type;
+    int       compression;      // -1 for none
+    int       filename;
+    int       matl;
+    int       patch;
+    long long start;            // byte range in the data file
+    long long end;
+    int       numParticles;     // -1 for non-particle variables
+    int       boundaryLayer[3];
+  };
+
 protected:
   DataArchive();
 
@@ -366,6 +393,10 @@ private:
     std::string datafilename;
   };
 
+  struct VarnameMatlPatchHash {
+    size_t operator()( const VarnameMatlPatch & vmp ) const { return vmp.hash_; }
+  };
+
   //  typedef Uintah::HashTable<VarnameMatlPatch, DataFileInfo> VarHashMap;
   //  typedef Uintah::HashTableIter<VarnameMatlPatch, DataFileInfo> VarHashMapIterator;
 
@@ -388,6 +419,20 @@ private:
     // Parse an individual data file and load appropriate storage.
     void parseFile( const std::string & filename, int levelNum, int basePatch );
 
+    // Load the binary index next to an xml data file instead of
+    // parsing the xml. Returns false if there is no usable index.
+    bool parseIndexFile( const std::string & filename, int levelNum, int basePatch );
+
+    // Record a variable found by parseFile() or parseIndexFile().
+    void addVariable( const std::string & varname, int matl, int patchid,
+                      const std::string & type, const std::string & compression,
+                      const std::string & filename, const IntVector & boundary,
+                      long start, long end, int numParticles,
+                      int levelNum, int basePatch, bool addMaterials );
+
+    // The datafile info of a variable, nullptr if it is not in the timestep.
+    DataFileInfo * findDatafileInfo( const VarnameMatlPatch & vmp );
+
     // This would be private data, except we want DataArchive to have access,
     // so we would mark DataArchive as 'friend', but we're already a private
     // nested class of DataArchive...
@@ -398,6 +443,9 @@ private:
     std::vector<VarnameMatlPatch> d_datafileInfoIndex;
     std::vector<DataFileInfo>     d_datafileInfoValue;
 
+    // Position of each entry of d_datafileInfoIndex, for lookups.
+    std::unordered_map<VarnameMatlPatch, int, VarnameMatlPatchHash> d_datafileInfoPos;
+
     // Patch info (separate by levels) - proc, whether parsed, datafile, etc.
     // Gets expanded and proc is set during queryGrid.  Other fields are set
     // when parsed
@@ -414,6 +462,10 @@ private:
     std::vector< std::vector<std::string> > d_xmlFilenames;
     std::vector< std::vector<bool> >        d_xmlParsed;
 
+    // Per level, the output rank -> its index in d_xmlFilenames. With
+    // aggregated output a file lists the ranks it holds as "ranks".
+    std::vector< std::unordered_map<int, int> > d_xmlFileOfProc;
+
     std::string   d_globaldata;
 
     ConsecutiveRangeSet d_matls;  // materials available this timestep
@@ -256,6 +256,61 @@ int BSplineInterpolator::findCellAndWeights(const Point& pos,
   return 64;
 }
  
+//______________________________________________________________________
+//  Batched version of the above.  The node count changes near the domain
+//  boundary, so this loops per particle, but the level and its node range
+//  are looked up once per block rather than once per particle.
+int BSplineInterpolator::findCellsAndWeights(const int n,
+                                             const Point* pos,
+                                             const Matrix3* psize,
+                                             IntVector* ni,
+                                             double* S)
+{
+  const Level* level = d_patch->getLevel();
+  IntVector low,hi;
+  level->findInteriorNodeIndexRange(low,hi);
+
+  int rows = 0;
+  for(int p=0;p<n;p++){
+    Point cellpos = level->positionToIndex(pos[p]);
+
+    int ix = Floor(cellpos.x());
+    int iy = Floor(cellpos.y());
+    int iz = Floor(cellpos.z());
+
+    int xn[4], yn[4], zn[4];
+    int countx = 2;
+    int county = 2;
+    int countz = 2;
+    double Sx[4],Sy[4],Sz[4];
+
+    findNodeComponents(ix,xn,countx,low.x(),hi.x());
+    findNodeComponents(iy,yn,county,low.y(),hi.y());
+    findNodeComponents(iz,zn,countz,low.z(),hi.z());
+
+    getBSplineWeights(Sx, xn, countx, low.x(), hi.x(), cellpos.x());
+    getBSplineWeights(Sy, yn, county, low.y(), hi.y(), cellpos.y());
+    getBSplineWeights(Sz, zn, countz, low.z(), hi.z(), cellpos.z());
+
+    int k=0;
+    for(int i=0;i<countx;i++){
+      for(int j=0;j<county;j++){
+        for(int l=0;l<countz;l++){
+          ni[k*n + p] = IntVector(xn[i],yn[j],zn[l]);
+          S[k*n + p]  = Sx[i]*Sy[j]*Sz[l];
+          k++;
+        }
+      }
+    }
+    rows = max(rows, k);
+    for(;k<d_size;k++){
+      ni[k*n + p] = ni[p];
+      S[k*n + p]  = 0.;
+    }
+  }
+  return rows;
+}
+
 int BSplineInterpolator::findCellAndShapeDerivatives(const Point& pos,
                                                      vector<IntVector>& ni,
                                                      vector<Vector>& d_S,
@@ -27,9 +27,40 @@
 #include <Core/Grid/Level.h>
 #include <Core/Malloc/Allocator.h>
 #include <Core/Math/MiscMath.h>
+#include <Core/Util/Assert.h>
 
 using namespace Uintah;
 using namespace std;
+
+namespace {
+
+  // One axis of the GIMP weights for a particle at cell-space coordinate c
+  // in cell i with half width l.  nn is the offset of the third node.
+  inline void gimpWeights1D(const double c, const int i, const double l,
+                            double& f0, double& f1, double& f2, int& nn)
+  {
+    nn = (c - i <= .5) ? -1 : 2;
+    double p0 = c - i;
+    double p1 = c - (i+1);
+    double p2 = c - (i + nn);
+
+    if(p0 <= l){
+      f0 = 1. - (p0*p0 + l*l)/(2*l);
+      f1 = (1. + l + p1)*(1. + l + p1)/(4*l);
+      f2 = (1. + l - p2)*(1. + l - p2)/(4*l);
+    }
+    else if(p0 <= (1.-l)){
+      f0 = 1. - p0;
+      f1 = 1. + p1;
+      f2 = 0.;
+    }
+    else{
+      f0 = (1. + l - p0)*(1. + l - p0)/(4*l);
+      f1 = 1. - (p1*p1 + l*l)/(2*l);
+      f2 = (1. + l + p2)*(1. + l + p2)/(4*l);
+    }
+  }
+}
     
 GIMPInterpolator::GIMPInterpolator()
 {
@@ -204,6 +235,101 @@ int GIMPInterpolator::findCellAndWeights(const Point& pos,
   return count;
 }
  
+//______________________________________________________________________
+//  Batched version of the above.  All 27 rows are filled (zero weights are
+//  not squeezed out) so the block vectorizes over particles.
+int GIMPInterpolator::findCellsAndWeights(const int n,
+                                          const Point* pos,
+                                          const Matrix3* psize,
+                                          IntVector* ni,
+                                          double* S)
+{
+  const Level* level = d_patch->getLevel();
+  const Point  anchor = level->getAnchor();
+  const Vector dcell  = level->dCell();
+  const double ax = anchor.x(), ay = anchor.y(), az = anchor.z();
+  const double dx = dcell.x(),  dy = dcell.y(),  dz = dcell.z();
+
+  // The loop below inlines positionToIndex for a uniform level; catch a
+  // level whose mapping is not (p - anchor)/dcell (e.g. a stretched one)
+  ASSERT(n == 0 || level->positionToIndex(pos[0]) == Point((pos[0] - anchor)/dcell));
+
+  // Half widths, parked in the last rows of S until the weights replace
+  // them; reading the Matrix3 diagonals in the loop below defeats the
+  // vectorizer
+  for (int p = 0; p < n; p++) {
+    S[24*n + p] = psize[p](0,0)/2.;
+    S[25*n + p] = psize[p](1,1)/2.;
+    S[26*n + p] = psize[p](2,2)/2.;
+  }
+
+  // Weights; the base node and the third node offsets are parked in
+  // rows 0 and 1 of ni until the last pass expands them
+#pragma omp simd
+  for (int p = 0; p < n; p++) {
+    double cx = (pos[p].x() - ax)/dx;
+    double cy = (pos[p].y() - ay)/dy;
+    double cz = (pos[p].z() - az)/dz;
+    // Floor() as truncate-and-correct, which vectorizes where floor() may not
+    int ix = (int) cx;  ix -= (cx < ix);
+    int iy = (int) cy;  iy -= (cy < iy);
+    int iz = (int) cz;  iz -= (cz < iz);
+
+    double fx0, fx1, fx2, fy0, fy1, fy2, fz0, fz1, fz2;
+    int nnx, nny, nnz;
+    gimpWeights1D(cx, ix, S[24*n + p], fx0, fx1, fx2, nnx);
+    gimpWeights1D(cy, iy, S[25*n + p], fy0, fy1, fy2, nny);
+    gimpWeights1D(cz, iz, S[26*n + p], fz0, fz1, fz2, nnz);
+
+    // Same node order as tni[] above: x fastest, then y, then z
+    S[ 0*n + p] = fx0*fy0*fz0;
+    S[ 1*n + p] = fx1*fy0*fz0;
+    S[ 2*n + p] = fx2*fy0*fz0;
+    S[ 3*n + p] = fx0*fy1*fz0;
+    S[ 4*n + p] = fx1*fy1*fz0;
+    S[ 5*n + p] = fx2*fy1*fz0;
+    S[ 6*n + p] = fx0*fy2*fz0;
+    S[ 7*n + p] = fx1*fy2*fz0;
+    S[ 8*n + p] = fx2*fy2*fz0;
+    S[ 9*n + p] = fx0*fy0*fz1;
+    S[10*n + p] = fx1*fy0*fz1;
+    S[11*n + p] = fx2*fy0*fz1;
+    S[12*n + p] = fx0*fy1*fz1;
+    S[13*n + p] = fx1*fy1*fz1;
+    S[14*n + p] = fx2*fy1*fz1;
+    S[15*n + p] = fx0*fy2*fz1;
+    S[16*n + p] = fx1*fy2*fz1;
+    S[17*n + p] = fx2*fy2*fz1;
+    S[18*n + p] = fx0*fy0*fz2;
+    S[19*n + p] = fx1*fy0*fz2;
+    S[20*n + p] = fx2*fy0*fz2;
+    S[21*n + p] = fx0*fy1*fz2;
+    S[22*n + p] = fx1*fy1*fz2;
+    S[23*n + p] = fx2*fy1*fz2;
+    S[24*n + p] = fx0*fy2*fz2;
+    S[25*n + p] = fx1*fy2*fz2;
+    S[26*n + p] = fx2*fy2*fz2;
+    ni[p]     = IntVector(ix, iy, iz);
+    ni[n + p] = IntVector(nnx, nny, nnz);
+  }
+
+  for (int p = 0; p < n; p++) {
+    const IntVector base = ni[p];
+    const IntVector nn   = ni[n + p];
+    const int xs[3] = {base.x(), base.x()+1, base.x()+nn.x()};
+    const int ys[3] = {base.y(), base.y()+1, base.y()+nn.y()};
+    const int zs[3] = {base.z(), base.z()+1, base.z()+nn.z()};
+    for (int c = 0; c < 3; c++) {
+      for (int b = 0; b < 3; b++) {
+        for (int a = 0; a < 3; a++) {
+          ni[(a + 3*b + 9*c)*n + p] = IntVector(xs[a], ys[b], zs[c]);
+        }
+      }
+    }
+  }
+  return 27;
+}
+
 int GIMPInterpolator::findCellAndShapeDerivatives(const Point& pos,
                                                   vector<IntVector>& ni,
                                                   vector<Vector>& d_S,
@@ -44,6 +44,12 @@ namespace Uintah {
     virtual int findCellAndWeights(const Point& p,std::vector<IntVector>& ni,
                                    std::vector<double>& S, const Matrix3& size);
 
+    virtual int findCellsAndWeights(const int n,
+                                    const Point* pos,
+                                    const Matrix3* psize,
+                                    IntVector* ni,
+                                    double* S);
+
     virtual int findCellAndShapeDerivatives(const Point& pos,
                                              std::vector<IntVector>& ni,
                                              std::vector<Vector>& d_S,
@@ -218,17 +218,7 @@ Level::addPatch( const IntVector & lowIndex
 const Patch*
 Level::getPatchFromPoint( const Point & p, const bool includeExtraCells ) const
 {
-  selectType patch;
-  IntVector c = getCellIndex(p);
-  // Point is within the bounding box so query the BVH
-  m_bvh->query(c, c + IntVector(1, 1, 1), patch, includeExtraCells);
-
-  if (patch.size() == 0) {
-    return 0;
-  }
-
-  ASSERT(patch.size() == 1);
-  return patch[0];
+  return getPatchFromIndex(getCellIndex(p), includeExtraCells);
 }
 
 //______________________________________________________________________
@@ -236,6 +226,24 @@ Level::getPatchFromPoint( const Point & p, const bool includeExtraCells ) const
 const Patch*
 Level::getPatchFromIndex( const IntVector & c, const bool includeExtraCells ) const
 {
+  // Lattice of patches: an array lookup.  A hole, or a cell outside the
+  // table (extra cells, periodic images), falls through to the BVH.
+  if (!m_tile_patches.empty()) {
+    const IntVector rel = c - m_tile_low;
+
+    if (rel.x() >= 0 && rel.x() < static_cast<int>(m_tile_of_cell[0].size()) &&
+        rel.y() >= 0 && rel.y() < static_cast<int>(m_tile_of_cell[1].size()) &&
+        rel.z() >= 0 && rel.z() < static_cast<int>(m_tile_of_cell[2].size())) {
+
+      const int tile = (m_tile_of_cell[2][rel.z()] * m_num_tiles.y() + m_tile_of_cell[1][rel.y()]) * m_num_tiles.x()
+                     + m_tile_of_cell[0][rel.x()];
+
+      if (m_tile_patches[tile] != nullptr) {
+        return m_tile_patches[tile];
+      }
+    }
+  }
+
   selectType patch;
 
   // Point is within the bounding box so query the BVH.
@@ -799,7 +807,8 @@ Level::finalizeLevel()
   // Loop through all patches and find the patches that overlap.  Needed
   // when patches layouts have inside corners.
   setOverlappingPatches();
-  
+
+  setPatchLookupTable();
 }
 
 //______________________________________________________________________
@@ -906,6 +915,83 @@ Level::finalizeLevel( bool periodicX, bool periodicY, bool periodicZ )
   // Loop through all patches and find the patches that overlap.  Needed
   // when patch layouts have inside corners.
   setOverlappingPatches();
+
+  setPatchLookupTable();
+}
+
+//______________________________________________________________________
+//
+void
+Level::setPatchLookupTable()
+{
+  m_tile_patches.clear();
+  m_num_tiles = IntVector(0, 0, 0);
+  for (int d = 0; d < 3; ++d) {
+    m_tile_of_cell[d].clear();
+  }
+
+  if (m_real_patches.empty()) {
+    return;
+  }
+
+  // The distinct patch faces along each axis
+  std::vector<int> faces[3];
+  for (size_t i = 0; i < m_real_patches.size(); ++i) {
+    const Patch* patch = m_real_patches[i];
+    for (int d = 0; d < 3; ++d) {
+      faces[d].push_back(patch->getCellLowIndex()[d]);
+      faces[d].push_back(patch->getCellHighIndex()[d]);
+    }
+  }
+
+  size_t num_tiles = 1;
+  for (int d = 0; d < 3; ++d) {
+    std::sort(faces[d].begin(), faces[d].end());
+    faces[d].erase(std::unique(faces[d].begin(), faces[d].end()), faces[d].end());
+    m_num_tiles[d] = static_cast<int>(faces[d].size()) - 1;
+    num_tiles *= m_num_tiles[d];
+  }
+
+  // Scattered patches (refined regions) would give a mostly empty table
+  if (num_tiles > 8 * m_real_patches.size()) {
+    return;
+  }
+
+  std::vector<const Patch*> tiles(num_tiles, nullptr);
+
+  for (size_t i = 0; i < m_real_patches.size(); ++i) {
+    const Patch* patch = m_real_patches[i];
+    const IntVector low  = patch->getCellLowIndex();
+    const IntVector high = patch->getCellHighIndex();
+
+    IntVector tile;
+    for (int d = 0; d < 3; ++d) {
+      const int k = static_cast<int>(std::lower_bound(faces[d].begin(), faces[d].end(), low[d]) - faces[d].begin());
+
+      // A patch spanning several slabs: not a lattice
+      if (faces[d][k + 1] != high[d]) {
+        return;
+      }
+      tile[d] = k;
+    }
+
+    const size_t t = (static_cast<size_t>(tile.z()) * m_num_tiles.y() + tile.y()) * m_num_tiles.x() + tile.x();
+    if (tiles[t] != nullptr) {
+      return;
+    }
+    tiles[t] = patch;
+  }
+
+  for (int d = 0; d < 3; ++d) {
+    m_tile_low[d] = faces[d].front();
+    m_tile_of_cell[d].resize(faces[d].back() - faces[d].front());
+    for (int k = 0; k < m_num_tiles[d]; ++k) {
+      std::fill(m_tile_of_cell[d].begin() + (faces[d][k] - faces[d].front()),
+                m_tile_of_cell[d].begin() + (faces[d][k + 1] - faces[d].front()), k);
+    }
+  }
+
+  m_tile_patches.swap(tiles);
 }
 
 //______________________________________________________________________
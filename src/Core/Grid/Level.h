@@ -323,6 +323,17 @@ private:
 
   PatchBVH * m_bvh{nullptr};
 
+  // When the real patches tile a box of cells as a lattice (every patch is
+  // one cell of the grid formed by all the patch faces), a cell maps to its
+  // patch through m_tile_of_cell and m_tile_patches, with no BVH query.
+  // m_tile_patches is empty for any other layout.
+  void setPatchLookupTable();
+
+  IntVector                 m_tile_low{0, 0, 0};   // first cell of the table
+  IntVector                 m_num_tiles{0, 0, 0};
+  std::vector<int>          m_tile_of_cell[3];     // per axis, cell - m_tile_low -> tile
+  std::vector<const Patch*> m_tile_patches{};      // x fastest, nullptr for holes
+
   // overlapping patches   
   std::map< std::pair<int, int>, overlap > m_overLapPatches{};
   void setOverlappingPatches();
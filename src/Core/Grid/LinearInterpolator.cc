@@ -24,6 +24,7 @@
 
 #include <Core/Grid/LinearInterpolator.h>
 #include <Core/Malloc/Allocator.h>
+#include <Core/Util/Assert.h>
 
 using namespace Uintah;
 using namespace std;
@@ -84,6 +85,76 @@ int LinearInterpolator::findCellAndWeights(const Point& pos,
   return 8;
 }
 
+//______________________________________________________________________
+//  Batched version of the above.  The level is uniform, so positionToIndex
+//  reduces to (p - anchor)/dcell and the whole block vectorizes.
+int LinearInterpolator::findCellsAndWeights(const int n,
+                                            const Point* pos,
+                                            const Matrix3* psize,
+                                            IntVector* ni,
+                                            double* S)
+{
+  const Level* level = d_patch->getLevel();
+  const Point  anchor = level->getAnchor();
+  const Vector dcell  = level->dCell();
+  const double ax = anchor.x(), ay = anchor.y(), az = anchor.z();
+  const double dx = dcell.x(),  dy = dcell.y(),  dz = dcell.z();
+
+  // The loop below inlines positionToIndex for a uniform level; catch a
+  // level whose mapping is not (p - anchor)/dcell (e.g. a stretched one)
+  ASSERT(n == 0 || level->positionToIndex(pos[0]) == Point((pos[0] - anchor)/dcell));
+
+  double* S0 = S;
+  double* S1 = S +   n;
+  double* S2 = S + 2*n;
+  double* S3 = S + 3*n;
+  double* S4 = S + 4*n;
+  double* S5 = S + 5*n;
+  double* S6 = S + 6*n;
+  double* S7 = S + 7*n;
+
+  // Weights, plus the base node parked in row 0
+#pragma omp simd
+  for (int p = 0; p < n; p++) {
+    double cx = (pos[p].x() - ax)/dx;
+    double cy = (pos[p].y() - ay)/dy;
+    double cz = (pos[p].z() - az)/dz;
+    // Floor() as truncate-and-correct, which vectorizes where floor() may not
+    int ix = (int) cx;  ix -= (cx < ix);
+    int iy = (int) cy;  iy -= (cy < iy);
+    int iz = (int) cz;  iz -= (cz < iz);
+    double fx = cx - ix;
+    double fy = cy - iy;
+    double fz = cz - iz;
+    double fx1 = 1-fx;
+    double fy1 = 1-fy;
+    double fz1 = 1-fz;
+    S0[p] = fx1 * fy1 * fz1;
+    S1[p] = fx1 * fy1 * fz;
+    S2[p] = fx1 * fy * fz1;
+    S3[p] = fx1 * fy * fz;
+    S4[p] = fx * fy1 * fz1;
+    S5[p] = fx * fy1 * fz;
+    S6[p] = fx * fy * fz1;
+    S7[p] = fx * fy * fz;
+    ni[p] = IntVector(ix, iy, iz);
+  }
+
+  for (int p = 0; p < n; p++) {
+    const int ix = ni[p].x();
+    const int iy = ni[p].y();
+    const int iz = ni[p].z();
+    ni[  n + p] = IntVector(ix, iy, iz+1);
+    ni[2*n + p] = IntVector(ix, iy+1, iz);
+    ni[3*n + p] = IntVector(ix, iy+1, iz+1);
+    ni[4*n + p] = IntVector(ix+1, iy, iz);
+    ni[5*n + p] = IntVector(ix+1, iy, iz+1);
+    ni[6*n + p] = IntVector(ix+1, iy+1, iz);
+    ni[7*n + p] = IntVector(ix+1, iy+1, iz+1);
+  }
+  return 8;
+}
+
 //______________________________________________________________________
 //  This interpolation function from equation 14 of 
 //  Jin Ma, Hongbind Lu and Ranga Komanduri
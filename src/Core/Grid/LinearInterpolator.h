@@ -89,6 +89,12 @@ namespace Uintah {
                                     std::vector<double>& S,
                                     const Matrix3& size);
 
+    virtual int findCellsAndWeights(const int n,
+                                    const Point* pos,
+                                    const Matrix3* psize,
+                                    IntVector* ni,
+                                    double* S);
+
     //__________________________________
     //  AMRMPM                                
     virtual void findCellAndWeights_CFI(const Point& pos,
@@ -28,6 +28,7 @@
 #include <Core/Geometry/Point.h>
 #include <Core/Geometry/IntVector.h>
 #include <Core/Geometry/Vector.h>
+#include <algorithm>
 #include <vector>
 
 #include <Core/Grid/Variables/NCVariable.h>
@@ -56,6 +57,38 @@ namespace Uintah {
     virtual int findCellAndWeights(const Point& p,
                                     std::vector<IntVector>& ni,
                                     std::vector<double>& S) {return 0;};
+
+    //__________________________________
+    //  Batched weights for a block of n particles, structure-of-arrays:
+    //  node k of particle p is ni[k*n + p] with weight S[k*n + p], so each
+    //  row is contiguous over the block.  ni and S must hold size()*n
+    //  entries.  Returns the number of rows to visit; rows a particle does
+    //  not use carry zero weight on a node inside its stencil.
+    //  The default just loops over the per-particle call.
+    virtual int findCellsAndWeights(const int n,
+                                    const Point* pos,
+                                    const Matrix3* psize,
+                                    IntVector* ni,
+                                    double* S)
+    {
+      const int nodes = size();
+      std::vector<IntVector> pni(nodes);
+      std::vector<double>    pS(nodes);
+      int rows = 0;
+      for (int p = 0; p < n; p++) {
+        int NN = findCellAndWeights(pos[p], pni, pS, psize[p]);
+        for (int k = 0; k < NN; k++) {
+          ni[k*n + p] = pni[k];
+          S[k*n + p]  = pS[k];
+        }
+        for (int k = NN; k < nodes; k++) {
+          ni[k*n + p] = pni[0];
+          S[k*n + p]  = 0.0;
+        }
+        rows = std::max(rows, NN);
+      }
+      return rows;
+    }
                                     
 
                                     
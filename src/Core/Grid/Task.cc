@@ -38,6 +38,7 @@
 using namespace Uintah;
 
 MaterialSubset* Task::globalMatlSubset = nullptr;
+LoopTiling      Task::s_default_loop_tiling{};
 
 
 //______________________________________________________________________
@@ -241,6 +242,39 @@ Task::usesKokkosCuda(bool state)
   m_uses_kokkos_cuda = state;
 }
 
+//______________________________________________________________________
+//
+void
+Task::setLoopTiling(const LoopTiling & loopTiling)
+{
+  m_loop_tiling = loopTiling;
+  m_has_loop_tiling = true;
+}
+
+//______________________________________________________________________
+//
+const LoopTiling &
+Task::getLoopTiling() const
+{
+  return m_has_loop_tiling ? m_loop_tiling : s_default_loop_tiling;
+}
+
+//______________________________________________________________________
+//
+void
+Task::setDefaultLoopTiling(const LoopTiling & loopTiling)
+{
+  s_default_loop_tiling = loopTiling;
+}
+
+//______________________________________________________________________
+//
+const LoopTiling &
+Task::getDefaultLoopTiling()
+{
+  return s_default_loop_tiling;
+}
+
 //______________________________________________________________________
 //
 TaskAssignedExecutionSpace
@@ -1067,6 +1101,8 @@ Task::doit( const PatchSubset           * patches
   DataWarehouse* fromDW = mapDataWarehouse(Task::OldDW, dws);
   DataWarehouse* toDW   = mapDataWarehouse(Task::NewDW, dws);
 
+  uintahParams.setLoopTiling(getLoopTiling());
+
   if (m_action) {
     //m_action->doit(patches, matls, fromDW, toDW, uintahParams, execObj);
     m_action->doit(patches, matls, fromDW, toDW, uintahParams);
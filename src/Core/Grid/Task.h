@@ -215,6 +215,7 @@ private: // class Task
 
       execObj.setCudaThreadsPerBlock(Uintah::Parallel::getCudaThreadsPerBlock());
       execObj.setCudaBlocksPerLoop(Uintah::Parallel::getCudaBlocksPerLoop());
+      execObj.setLoopTiling(uintahParams.getLoopTiling());
 
       const int numStreams = uintahParams.getNumStreams();
 
@@ -622,6 +623,7 @@ private:
 
       execObj.setCudaThreadsPerBlock(Uintah::Parallel::getCudaThreadsPerBlock());
       execObj.setCudaBlocksPerLoop(Uintah::Parallel::getCudaBlocksPerLoop());
+      execObj.setLoopTiling(uintahParams.getLoopTiling());
 
       const int numStreams = uintahParams.getNumStreams();
 
@@ -682,6 +684,7 @@ private:
 
       execObj.setCudaThreadsPerBlock(Uintah::Parallel::getCudaThreadsPerBlock());
       execObj.setCudaBlocksPerLoop(Uintah::Parallel::getCudaBlocksPerLoop());
+      execObj.setLoopTiling(uintahParams.getLoopTiling());
 
       const int numStreams = uintahParams.getNumStreams();
 
@@ -747,6 +750,7 @@ private:
 
       execObj.setCudaThreadsPerBlock(Uintah::Parallel::getCudaThreadsPerBlock());
       execObj.setCudaBlocksPerLoop(Uintah::Parallel::getCudaBlocksPerLoop());
+      execObj.setLoopTiling(uintahParams.getLoopTiling());
 
       const int numStreams = uintahParams.getNumStreams();
 
@@ -817,6 +821,7 @@ private:
 
       execObj.setCudaThreadsPerBlock(Uintah::Parallel::getCudaThreadsPerBlock());
       execObj.setCudaBlocksPerLoop(Uintah::Parallel::getCudaBlocksPerLoop());
+      execObj.setLoopTiling(uintahParams.getLoopTiling());
 
       const int numStreams = uintahParams.getNumStreams();
 
@@ -892,6 +897,7 @@ private:
 
       execObj.setCudaThreadsPerBlock(Uintah::Parallel::getCudaThreadsPerBlock());
       execObj.setCudaBlocksPerLoop(Uintah::Parallel::getCudaBlocksPerLoop());
+      execObj.setLoopTiling(uintahParams.getLoopTiling());
 
       const int numStreams = uintahParams.getNumStreams();
 
@@ -973,6 +979,7 @@ private:
 
       execObj.setCudaThreadsPerBlock(Uintah::Parallel::getCudaThreadsPerBlock());
       execObj.setCudaBlocksPerLoop(Uintah::Parallel::getCudaBlocksPerLoop());
+      execObj.setLoopTiling(uintahParams.getLoopTiling());
 
       const int numStreams = uintahParams.getNumStreams();
 
@@ -1382,6 +1389,14 @@ public: // class Task
          void usesKokkosCuda(bool state);
   inline bool usesKokkosCuda() const { return m_uses_kokkos_cuda; }
 
+  // How the OpenMP back-end of parallel_for/parallel_reduce_* walks this task's ranges.
+  // Tasks without their own setting use the default (set from the <LoopTiling> input block).
+         void setLoopTiling(const LoopTiling & loopTiling);
+         const LoopTiling & getLoopTiling() const;
+
+  static void setDefaultLoopTiling(const LoopTiling & loopTiling);
+  static const LoopTiling & getDefaultLoopTiling();
+
   enum MaterialDomainSpec {
       NormalDomain  // <- Normal/default setting
     , OutOfDomain   // <- Require things from all material
@@ -1849,6 +1864,8 @@ protected: // class Task
 
   static MaterialSubset* globalMatlSubset;
 
+  static LoopTiling s_default_loop_tiling;
+
   Dependency * m_comp_head{nullptr};
   Dependency * m_comp_tail{nullptr};
   Dependency * m_req_head{nullptr};
@@ -1872,6 +1889,8 @@ protected: // class Task
   bool m_preload_sim_vars{false};
   bool m_uses_kokkos_openmp{false};
   bool m_uses_kokkos_cuda{false};
+  bool m_has_loop_tiling{false};
+  LoopTiling m_loop_tiling{};
   int  m_max_streams_per_task{1};
   bool m_subpatch_capable{false};
   bool m_has_subscheduler{false};
@@ -27,6 +27,7 @@
 
 #include <Core/Util/RefCounted.h>
 #include <Core/Geometry/IntVector.h>
+#include <Core/Grid/Variables/HostMemoryPool.h>
 #include <Core/Util/Assert.h>
 #include <Core/Util/FancyAssert.h>
 #include <Core/Malloc/Allocator.h>
@@ -210,9 +211,9 @@ class Array3Data;
     {
       long s=d_size.x()*d_size.y()*d_size.z();
       if(s){
-        d_data=new T[s];
-        d_data3=new T**[d_size.z()];
-        d_data3[0]=new T*[d_size.z()*d_size.y()];
+        d_data=HostMemoryPool::allocateArray<T>(s);
+        d_data3=HostMemoryPool::allocateArray<T**>(d_size.z());
+        d_data3[0]=HostMemoryPool::allocateArray<T*>(d_size.z()*d_size.y());
         d_data3[0][0]=d_data;
         for(int i=1;i<d_size.z();i++){
           d_data3[i]=d_data3[i-1]+d_size.y();
@@ -230,11 +231,11 @@ class Array3Data;
     Array3Data<T>::~Array3Data()
     {
       if(d_data){
-        delete[] d_data;
+        HostMemoryPool::deallocateArray(d_data, static_cast<size_t>(d_size.x())*d_size.y()*d_size.z());
         d_data=0;
-        delete[] d_data3[0];
+        HostMemoryPool::deallocateArray(d_data3[0], d_size.z()*d_size.y());
         d_data3[0]=0;
-        delete[] d_data3;
+        HostMemoryPool::deallocateArray(d_data3, d_size.z());
         d_data3=0;
       }
     }
@@ -42,6 +42,7 @@
 #include <sci_defs/pidx_defs.h>
 
 #include <cstring>
+#include <type_traits>
 
 namespace Uintah {
 
@@ -198,6 +199,33 @@ WARNING
       }
     }
 
+    // One segment per x row of [l,h), rows that follow each other in
+    // memory (a window spanning the allocation in x, or in x and y)
+    // are merged.
+    virtual bool emitSegments( const IntVector & l, const IntVector & h, ProblemSpecP /*varnode*/,
+                               bool outputDoubleAsFloat, std::vector<EmitSegment> & segments ) {
+      const TypeDescription* td = fun_getTypeDescription( (T*)nullptr );
+      if( !td->isFlat() || ( outputDoubleAsFloat && std::is_same<T, double>::value ) ) {
+        return false;
+      }
+      const size_t linesize = sizeof(T) * ( h.x() - l.x() );
+      if( linesize == 0 ) {
+        return true;
+      }
+      for( int z = l.z(); z < h.z(); z++ ) {
+        for( int y = l.y(); y < h.y(); y++ ) {
+          const char* row = (const char*) &(*this)[ IntVector( l.x(), y, z ) ];
+          if( !segments.empty() && segments.back().data + segments.back().size == row ) {
+            segments.back().size += linesize;
+          }
+          else {
+            segments.push_back( EmitSegment{ row, linesize } );
+          }
+        }
+      }
+      return true;
+    }
+
     virtual void readNormal(std::istream& in, bool swapBytes)
     {
       const TypeDescription* td = fun_getTypeDescription((T*)0);
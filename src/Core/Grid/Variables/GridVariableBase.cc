@@ -28,11 +28,69 @@
 #include <Core/Exceptions/InternalError.h>
 #include <Core/Geometry/IntVector.h>
 #include <Core/Parallel/BufferInfo.h>
+#include <Core/Parallel/MasterLock.h>
 
+#include <atomic>
+#include <map>
+#include <mutex>
 #include <string>
+#include <tuple>
 
 using namespace Uintah;
 
+namespace {
+
+  // Committed MPI datatypes for a strided 3D window depend only on the base type, the
+  // window extents and the strides, not on the buffer address. Halo exchanges hit the
+  // same handful of shapes every timestep, so keep them instead of rebuilding them.
+  using DatatypeKey = std::tuple<MPI_Datatype, int, int, int, int, int, int>;
+
+  std::map<DatatypeKey, MPI_Datatype> g_mpi_window_types;
+  Uintah::MasterLock                  g_mpi_window_types_mutex{};
+
+  // Bumped by freeMPIWindowTypes() so that threads drop their copies of freed types.
+  std::atomic<int>                    g_mpi_window_types_generation{0};
+
+  // Each thread keeps the types it has used, so a hit takes no lock; only a miss goes
+  // to the shared map.
+  struct ThreadWindowTypes {
+    int                                 m_generation{-1};
+    std::map<DatatypeKey, MPI_Datatype> m_types;
+  };
+
+  thread_local ThreadWindowTypes t_mpi_window_types;
+
+  MPI_Datatype
+  sharedWindowType( const DatatypeKey & key )
+  {
+    std::lock_guard<Uintah::MasterLock> types_guard(g_mpi_window_types_mutex);
+
+    auto iter = g_mpi_window_types.find(key);
+    if (iter != g_mpi_window_types.end()) {
+      return iter->second;
+    }
+
+    MPI_Datatype basetype = std::get<0>(key);
+
+    MPI_Datatype type1d;
+    Uintah::MPI::Type_create_hvector(std::get<1>(key), 1, std::get<4>(key), basetype, &type1d);
+
+    MPI_Datatype type2d;
+    Uintah::MPI::Type_create_hvector(std::get<2>(key), 1, std::get<5>(key), type1d, &type2d);
+    Uintah::MPI::Type_free(&type1d);
+
+    MPI_Datatype type3d;
+    Uintah::MPI::Type_create_hvector(std::get<3>(key), 1, std::get<6>(key), type2d, &type3d);
+
+    Uintah::MPI::Type_free(   &type2d );
+    Uintah::MPI::Type_commit( &type3d );
+
+    g_mpi_window_types.insert(std::make_pair(key, type3d));
+    return type3d;
+  }
+
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 void
@@ -49,20 +107,52 @@ GridVariableBase::getMPIBuffer(       BufferInfo & buffer,
   char* startbuf = (char*)getBasePointer();
   startbuf += strides.x()*off.x()+strides.y()*off.y()+strides.z()*off.z();
   IntVector d = high-low;
-  MPI_Datatype type1d;
-  Uintah::MPI::Type_create_hvector(d.x(), 1, strides.x(), basetype, &type1d);
 
-  MPI_Datatype type2d;
-  Uintah::MPI::Type_create_hvector(d.y(), 1, strides.y(), type1d, &type2d);
-  Uintah::MPI::Type_free(&type1d);
+  DatatypeKey key{basetype, d.x(), d.y(), d.z(), strides.x(), strides.y(), strides.z()};
+
+  ThreadWindowTypes & local = t_mpi_window_types;
+  const int generation = g_mpi_window_types_generation.load(std::memory_order_acquire);
+  if (local.m_generation != generation) {
+    local.m_types.clear();
+    local.m_generation = generation;
+  }
 
   MPI_Datatype type3d;
-  Uintah::MPI::Type_create_hvector(d.z(), 1, strides.z(), type2d, &type3d);
+  auto iter = local.m_types.find(key);
+  if (iter != local.m_types.end()) {
+    type3d = iter->second;
+  }
+  else {
+    type3d = sharedWindowType(key);
+    local.m_types.insert(std::make_pair(key, type3d));
+  }
+
+  // rows along x are contiguous (strides.x() is the element size), describe them so
+  // packing can copy whole rows
+  BufferInfo::Window window;
+  window.m_row_bytes = d.x() * strides.x();
+  window.m_num_y     = d.y();
+  window.m_num_z     = d.z();
+  window.m_stride_y  = strides.y();
+  window.m_stride_z  = strides.z();
+
+  // the cached type is shared, so the buffer must not free it
+  buffer.add( startbuf, 1, type3d, false, window );
+}
+
+//______________________________________________________________________
+//
+void
+GridVariableBase::freeMPIWindowTypes()
+{
+  std::lock_guard<Uintah::MasterLock> types_guard(g_mpi_window_types_mutex);
 
-  Uintah::MPI::Type_free(   &type2d );
-  Uintah::MPI::Type_commit( &type3d );
+  for (auto & entry : g_mpi_window_types) {
+    Uintah::MPI::Type_free(&entry.second);
+  }
+  g_mpi_window_types.clear();
 
-  buffer.add( startbuf, 1, type3d, true );
+  g_mpi_window_types_generation.fetch_add(1, std::memory_order_release);
 }
 
 //______________________________________________________________________
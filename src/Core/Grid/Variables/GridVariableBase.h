@@ -80,6 +80,10 @@ WARNING
     virtual void getMPIBuffer(BufferInfo& buffer,
                               const IntVector& low, const IntVector& high);
 
+    // Frees the MPI datatypes getMPIBuffer caches. Only call while no
+    // buffers are being built, i.e. on a regrid or at shutdown.
+    static void freeMPIWindowTypes();
+
     virtual void getSizes(IntVector& low, IntVector& high,
                           IntVector& siz) const = 0;
 
@@ -0,0 +1,296 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <Core/Grid/Variables/HostMemoryPool.h>
+
+#include <Core/Parallel/MasterLock.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+
+using namespace Uintah;
+
+namespace {
+
+// Sits in the s_alignment bytes in front of every buffer handed out
+struct BufferHeader {
+  size_t m_bytes;       // bytes available to the caller
+  int    m_size_class;  // -1 if not pooled
+};
+
+static_assert(sizeof(BufferHeader) <= HostMemoryPool::s_alignment, "HostMemoryPool buffer header does not fit its alignment");
+
+constexpr int s_classes_per_octave_log2 = 3;
+constexpr int s_classes_per_octave      = 1 << s_classes_per_octave_log2;
+constexpr int s_num_size_classes        = 64 * s_classes_per_octave;
+
+struct SizeClass {
+  MasterLock          m_lock;
+  std::vector<void*>  m_free;           // user pointers, most recently freed at the back
+  size_t              m_low_water{0};   // smallest m_free.size() since the last releaseUnused()
+};
+
+SizeClass g_size_classes[s_num_size_classes];
+
+std::atomic<bool>   g_enabled{false};
+
+std::atomic<size_t> g_hits{0};
+std::atomic<size_t> g_misses{0};
+std::atomic<size_t> g_bytes_in_use{0};
+std::atomic<size_t> g_high_water{0};
+std::atomic<size_t> g_bytes_cached{0};
+
+//______________________________________________________________________
+//
+// Rounds bytes up to its size class: 8 classes per power of two, so at most 12.5% is wasted.
+int
+sizeClass( size_t bytes, size_t & class_bytes )
+{
+  bytes = std::max(bytes, HostMemoryPool::s_alignment);
+  const int    msb      = 63 - __builtin_clzll(bytes - 1);
+  const int    shift    = msb - s_classes_per_octave_log2;
+  const size_t mantissa = ((bytes - 1) >> shift) + 1;  // (s_classes_per_octave, 2 * s_classes_per_octave]
+
+  class_bytes = mantissa << shift;
+  return msb * s_classes_per_octave + static_cast<int>(mantissa) - s_classes_per_octave - 1;
+}
+
+//______________________________________________________________________
+//
+void *
+systemAllocate( size_t bytes, int size_class )
+{
+  void * raw = nullptr;
+  if (posix_memalign(&raw, HostMemoryPool::s_alignment, HostMemoryPool::s_alignment + bytes) != 0) {
+    throw std::bad_alloc();
+  }
+  BufferHeader * header = static_cast<BufferHeader*>(raw);
+  header->m_bytes      = bytes;
+  header->m_size_class = size_class;
+  return static_cast<char*>(raw) + HostMemoryPool::s_alignment;
+}
+
+//______________________________________________________________________
+//
+inline BufferHeader *
+getHeader( void * ptr )
+{
+  return reinterpret_cast<BufferHeader*>(static_cast<char*>(ptr) - HostMemoryPool::s_alignment);
+}
+
+//______________________________________________________________________
+//
+inline void
+systemFree( void * ptr )
+{
+  std::free(getHeader(ptr));
+}
+
+//______________________________________________________________________
+//
+inline void
+addInUse( size_t bytes )
+{
+  const size_t in_use = g_bytes_in_use.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  size_t high_water = g_high_water.load(std::memory_order_relaxed);
+  while (in_use > high_water && !g_high_water.compare_exchange_weak(high_water, in_use, std::memory_order_relaxed)) {}
+}
+
+//______________________________________________________________________
+//
+// Releases the n least recently freed buffers of a class, caller holds its lock
+void
+releaseOldest( SizeClass & sc, size_t n )
+{
+  n = std::min(n, sc.m_free.size());
+  for (size_t i = 0; i < n; ++i) {
+    g_bytes_cached.fetch_sub(getHeader(sc.m_free[i])->m_bytes, std::memory_order_relaxed);
+    systemFree(sc.m_free[i]);
+  }
+  sc.m_free.erase(sc.m_free.begin(), sc.m_free.begin() + n);
+}
+
+} // namespace
+
+
+//______________________________________________________________________
+//
+void *
+HostMemoryPool::allocate( size_t bytes )
+{
+  if (!g_enabled.load(std::memory_order_relaxed)) {
+    void * ptr = systemAllocate(bytes, -1);
+    addInUse(bytes);
+    return ptr;
+  }
+
+  size_t class_bytes;
+  const int size_class = sizeClass(bytes, class_bytes);
+  SizeClass & sc = g_size_classes[size_class];
+
+  void * ptr = nullptr;
+  {
+    std::lock_guard<MasterLock> lock(sc.m_lock);
+    if (!sc.m_free.empty()) {
+      ptr = sc.m_free.back();
+      sc.m_free.pop_back();
+      sc.m_low_water = std::min(sc.m_low_water, sc.m_free.size());
+    }
+  }
+
+  if (ptr != nullptr) {
+    g_hits.fetch_add(1, std::memory_order_relaxed);
+    g_bytes_cached.fetch_sub(class_bytes, std::memory_order_relaxed);
+  }
+  else {
+    g_misses.fetch_add(1, std::memory_order_relaxed);
+    ptr = systemAllocate(class_bytes, size_class);
+  }
+
+  addInUse(class_bytes);
+  return ptr;
+}
+
+//______________________________________________________________________
+//
+void
+HostMemoryPool::deallocate( void * ptr )
+{
+  if (ptr == nullptr) {
+    return;
+  }
+
+  BufferHeader * header = getHeader(ptr);
+  g_bytes_in_use.fetch_sub(header->m_bytes, std::memory_order_relaxed);
+
+  if (header->m_size_class < 0 || !g_enabled.load(std::memory_order_relaxed)) {
+    systemFree(ptr);
+    return;
+  }
+
+  SizeClass & sc = g_size_classes[header->m_size_class];
+  g_bytes_cached.fetch_add(header->m_bytes, std::memory_order_relaxed);
+  {
+    std::lock_guard<MasterLock> lock(sc.m_lock);
+    sc.m_free.push_back(ptr);
+  }
+}
+
+//______________________________________________________________________
+//
+void
+HostMemoryPool::setEnabled( bool state )
+{
+  g_enabled.store(state);
+  if (!state) {
+    releaseAll();
+  }
+}
+
+//______________________________________________________________________
+//
+bool
+HostMemoryPool::isEnabled()
+{
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+//______________________________________________________________________
+//
+void
+HostMemoryPool::releaseUnused()
+{
+  for (int i = 0; i < s_num_size_classes; ++i) {
+    SizeClass & sc = g_size_classes[i];
+    std::lock_guard<MasterLock> lock(sc.m_lock);
+    releaseOldest(sc, sc.m_low_water);
+    sc.m_low_water = sc.m_free.size();
+  }
+}
+
+//______________________________________________________________________
+//
+void
+HostMemoryPool::releaseAll()
+{
+  for (int i = 0; i < s_num_size_classes; ++i) {
+    SizeClass & sc = g_size_classes[i];
+    std::lock_guard<MasterLock> lock(sc.m_lock);
+    releaseOldest(sc, sc.m_free.size());
+    sc.m_low_water = 0;
+  }
+}
+
+//______________________________________________________________________
+//
+size_t
+HostMemoryPool::getHits()
+{
+  return g_hits.load(std::memory_order_relaxed);
+}
+
+//______________________________________________________________________
+//
+size_t
+HostMemoryPool::getMisses()
+{
+  return g_misses.load(std::memory_order_relaxed);
+}
+
+//______________________________________________________________________
+//
+size_t
+HostMemoryPool::getBytesInUse()
+{
+  return g_bytes_in_use.load(std::memory_order_relaxed);
+}
+
+//______________________________________________________________________
+//
+size_t
+HostMemoryPool::getHighWater()
+{
+  return g_high_water.load(std::memory_order_relaxed);
+}
+
+//______________________________________________________________________
+//
+size_t
+HostMemoryPool::getBytesCached()
+{
+  return g_bytes_cached.load(std::memory_order_relaxed);
+}
+
+//______________________________________________________________________
+//
+void
+HostMemoryPool::resetStatistics()
+{
+  g_hits.store(0);
+  g_misses.store(0);
+  g_high_water.store(g_bytes_in_use.load());
+}
@@ -0,0 +1,119 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef CORE_GRID_VARIABLES_HOSTMEMORYPOOL_H
+#define CORE_GRID_VARIABLES_HOSTMEMORYPOOL_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace Uintah {
+
+/**************************************
+
+CLASS
+   HostMemoryPool
+
+DESCRIPTION
+   Host counterpart of GPUMemoryPool for the storage behind Array3Data and
+   ParticleData.  Every timestep allocates essentially the same set of sizes
+   that scrubbing the old DW just freed, so when enabled, freed buffers are
+   kept on size-class free lists (8 classes per power of two) and handed to
+   the next request of that class instead of going back to the system.
+
+   All storage is 64-byte aligned.  Each buffer carries a small header with
+   its size class, so buffers allocated while the pool was disabled are
+   simply freed, and the pool can be switched on at problemSetup.
+
+   releaseUnused() (once per timestep) returns the buffers of each class that
+   sat idle for the whole interval since the previous call.
+
+****************************************/
+
+class HostMemoryPool {
+
+public:
+
+  static constexpr size_t s_alignment = 64;
+
+  static void * allocate( size_t bytes );
+
+  static void deallocate( void * ptr );
+
+  // n default-initialized objects, as new T[n]
+  template <typename T>
+  static T * allocateArray( size_t n )
+  {
+    T * ptr = static_cast<T*>(allocate(n * sizeof(T)));
+    if (!std::is_trivially_default_constructible<T>::value) {
+      for (size_t i = 0; i < n; ++i) {
+        new (ptr + i) T;
+      }
+    }
+    return ptr;
+  }
+
+  template <typename T>
+  static void deallocateArray( T * ptr, size_t n )
+  {
+    if (ptr == nullptr) {
+      return;
+    }
+    if (!std::is_trivially_destructible<T>::value) {
+      for (size_t i = 0; i < n; ++i) {
+        ptr[i].~T();
+      }
+    }
+    deallocate(ptr);
+  }
+
+  static void setEnabled( bool state );
+  static bool isEnabled();
+
+  // return buffers that were not reused since the last call
+  static void releaseUnused();
+
+  // return all cached buffers
+  static void releaseAll();
+
+  // statistics, for the memory log
+  static size_t getHits();
+  static size_t getMisses();
+  static size_t getBytesInUse();
+  static size_t getHighWater();
+  static size_t getBytesCached();
+  static void   resetStatistics();
+
+private:
+
+  HostMemoryPool()                                   = delete;
+  HostMemoryPool( const HostMemoryPool & )            = delete;
+  HostMemoryPool& operator=( const HostMemoryPool & ) = delete;
+
+};
+
+} // end namespace Uintah
+
+#endif // CORE_GRID_VARIABLES_HOSTMEMORYPOOL_H
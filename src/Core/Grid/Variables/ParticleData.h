@@ -26,6 +26,7 @@
 #define UINTAH_HOMEBREW_PARTICLEDATA_H
 
 #include <Core/Util/RefCounted.h>
+#include <Core/Grid/Variables/HostMemoryPool.h>
 #include <Core/Grid/Variables/ParticleSubset.h> // For particleIndex
 
 namespace Uintah {
@@ -67,12 +68,12 @@ WARNING
       //////////
       // Insert Documentation Here:
       void resize(int newSize) {
-        T* newdata = scinew T[newSize];
+        T* newdata = HostMemoryPool::allocateArray<T>(newSize);
         if(data){
           int smaller = ((newSize < size ) ? newSize:size);
           for(int i = 0; i < smaller; i++)
             newdata[i] = data[i];
-          delete[] data;
+          HostMemoryPool::deallocateArray(data, size);
         }
         data = newdata;
         size = newSize;
@@ -93,20 +94,21 @@ WARNING
       ParticleData<T>::ParticleData()
       {
         data=0;
+        size=0;
       }
    
    template<class T>
      ParticleData<T>::ParticleData(particleIndex size)
      : size(size)
       {
-        data = scinew T[size];
+        data = HostMemoryPool::allocateArray<T>(size);
       }
       
    template<class T>
       ParticleData<T>::~ParticleData()
       {
         if(data)
-          delete[] data;
+          HostMemoryPool::deallocateArray(data, size);
       }
 
    template<class T>
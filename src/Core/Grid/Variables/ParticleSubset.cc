@@ -26,6 +26,8 @@
 #include <Core/Grid/Variables/ParticleSubset.h>
 #include <Core/Grid/Variables/ParticleVariable.h>
 #include <Core/Exceptions/InternalError.h>
+
+#include <algorithm>
 #include <iostream>
 
 using namespace Uintah;
@@ -119,15 +121,64 @@ ParticleSubset::ParticleSubset(       unsigned int   num_particles,
 void
 ParticleSubset::fillset()
 {
-  if (d_numParticles > 0) {
-    d_particles = scinew particleIndex[d_numParticles];
-    
-    for( unsigned int i = 0; i < d_numParticles; i++ ) {
-      d_particles[i] = i;
-    }
-    
+  // 0..n-1 is a contiguous range, no index array needed
+  d_first = 0;
+}
+
+//______________________________________________________________________
+//
+void
+ParticleSubset::materialize()
+{
+  if( d_particles || d_numParticles == 0 ) {
+    return;
+  }
+
+  // d_allocatedSize holds any capacity reserved through expand()
+  if( d_allocatedSize < d_numParticles ) {
     d_allocatedSize = d_numParticles;
   }
+
+  d_particles = scinew particleIndex[d_allocatedSize];
+  for( unsigned int i = 0; i < d_numParticles; i++ ) {
+    d_particles[i] = d_first + i;
+  }
+}
+
+//______________________________________________________________________
+//
+void
+ParticleSubset::compact()
+{
+  if( !d_particles ) {
+    return;
+  }
+
+  for( unsigned int i = 1; i < d_numParticles; i++ ) {
+    if( d_particles[i] != d_particles[0] + (particleIndex)i ) {
+      return;
+    }
+  }
+
+  d_first = (d_numParticles > 0) ? d_particles[0] : 0;
+  delete [] d_particles;
+  d_particles     = nullptr;
+  d_allocatedSize = 0;
+}
+
+//______________________________________________________________________
+//
+void
+ParticleSubset::shift( particleIndex offset )
+{
+  if( !d_particles ) {
+    d_first += offset;
+    return;
+  }
+
+  for( unsigned int i = 0; i < d_numParticles; i++ ) {
+    d_particles[i] += offset;
+  }
 }
 
 //______________________________________________________________________
@@ -158,8 +209,13 @@ ParticleSubset::sort(ParticleVariableBase* particleIDs)
     SCI_THROW(InternalError("particleID variable must be ParticleVariable<long64>", __FILE__, __LINE__));
   }
 
+  materialize();
+
   compareIDFunctor comp(pIDs);
   std::sort(d_particles, d_particles+d_numParticles, comp);
+
+  // Particles that were already in ID order go back to a plain range
+  compact();
 }
 
 //______________________________________________________________________
@@ -167,7 +223,8 @@ ParticleSubset::sort(ParticleVariableBase* particleIDs)
 void
 ParticleSubset::init()
 {
-  d_particles = 0;
+  d_particles = nullptr;
+  d_first = 0;
   d_allocatedSize = 0;
   d_numExpansions = 0;
 }
@@ -177,8 +234,8 @@ ParticleSubset::init()
 void
 ParticleSubset::resize(particleIndex newSize)
 {
-  // Check for spurious resizes
-  if(d_particles) {
+  // Check for spurious resizes; a populated subset may still be a plain range
+  if(d_particles || d_numParticles != 0) {
     SCI_THROW(InternalError("ParticleSubsets should not be resized after creation", __FILE__, __LINE__));
   }
 
@@ -202,6 +259,14 @@ ParticleSubset::expand( unsigned int minSizeIncrement )
     minSizeIncrement = minAmount;
   }
   d_allocatedSize += minSizeIncrement;
+
+  // A contiguous subset only remembers the reservation for materialize()
+  if( !d_particles ) {
+    if( d_allocatedSize < d_numParticles + minSizeIncrement ) {
+      d_allocatedSize = d_numParticles + minSizeIncrement;
+    }
+    return;
+  }
 #if 0
   if(d_numExpansions++ > 18){
     static ProgressiveWarning warn("Performance warning in ParticleSubset",10);
@@ -224,6 +289,15 @@ ParticleSubset::expand( unsigned int minSizeIncrement )
 particleIndex
 ParticleSubset::addParticles( unsigned int count )
 {
+  // The new particles are indexed by their position in the subset
+  if( !d_particles && ( d_first == 0 || d_numParticles == 0 ) ) {
+    d_first = 0;
+    unsigned int oldsize = d_numParticles;
+    d_numParticles += count;
+    return oldsize;
+  }
+  materialize();
+
   if( d_numParticles + count > d_allocatedSize ) {
     expand( count );
   }
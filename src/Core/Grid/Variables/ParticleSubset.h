@@ -28,6 +28,7 @@
 #include <Core/Util/RefCounted.h>
 #include <Core/Geometry/IntVector.h>
 
+#include <iterator>
 #include <vector>
 #include <iostream>
 
@@ -60,7 +61,11 @@ KEYWORDS
    Particle, ParticleSubset
 
 DESCRIPTION
-   Long description...
+   The set of particle indices of a patch/material.  In the common case
+   the subset is a contiguous range [first, first+n) - no index array is
+   stored and iteration is unit stride.  An explicit index array is only
+   materialized once the subset stops being a contiguous range (a gap in
+   addParticle, set(), sort() into a different order, getPointer()).
   
 WARNING
   
@@ -105,6 +110,18 @@ WARNING
     }
       
     void addParticle( particleIndex idx ) {
+      if( !d_particles ) {
+        // Appending the next index in sequence keeps the range contiguous
+        if( d_numParticles == 0 || idx == d_first + (particleIndex)d_numParticles ) {
+          if( d_numParticles == 0 ) {
+            d_first = idx;
+          }
+          d_numParticles++;
+          return;
+        }
+        materialize();
+      }
+
       if( d_numParticles >= d_allocatedSize ){
         expand( 1 );
       }
@@ -116,26 +133,80 @@ WARNING
 
     void resize(particleIndex idx);
 
-    typedef particleIndex* iterator;
+    //__________________________________
+    //  Random access iterator over the particle indices.  For a contiguous
+    //  subset d_index is null and the position is the particle index itself.
+    class iterator {
+    public:
+      typedef std::random_access_iterator_tag iterator_category;
+      typedef particleIndex                   value_type;
+      typedef std::ptrdiff_t                  difference_type;
+      typedef const particleIndex*            pointer;
+      typedef particleIndex                   reference;
+
+      iterator() : d_index(nullptr), d_pos(0) {}
+      iterator( const particleIndex* index, particleIndex pos ) : d_index(index), d_pos(pos) {}
+
+      particleIndex operator*() const { return d_index ? d_index[d_pos] : d_pos; }
+      particleIndex operator[]( difference_type n ) const { return d_index ? d_index[d_pos + n] : d_pos + (particleIndex)n; }
+
+      iterator& operator++()    { ++d_pos; return *this; }
+      iterator  operator++(int) { iterator tmp(*this); ++d_pos; return tmp; }
+      iterator& operator--()    { --d_pos; return *this; }
+      iterator  operator--(int) { iterator tmp(*this); --d_pos; return tmp; }
+
+      iterator& operator+=( difference_type n ) { d_pos += (particleIndex)n; return *this; }
+      iterator& operator-=( difference_type n ) { d_pos -= (particleIndex)n; return *this; }
+      iterator  operator+( difference_type n ) const { return iterator(d_index, d_pos + (particleIndex)n); }
+      iterator  operator-( difference_type n ) const { return iterator(d_index, d_pos - (particleIndex)n); }
+      difference_type operator-( const iterator& it ) const { return (difference_type)d_pos - it.d_pos; }
+
+      bool operator==( const iterator& it ) const { return d_pos == it.d_pos; }
+      bool operator!=( const iterator& it ) const { return d_pos != it.d_pos; }
+      bool operator< ( const iterator& it ) const { return d_pos <  it.d_pos; }
+      bool operator<=( const iterator& it ) const { return d_pos <= it.d_pos; }
+      bool operator> ( const iterator& it ) const { return d_pos >  it.d_pos; }
+      bool operator>=( const iterator& it ) const { return d_pos >= it.d_pos; }
+
+    private:
+      const particleIndex * d_index;
+      particleIndex         d_pos;
+    };
+
+    iterator begin() const {
+      return d_particles ? iterator(d_particles, 0) : iterator(nullptr, d_first);
+    }
 
-    iterator begin() {
-      return d_particles;
+    iterator end() const {
+      return d_particles ? iterator(d_particles, d_numParticles) : iterator(nullptr, d_first + d_numParticles);
     }
 
-    iterator end() {
-      return d_particles+d_numParticles;
+    // True if the subset is the range [getFirst(), getFirst()+numParticles()),
+    // so loops can index particle variables directly with unit stride.
+    bool isContiguous() const {
+      return d_particles == nullptr;
     }
-      
+
+    particleIndex getFirst() const {
+      return d_particles ? (d_numParticles ? d_particles[0] : 0) : d_first;
+    }
+
+    // Explicit index array (materialized on demand for contiguous subsets)
     particleIndex* getPointer()
     {
+      materialize();
       return d_particles;
     }
+
+    // Add a constant to every index of the subset
+    void shift( particleIndex offset );
       
     unsigned int numParticles() const {
       return d_numParticles;
     }
 
     void set(particleIndex idx, particleIndex value) {
+      materialize();
       d_particles[idx] = value;
     }
 
@@ -175,7 +246,8 @@ WARNING
   //__________________________________
   //
    private:
-    particleIndex * d_particles;
+    particleIndex * d_particles;      // null for a contiguous subset
+    particleIndex   d_first;          // first index of a contiguous subset
     unsigned int    d_numParticles;
     unsigned int    d_allocatedSize;
     int             d_numExpansions;
@@ -191,6 +263,12 @@ WARNING
 
     void init();
 
+    // Switch a contiguous subset to an explicit index array
+    void materialize();
+
+    // Drop the index array again if it turns out to be a contiguous range
+    void compact();
+
     ParticleSubset( const ParticleSubset & copy );
     ParticleSubset& operator=( const ParticleSubset & );
   };
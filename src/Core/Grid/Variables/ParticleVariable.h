@@ -46,6 +46,7 @@
 
 #include <iostream>
 #include <cstring>
+#include <type_traits>
 
 
 namespace Uintah {
@@ -165,6 +166,8 @@ public:
                            const ProcessorGroup* pg,
                            ParticleSubset* pset);
   virtual void emitNormal( std::ostream& out, const IntVector&, const IntVector&, ProblemSpecP, bool outputDoubleAsFloat );
+  virtual bool emitSegments( const IntVector&, const IntVector&, ProblemSpecP varnode, bool outputDoubleAsFloat,
+                             std::vector<EmitSegment>& segments );
   virtual void emitPIDX(       PIDXOutputContext & oc,
                                unsigned char     * buffer,
                          const IntVector         & /* l */,
@@ -550,6 +553,38 @@ template<class T>
     }
   }
 
+  // One segment per run of consecutive particle indices in d_pset.
+  template<class T>
+  bool
+  ParticleVariable<T>::emitSegments( const IntVector                & /* l */,
+                                     const IntVector                & /* h */,
+                                           ProblemSpecP               varnode,
+                                           bool                       outputDoubleAsFloat,
+                                           std::vector<EmitSegment> & segments )
+  {
+    const TypeDescription* td = fun_getTypeDescription((T*)nullptr);
+
+    if( !td->isFlat() || ( outputDoubleAsFloat && std::is_same<T, double>::value ) ) {
+      return false;
+    }
+    if (varnode->findBlock("numParticles") == nullptr) {
+      varnode->appendElement("numParticles", d_pset->numParticles());
+    }
+
+    ParticleSubset::iterator iter = d_pset->begin();
+    while(iter != d_pset->end()){
+      particleIndex start = *iter;
+      iter++;
+      particleIndex end = start+1;
+      while(iter != d_pset->end() && *iter == end) {
+        end++;
+        iter++;
+      }
+      segments.push_back( EmitSegment{ (const char*) &(*this)[start], sizeof(T)*(end-start) } );
+    }
+    return true;
+  }
+
   template<class T>
   void
   ParticleVariable<T>::emitPIDX(       PIDXOutputContext & oc,
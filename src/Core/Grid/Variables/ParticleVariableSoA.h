@@ -0,0 +1,191 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#ifndef UINTAH_HOMEBREW_PARTICLEVARIABLESOA_H
+#define UINTAH_HOMEBREW_PARTICLEVARIABLESOA_H
+
+#include <Core/Geometry/Vector.h>
+#include <Core/Grid/Variables/ParticleSubset.h>
+#include <Core/Grid/Variables/ParticleVariable.h>
+#include <Core/Math/Matrix3.h>
+
+#include <vector>
+
+namespace Uintah {
+
+/**************************************
+
+CLASS
+ParticleVariableSoA
+
+  Structure-of-arrays copy of a Vector or Matrix3 particle variable.
+
+GENERAL INFORMATION
+
+ParticleVariableSoA.h
+
+KEYWORDS
+Particle_Variable, SoA, Vectorization
+
+DESCRIPTION
+  ParticleVariable<Vector> and ParticleVariable<Matrix3> store one struct
+  per particle, so a loop over particles reads each component with a
+  stride of 24 or 72 bytes and the compiler will not vectorize it.  A
+  ParticleVariableSoA holds the same values for the particles of one
+  subset as 3 (or 9) contiguous arrays of doubles, one per component,
+  indexed by position in the subset rather than by particleIndex.
+
+  The usual pattern in a constitutive model is
+
+    ParticleVariableSoA<Matrix3> F(pset, pDefGrad_new);   // gather
+    ParticleVariableSoA<Matrix3> sig(pset->numParticles());
+    const double * F00 = F.component(0, 0);  ...
+    #pragma omp simd
+    for (int i = 0; i < n; i++) { ... }                   // per-particle math
+    sig.scatter(pset, pStress);                           // write back
+
+  and the per-particle views (operator[], get(), set()) keep the scalar
+  tail of a model readable.  The DataWarehouse, MPI and output layouts are
+  unchanged; the SoA copy only lives for the duration of the loop.
+
+WARNING
+  Components of a Matrix3 are numbered row major, (i,j) -> 3*i + j.
+
+****************************************/
+
+template<class T> struct ParticleSoATraits;
+
+template<>
+struct ParticleSoATraits<Vector> {
+  static const int numComponents = 3;
+  static double   get( const Vector & v, int c )         { return v[c]; }
+  static void     set( Vector & v, int c, double value ) { v[c] = value; }
+};
+
+template<>
+struct ParticleSoATraits<Matrix3> {
+  static const int numComponents = 9;
+  static double   get( const Matrix3 & m, int c )         { return m(c / 3, c % 3); }
+  static void     set( Matrix3 & m, int c, double value ) { m(c / 3, c % 3) = value; }
+};
+
+template<class T>
+class ParticleVariableSoA {
+
+public:
+
+  typedef ParticleSoATraits<T> Traits;
+  static const int numComponents = Traits::numComponents;
+
+  // One particle's components; also usable where a T is expected
+  template<class D>
+  class View {
+  public:
+    View( D * first, int stride ) : m_first(first), m_stride(stride) {}
+
+    D & operator[]( int c ) const { return m_first[c * m_stride]; }
+    D & operator()( int i, int j ) const { return m_first[(3 * i + j) * m_stride]; }
+
+    operator T() const
+    {
+      T value;
+      for (int c = 0; c < numComponents; c++) {
+        Traits::set(value, c, m_first[c * m_stride]);
+      }
+      return value;
+    }
+
+    const View & operator=( const T & value ) const
+    {
+      for (int c = 0; c < numComponents; c++) {
+        m_first[c * m_stride] = Traits::get(value, c);
+      }
+      return *this;
+    }
+
+  private:
+    D * m_first;
+    int m_stride;
+  };
+
+  // Zero-filled storage for n particles
+  explicit ParticleVariableSoA( int n )
+    : m_size(n), m_data((size_t)numComponents * n)
+  {}
+
+  // Gather var over the particles of pset
+  ParticleVariableSoA( ParticleSubset * pset, const constParticleVariable<T> & var )
+    : ParticleVariableSoA(pset->numParticles())
+  {
+    gather(pset, var);
+  }
+
+  int size() const { return m_size; }
+
+  // The components are stored back to back: component c starts at
+  // component(0) + c*size()
+
+  double       * component( int c )              { return &m_data[(size_t)c * m_size]; }
+  const double * component( int c ) const        { return &m_data[(size_t)c * m_size]; }
+  double       * component( int i, int j )       { return component(3 * i + j); }
+  const double * component( int i, int j ) const { return component(3 * i + j); }
+
+  View<double>       operator[]( int i )       { return View<double>(&m_data[i], m_size); }
+  View<const double> operator[]( int i ) const { return View<const double>(&m_data[i], m_size); }
+
+  T    get( int i ) const           { return (*this)[i]; }
+  void set( int i, const T & value ) { (*this)[i] = value; }
+
+  void gather( ParticleSubset * pset, const constParticleVariable<T> & var )
+  {
+    int i = 0;
+    for (ParticleSubset::iterator iter = pset->begin(); iter != pset->end(); ++iter, ++i) {
+      const T & value = var[*iter];
+      for (int c = 0; c < numComponents; c++) {
+        m_data[(size_t)c * m_size + i] = Traits::get(value, c);
+      }
+    }
+  }
+
+  void scatter( ParticleSubset * pset, ParticleVariable<T> & var ) const
+  {
+    int i = 0;
+    for (ParticleSubset::iterator iter = pset->begin(); iter != pset->end(); ++iter, ++i) {
+      T & value = var[*iter];
+      for (int c = 0; c < numComponents; c++) {
+        Traits::set(value, c, m_data[(size_t)c * m_size + i]);
+      }
+    }
+  }
+
+private:
+
+  int                 m_size;
+  std::vector<double> m_data;
+};
+
+} // End namespace Uintah
+
+#endif
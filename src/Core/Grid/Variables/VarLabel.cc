@@ -50,6 +50,8 @@ std::string VarLabel::s_default_compression_mode = "none";
 
 std::map<std::string, VarLabel*> VarLabel::g_all_labels;
 
+int VarLabel::s_num_dense_ids = 0;
+
 //______________________________________________________________________
 //
 VarLabel*
@@ -84,6 +86,7 @@ VarLabel::create( const std::string     & name
     }
     else {
       label = scinew VarLabel(name, td, boundaryLayer, vartype);
+      label->m_dense_id = s_num_dense_ids++;
       g_all_labels[name]=label;
       DOUT(g_varlabel_dbg, "Created VarLabel: " << label->m_name << " [address = " << label);
     }
@@ -135,6 +138,14 @@ VarLabel::VarLabel( const std::string             & name
 }
 //______________________________________________________________________
 //
+int
+VarLabel::numDenseIDs()
+{
+  std::lock_guard<MasterLock> dense_ids_lock(g_label_mutex);
+  return s_num_dense_ids;
+}
+//______________________________________________________________________
+//
 void
 VarLabel::printAll()
 {
@@ -142,6 +142,12 @@ public:
 
   static void printAll(); // for debugging
 
+  // Dense id, unique per label and assigned in creation order; used for array indexed lookups (see KeyDatabase::freeze)
+  inline int getDenseID() const { return m_dense_id; }
+
+  // One past the largest dense id handed out so far
+  static int numDenseIDs();
+
   friend std::ostream & operator<<( std::ostream & out, const VarLabel & vl );
 
   //DS 12062019: Store max ghost cell count for this variable across all GPU tasks. update it in dependencies of all gpu tasks before task graph compilation
@@ -150,6 +156,12 @@ public:
   inline Ghost::GhostType getMaxDeviceGhostType() const {return m_max_device_ghost_type;}
   inline void setMaxDeviceGhostType (Ghost::GhostType val) const {m_max_device_ghost_type = val;}
 
+  // Max ghost cell count for this variable across all host tasks, used for halo padded allocation (OnDemandDataWarehouse::s_halo_padded_allocation)
+  inline int getMaxHostGhost() const {return m_max_host_ghost;}
+  inline void setMaxHostGhost(int val) const {m_max_host_ghost = val;}
+  inline Ghost::GhostType getMaxHostGhostType() const {return m_max_host_ghost_type;}
+  inline void setMaxHostGhostType (Ghost::GhostType val) const {m_max_host_ghost_type = val;}
+
 private:
 
   // You must use VarLabel::create.
@@ -174,8 +186,13 @@ private:
   // Allow a variable of this label to be computed multiple times in a TaskGraph without complaining.
   bool                        m_allow_multiple_computes{false};
 
+          int                 m_dense_id{-1};
+  static  int                 s_num_dense_ids;
+
   mutable int                 m_max_device_ghost{0};	//DS 12062019: Store max ghost cell count for this variable across all GPU tasks. update it in dependencies of all gpu tasks before task graph compilation
   mutable Ghost::GhostType    m_max_device_ghost_type{Ghost::None};
+  mutable int                 m_max_host_ghost{0};
+  mutable Ghost::GhostType    m_max_host_ghost_type{Ghost::None};
 
   // eliminate copy, assignment and move
   VarLabel( const VarLabel & )            = delete;
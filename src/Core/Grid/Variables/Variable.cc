@@ -24,16 +24,14 @@
 
 
 #include <Core/Grid/Variables/Variable.h>
-
+#include <Core/Grid/Variables/VariableCodec.h>
 
 #include <Core/Disclosure/TypeDescription.h>
 #include <Core/Exceptions/ErrnoException.h>
-#include <Core/Exceptions/InvalidCompressionMode.h>
 #include <Core/Grid/Patch.h>
 #include <Core/Malloc/Allocator.h>
 #include <Core/Util/Endian.h>
 #include <Core/Util/FancyAssert.h>
-#include <Core/Util/SizeTypeConvert.h>
 
 #include <CCA/Ports/InputContext.h>
 #include <CCA/Ports/OutputContext.h>
@@ -41,16 +39,113 @@
 
 #include <cmath>
 #include <cerrno>
+#include <climits>
 #include <cstdio>
 #include <cstring>
 #include <iostream>
 #include <sstream>
 
-#include <zlib.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+
+#ifndef IOV_MAX
+#  define IOV_MAX 1024
+#endif
 
 
 using namespace Uintah;
 
+namespace {
+
+//______________________________________________________________________
+// Writes the segments with writev, IOV_MAX at a time, resuming after
+// partial writes.  Appends them instead when the context has a buffer.
+void
+writeSegments(       OutputContext                         & oc
+             , const std::vector<Variable::EmitSegment>    & segments
+             )
+{
+  if (oc.buffer) {
+    for (const Variable::EmitSegment& seg : segments) {
+      oc.buffer->append(seg.data, seg.size);
+    }
+    return;
+  }
+
+  std::vector<struct iovec> iov;
+  iov.reserve(std::min(segments.size(), (size_t)IOV_MAX));
+
+  size_t next = 0;
+  while (next < segments.size()) {
+    iov.clear();
+    for (; next < segments.size() && iov.size() < (size_t)IOV_MAX; ++next) {
+      iov.push_back({ const_cast<char*>(segments[next].data), segments[next].size });
+    }
+
+    struct iovec* v = iov.data();
+    int           n = (int)iov.size();
+    while (n > 0) {
+      ssize_t s = ::writev(oc.fd, v, n);
+      if (s < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        std::cerr << "\nVariable::emit - writev system call failed writing to " << oc.filename << " with errno " << errno << ": "
+                  << strerror(errno) << std::endl;
+        SCI_THROW(ErrnoException("Variable::emit (writev call)", errno, __FILE__, __LINE__));
+      }
+      while (n > 0 && (size_t)s >= v->iov_len) {
+        s -= v->iov_len;
+        ++v;
+        --n;
+      }
+      if (n > 0) {
+        v->iov_base = (char*)v->iov_base + s;
+        v->iov_len -= s;
+      }
+    }
+  }
+}
+
+//______________________________________________________________________
+// Width of the scalars the variable is written as, for the shuffling
+// codecs; 1 when unknown.
+size_t
+scalarWidth( const TypeDescription * td
+           ,       bool              outputDoubleAsFloat
+           )
+{
+  const TypeDescription* sub = td ? td->getSubType() : nullptr;
+  if (sub == nullptr) {
+    return 1;
+  }
+
+  switch (sub->getType()) {
+    case TypeDescription::double_type :
+      return outputDoubleAsFloat ? sizeof(float) : sizeof(double);
+    case TypeDescription::Point :
+    case TypeDescription::Vector :
+    case TypeDescription::Matrix3 :
+    case TypeDescription::Stencil4 :
+    case TypeDescription::Stencil7 :
+      return sizeof(double);
+    case TypeDescription::long64_type :
+    case TypeDescription::long_type :
+      return sizeof(long);
+    case TypeDescription::float_type :
+    case TypeDescription::int_type :
+    case TypeDescription::IntVector :
+      return sizeof(int);
+    case TypeDescription::short_int_type :
+      return sizeof(short);
+    default :
+      return 1;
+  }
+}
+
+} // namespace
+
 
 //______________________________________________________________________
 //
@@ -83,64 +178,43 @@ Variable::emit(       OutputContext & oc
               , const std::string   & compressionModeHint
               )
 {
-  bool use_gzip = false;
-  bool used_gzip = false;
-  if (compressionModeHint == "gzip") {
-    use_gzip = true;
-  }
-  else if (compressionModeHint != "" && compressionModeHint != "none") {
-    std::cout << "Invalid Compression Mode - throwing exception...\n";
-    SCI_THROW(InvalidCompressionMode(compressionModeHint, "", __FILE__, __LINE__));
+  const VariableCodec* codec = VariableCodec::find(compressionModeHint);
+
+  // Write straight from the variable's storage when it can describe
+  // its data as contiguous runs, otherwise from emitNormal's stream.
+  std::vector<EmitSegment> segments;
+  std::string              staged;
+
+  if (!emitSegments(l, h, oc.varnode, oc.outputDoubleAsFloat, segments)) {
+    std::ostringstream outstream;
+    emitNormal(outstream, l, h, oc.varnode, oc.outputDoubleAsFloat);
+    staged = outstream.str();
+    segments.assign(1, EmitSegment{ staged.data(), staged.size() });
   }
 
-  used_gzip = use_gzip;
-
-  std::ostringstream outstream;
-  emitNormal(outstream, l, h, oc.varnode, oc.outputDoubleAsFloat);
-
-  std::string preGzip = outstream.str();
-  std::string buffer;  // trying to avoid copying the strings back and forth
-  std::string* writeoutString = &preGzip;
-
-  if (use_gzip) {
-    writeoutString = gzipCompress(&preGzip, &buffer);
-    if (writeoutString != &buffer) {
-      used_gzip = false;  // gzip wasn't better, so it wasn't used
-    }
+  size_t rawSize = 0;
+  for (const EmitSegment& seg : segments) {
+    rawSize += seg.size;
   }
 
-  errno = -1;
-  const char* writebuffer = (*writeoutString).c_str();
-  size_t writebufferSize = (*writeoutString).size();
-  if (writebufferSize > 0) {
-    ssize_t s = ::write(oc.fd, writebuffer, writebufferSize);
-
-    if (s != (long)writebufferSize) {
-      std::cerr << "\nVariable::emit - write system call failed writing to " << oc.filename << " with errno " << errno << ": "
-                << strerror(errno) << std::endl;
-      std::cerr << " * wanted to write: " << writebufferSize << ", but actually wrote " << s << "\n\n";
-
-      SCI_THROW(ErrnoException("Variable::emit (write call)", errno, __FILE__, __LINE__));
-    }
-    oc.cur += writebufferSize;
+  // Left uncompressed, and not marked as compressed, if the codec
+  // does not make it smaller.
+  std::string compressed;
+  if (codec && rawSize > 0 &&
+      codec->compress(segments, rawSize, scalarWidth(virtualGetTypeDescription(), oc.outputDoubleAsFloat), compressed)) {
+    segments.assign(1, EmitSegment{ compressed.data(), compressed.size() });
+    oc.varnode->appendElement("compression", compressionModeHint);
   }
 
-  std::string compressionMode = compressionModeHint;
-  if (used_gzip != use_gzip) {
-    // compression mode string changes
-    if (used_gzip) {
-      compressionMode = "gzip";
-    }
-    else {
-      compressionMode = "";
-    }
+  size_t written = 0;
+  for (const EmitSegment& seg : segments) {
+    written += seg.size;
   }
 
-  if (compressionMode != "" && compressionMode != "none") {
-    oc.varnode->appendElement("compression", compressionMode);
-  }
+  writeSegments(oc, segments);
+  oc.cur += written;
 
-  return writebufferSize;
+  return written;
 }
 
 //______________________________________________________________________
@@ -179,43 +253,6 @@ Variable::emitPIDX(       PIDXOutputContext & /* oc */
 }
 #endif
 
-//______________________________________________________________________
-//
-std::string*
-Variable::gzipCompress( std::string* pUncompressed
-                      , std::string* pBuffer
-                      )
-{
-  unsigned long uncompressedSize = pUncompressed->size();
-
-  // follows compress guidelines: 1% more than source size + 12 (round up, so use + 13).
-  unsigned long compressBufsize = uncompressedSize * 101 / 100 + 13;
-
-  pBuffer->resize(compressBufsize + sizeof(ssize_t));
-  char* buf = const_cast<char*>(pBuffer->c_str());  // casting from const
-  buf += sizeof(ssize_t);  // the first part will give the size of the uncompressed data
-
-  if (compress((Bytef*)buf, &compressBufsize, (const Bytef*)pUncompressed->c_str(), uncompressedSize) != Z_OK)
-    std::cerr << "compress failed in Uintah::Variable::gzipCompress\n";
-
-  pBuffer->resize(compressBufsize + sizeof(ssize_t));
-  if (pBuffer->size() > uncompressedSize) {
-    // gzip made it worse -- forget that (this should rarely, if ever, happen, but just in case)
-    pBuffer->erase();  // the other buffer isn't needed, erase it to save space
-    return pUncompressed;
-  }
-  else {
-    // write out the uncompressed size to the first part of the buffer
-    char* pbyte = (char*)(&uncompressedSize);
-    for (int i = 0; i < (int)sizeof(ssize_t); i++, pbyte++) {
-      (*pBuffer)[i] = *pbyte;
-    }
-    pUncompressed->erase(); // the original buffer isn't needed, erase it to save space
-
-    return pBuffer;
-  }
-}
-
 //______________________________________________________________________
 //
 void
@@ -226,14 +263,7 @@ Variable::read(       InputContext & ic
               , const std::string  & compressionMode
               )
 {
-  bool use_gzip = false;
-
-  if (compressionMode == "gzip") {
-    use_gzip = true;
-  }
-  else if (compressionMode != "" && compressionMode != "none") {
-    SCI_THROW(InvalidCompressionMode(compressionMode, "", __FILE__, __LINE__));
-  }
+  const VariableCodec* codec = VariableCodec::find(compressionMode);
 
   long datasize = end - ic.cur;
 
@@ -260,40 +290,9 @@ Variable::read(       InputContext & ic
     ic.cur += datasize;
 
     //__________________________________
-    // gzip compression
-    if (use_gzip) {
-
-      // first read the uncompressed data size
-      std::istringstream compressedStream(data);
-      uint64_t uncompressed_size_64;
-      compressedStream.read((char*)&uncompressed_size_64, nByteMode);
-
-      unsigned long uncompressed_size = convertSizeType(&uncompressed_size_64, swapBytes, nByteMode);
-      if (uncompressed_size > 1000000000) {
-        std::cout << "\n";
-        std::cout << "--------------------------------------------------------------------------\n";
-        std::cout << "!!!!!!!! WARNING !!!!!!!! \n";
-        std::cout << "\n";
-        std::cout << "Size of uncompressed variable seems wrong: " << uncompressed_size << "\n";
-        std::cout << "Most likely, the UDA you are trying to read is corrupted due to a problem with\n";
-        std::cout << "libz when it was created... Also, an exception most likely is about to be thrown...\n";
-        std::cout << "--------------------------------------------------------------------------\n";
-        std::cout << "\n\n";
-      }
-
-      const char* compressed_data = data.c_str() + nByteMode;
-      long compressed_datasize = datasize - (long)(nByteMode);
-
-      // casting from const char* below to char* -- use caution
-      bufferStr.resize(uncompressed_size);
-      char* buffer = (char*)bufferStr.c_str();
-
-      int result = uncompress((Bytef*)buffer, &uncompressed_size, (const Bytef*)compressed_data, compressed_datasize);
-      if (result != Z_OK) {
-        printf("Uncompress error result is %d\n", result);
-        throw InternalError("uncompress failed in Uintah::Variable::read", __FILE__, __LINE__);
-      }
-
+    // compressed
+    if (codec) {
+      codec->decompress(data.data(), datasize, swapBytes, nByteMode, bufferStr);
       uncompressedData = &bufferStr;
     }
 
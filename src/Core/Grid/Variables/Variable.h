@@ -31,6 +31,7 @@
 
 #include <string>
 #include <iosfwd>
+#include <vector>
 
 namespace Uintah {
 
@@ -126,6 +127,26 @@ public:
 
   virtual void readNormal( std::istream& in, bool swapbytes ) = 0;
 
+  // A run of bytes in the variable's own storage.
+  struct EmitSegment {
+    const char * data;
+    size_t       size;
+  };
+
+  // Describes the bytes emitNormal would produce as runs into the
+  // variable's storage so emit can write them without staging
+  // copies. Returns false when the data has to be converted and
+  // emitNormal must be used.
+  virtual bool emitSegments( const IntVector                & /* l */
+                           , const IntVector                & /* h */
+                           ,       ProblemSpecP               /* varnode */
+                           ,       bool                       /* outputDoubleAsFloat */
+                           ,       std::vector<EmitSegment> & /* segments */
+                           )
+  {
+    return false;
+  }
+
   virtual void allocate( const Patch* patch, const IntVector& boundary ) = 0;
 
   virtual void getSizeInfo( std::string& elems, unsigned long& totsize, void*& ptr ) const = 0;
@@ -157,13 +178,6 @@ private:
   Variable( Variable && )                 = delete;
   Variable& operator=( Variable && )      = delete;
 
-  // Compresses the string pointed to by pUncompressed and but the resulting
-  // compressed data into the string pointed to by pBuffer.
-  // Returns the pointer to whichever one is shortest and erases the  other one.
-  std::string* gzipCompress( std::string* pUncompressed
-                           , std::string* pBuffer
-                           );
-
   // states that the variable is from another node - these variables (ghost cells, slabs, corners) are communicated via MPI
   bool d_foreign {false};
 
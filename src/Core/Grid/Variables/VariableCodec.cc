@@ -0,0 +1,445 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <Core/Grid/Variables/VariableCodec.h>
+
+#include <Core/Exceptions/InternalError.h>
+#include <Core/Exceptions/InvalidCompressionMode.h>
+#include <Core/Util/Endian.h>
+#include <Core/Util/SizeTypeConvert.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+
+#include <zlib.h>
+
+using namespace Uintah;
+
+namespace {
+
+int s_numThreads = 1;
+
+//______________________________________________________________________
+// The original format: the uncompressed size (sizeof(ssize_t) bytes)
+// followed by a single zlib stream, deflated chunk by chunk straight
+// from the segments.
+class GzipCodec : public VariableCodec {
+
+public:
+
+  virtual bool compress( const std::vector<Variable::EmitSegment> & segments
+                       ,       size_t                               uncompressedSize
+                       ,       size_t                               /* elementSize */
+                       ,       std::string                        & compressed
+                       ) const
+  {
+    const size_t header = sizeof(ssize_t);
+    const size_t chunk  = 1 << 20;
+
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    if (deflateInit(&zs, Z_DEFAULT_COMPRESSION) != Z_OK) {
+      std::cerr << "deflateInit failed in Uintah::GzipCodec::compress\n";
+      return false;
+    }
+
+    compressed.resize(header + std::min(chunk, uncompressedSize));
+
+    bool fits = true;
+
+    // Makes room for more output; false once the output is no smaller.
+    auto grow = [&]() {
+      size_t used = header + zs.total_out;
+      if (used >= uncompressedSize) {
+        return false;
+      }
+      if (used == compressed.size()) {
+        compressed.resize(std::min(compressed.size() * 2, uncompressedSize));
+      }
+      zs.next_out  = (Bytef*)&compressed[used];
+      zs.avail_out = (uInt)std::min(compressed.size() - used, (size_t)UINT_MAX);
+      return true;
+    };
+
+    for (size_t i = 0; fits && i < segments.size(); ++i) {
+      const char* data = segments[i].data;
+      size_t      left = segments[i].size;
+      while (fits && left > 0) {
+        zs.next_in  = (Bytef*)data;
+        zs.avail_in = (uInt)std::min(left, chunk);
+        size_t fed  = zs.avail_in;
+        while (zs.avail_in > 0) {
+          if (zs.avail_out == 0 && !(fits = grow())) {
+            break;
+          }
+          deflate(&zs, Z_NO_FLUSH);
+        }
+        data += fed;
+        left -= fed;
+      }
+    }
+
+    int status = Z_OK;
+    while (fits && status != Z_STREAM_END) {
+      if (zs.avail_out == 0 && !(fits = grow())) {
+        break;
+      }
+      status = deflate(&zs, Z_FINISH);
+      if (status == Z_STREAM_ERROR) {
+        std::cerr << "deflate failed in Uintah::GzipCodec::compress\n";
+        fits = false;
+      }
+    }
+
+    fits = fits && header + zs.total_out < uncompressedSize;
+    size_t total = header + zs.total_out;
+    deflateEnd(&zs);
+
+    if (!fits) {
+      std::string().swap(compressed);
+      return false;
+    }
+
+    compressed.resize(total);
+
+    unsigned long size = uncompressedSize;
+    memcpy(&compressed[0], &size, header);
+    return true;
+  }
+
+  virtual void decompress( const char        * compressed
+                         ,       size_t        compressedSize
+                         ,       bool          swapBytes
+                         ,       int           nByteMode
+                         ,       std::string & uncompressed
+                         ) const
+  {
+    // first read the uncompressed data size
+    uint64_t uncompressed_size_64 = 0;
+    memcpy(&uncompressed_size_64, compressed, nByteMode);
+
+    unsigned long uncompressed_size = convertSizeType(&uncompressed_size_64, swapBytes, nByteMode);
+    if (uncompressed_size > 1000000000) {
+      std::cout << "\n";
+      std::cout << "--------------------------------------------------------------------------\n";
+      std::cout << "!!!!!!!! WARNING !!!!!!!! \n";
+      std::cout << "\n";
+      std::cout << "Size of uncompressed variable seems wrong: " << uncompressed_size << "\n";
+      std::cout << "Most likely, the UDA you are trying to read is corrupted due to a problem with\n";
+      std::cout << "libz when it was created... Also, an exception most likely is about to be thrown...\n";
+      std::cout << "--------------------------------------------------------------------------\n";
+      std::cout << "\n\n";
+    }
+
+    uncompressed.resize(uncompressed_size);
+
+    int result = uncompress((Bytef*)&uncompressed[0], &uncompressed_size, (const Bytef*)compressed + nByteMode,
+                            compressedSize - nByteMode);
+    if (result != Z_OK) {
+      printf("Uncompress error result is %d\n", result);
+      throw InternalError("uncompress failed in Uintah::Variable::read", __FILE__, __LINE__);
+    }
+  }
+};
+
+//______________________________________________________________________
+// Independent zlib streams of CHUNK bytes each (the last one shorter),
+// optionally byte-shuffled first:
+//
+//   uint64_t  uncompressed size
+//   uint32_t  chunk size, shuffle width (1 - not shuffled), number of chunks
+//   uint64_t  compressed size of each chunk
+//   the compressed chunks
+//
+// The header is in the writer's byte order.
+class ChunkedDeflateCodec : public VariableCodec {
+
+public:
+
+  ChunkedDeflateCodec( bool shuffle, int level ) : m_shuffle( shuffle ), m_level( level ) {}
+
+  virtual bool compress( const std::vector<Variable::EmitSegment> & segments
+                       ,       size_t                               rawSize
+                       ,       size_t                               elementSize
+                       ,       std::string                        & compressed
+                       ) const
+  {
+    const uint32_t width     = ( m_shuffle && elementSize > 1 ) ? (uint32_t)elementSize : 1;
+    const uint32_t chunkSize = ( CHUNK / width ) * width;
+    const uint32_t numChunks = (uint32_t)( ( rawSize + chunkSize - 1 ) / chunkSize );
+
+    // Where each segment starts in the uncompressed stream.
+    std::vector<size_t> starts( segments.size() + 1, 0 );
+    for (size_t s = 0; s < segments.size(); ++s) {
+      starts[s + 1] = starts[s] + segments[s].size;
+    }
+
+    std::vector<std::string> chunks( numChunks );
+    bool failed = false;
+
+    const int threads = std::max( 1, std::min( s_numThreads, (int)numChunks ) );
+
+#pragma omp parallel for num_threads(threads) schedule(dynamic) reduction(||:failed) if(threads > 1)
+    for (int c = 0; c < (int)numChunks; ++c) {
+      const size_t begin = (size_t)c * chunkSize;
+      const size_t size  = std::min( (size_t)chunkSize, rawSize - begin );
+
+      // Gather the chunk from the segments it spans.
+      std::string raw( size, '\0' );
+      size_t s = std::upper_bound( starts.begin(), starts.end(), begin ) - starts.begin() - 1;
+      for (size_t done = 0; done < size; ++s) {
+        const size_t offset = begin + done - starts[s];
+        const size_t n      = std::min( segments[s].size - offset, size - done );
+        memcpy( &raw[done], segments[s].data + offset, n );
+        done += n;
+      }
+
+      if (width > 1) {
+        std::string shuffled( size, '\0' );
+        shuffle( raw.data(), &shuffled[0], size, width );
+        raw.swap( shuffled );
+      }
+
+      uLongf bound = compressBound( size );
+      chunks[c].resize( bound );
+      if (compress2( (Bytef*)&chunks[c][0], &bound, (const Bytef*)raw.data(), size, m_level ) != Z_OK) {
+        failed = true;
+      }
+      chunks[c].resize( bound );
+    }
+
+    if (failed) {
+      std::cerr << "compress2 failed in Uintah::ChunkedDeflateCodec::compress\n";
+      return false;
+    }
+
+    size_t total = sizeof(uint64_t) + 3 * sizeof(uint32_t) + numChunks * sizeof(uint64_t);
+    for (const std::string & chunk : chunks) {
+      total += chunk.size();
+    }
+    if (total >= rawSize) {
+      return false;
+    }
+
+    compressed.clear();
+    compressed.reserve( total );
+
+    auto put = [&]( const void * value, size_t size ) { compressed.append( (const char*)value, size ); };
+
+    uint64_t size64 = rawSize;
+    put( &size64,    sizeof(size64) );
+    put( &chunkSize, sizeof(chunkSize) );
+    put( &width,     sizeof(width) );
+    put( &numChunks, sizeof(numChunks) );
+    for (const std::string & chunk : chunks) {
+      uint64_t chunkBytes = chunk.size();
+      put( &chunkBytes, sizeof(chunkBytes) );
+    }
+    for (std::string & chunk : chunks) {
+      compressed.append( chunk );
+      std::string().swap( chunk );
+    }
+    return true;
+  }
+
+  virtual void decompress( const char        * compressed
+                         ,       size_t        compressedSize
+                         ,       bool          swapBytes
+                         ,       int           /* nByteMode */
+                         ,       std::string & uncompressed
+                         ) const
+  {
+    size_t pos = 0;
+    auto get = [&]( void * value, size_t size ) {
+      if (compressedSize - pos < size) {
+        throw InternalError( "Truncated chunk header in Uintah::ChunkedDeflateCodec::decompress", __FILE__, __LINE__ );
+      }
+      memcpy( value, compressed + pos, size );
+      pos += size;
+    };
+
+    uint64_t rawSize;
+    uint32_t chunkSize, width, numChunks;
+    get( &rawSize,   sizeof(rawSize) );
+    get( &chunkSize, sizeof(chunkSize) );
+    get( &width,     sizeof(width) );
+    get( &numChunks, sizeof(numChunks) );
+    if (swapBytes) {
+      swapbytes( rawSize );
+      swapbytes( chunkSize );
+      swapbytes( width );
+      swapbytes( numChunks );
+    }
+
+    if (chunkSize == 0 || width == 0 || numChunks != ( rawSize + chunkSize - 1 ) / chunkSize) {
+      throw InternalError( "Corrupt chunk header in Uintah::ChunkedDeflateCodec::decompress", __FILE__, __LINE__ );
+    }
+
+    // Where each compressed chunk starts.
+    std::vector<size_t> offsets( numChunks + 1 );
+    offsets[0] = pos + numChunks * sizeof(uint64_t);
+    for (uint32_t c = 0; c < numChunks; ++c) {
+      uint64_t chunkBytes;
+      get( &chunkBytes, sizeof(chunkBytes) );
+      if (swapBytes) {
+        swapbytes( chunkBytes );
+      }
+      offsets[c + 1] = offsets[c] + chunkBytes;
+    }
+    if (offsets[numChunks] > compressedSize) {
+      throw InternalError( "Truncated chunks in Uintah::ChunkedDeflateCodec::decompress", __FILE__, __LINE__ );
+    }
+
+    uncompressed.resize( rawSize );
+    bool failed = false;
+
+    const int threads = std::max( 1, std::min( s_numThreads, (int)numChunks ) );
+
+#pragma omp parallel for num_threads(threads) schedule(dynamic) reduction(||:failed) if(threads > 1)
+    for (int c = 0; c < (int)numChunks; ++c) {
+      const size_t begin = (size_t)c * chunkSize;
+      const size_t size  = std::min( (size_t)chunkSize, (size_t)rawSize - begin );
+
+      std::string shuffled;
+      char * dst = &uncompressed[begin];
+      if (width > 1) {
+        shuffled.resize( size );
+        dst = &shuffled[0];
+      }
+
+      uLongf length = size;
+      int result = uncompress( (Bytef*)dst, &length, (const Bytef*)compressed + offsets[c], offsets[c + 1] - offsets[c] );
+      if (result != Z_OK || length != size) {
+        failed = true;
+      }
+      else if (width > 1) {
+        unshuffle( shuffled.data(), &uncompressed[begin], size, width );
+      }
+    }
+
+    if (failed) {
+      throw InternalError( "uncompress failed in Uintah::ChunkedDeflateCodec::decompress", __FILE__, __LINE__ );
+    }
+  }
+
+private:
+
+  static const uint32_t CHUNK = 1 << 20;
+
+  // Byte b of every element goes to the b-th of 'width' planes; a
+  // trailing partial element is copied as is.
+  static void shuffle( const char * in, char * out, size_t size, size_t width )
+  {
+    const size_t n = size / width;
+    for (size_t b = 0; b < width; ++b) {
+      for (size_t i = 0; i < n; ++i) {
+        out[b * n + i] = in[i * width + b];
+      }
+    }
+    memcpy( out + n * width, in + n * width, size - n * width );
+  }
+
+  static void unshuffle( const char * in, char * out, size_t size, size_t width )
+  {
+    const size_t n = size / width;
+    for (size_t b = 0; b < width; ++b) {
+      for (size_t i = 0; i < n; ++i) {
+        out[i * width + b] = in[b * n + i];
+      }
+    }
+    memcpy( out + n * width, in + n * width, size - n * width );
+  }
+
+  const bool m_shuffle;
+  const int  m_level;
+};
+
+//______________________________________________________________________
+//
+std::map<std::string, std::unique_ptr<VariableCodec> > &
+getRegistry()
+{
+  static std::map<std::string, std::unique_ptr<VariableCodec> > registry = []() {
+    std::map<std::string, std::unique_ptr<VariableCodec> > codecs;
+    codecs["gzip"].reset(                 new GzipCodec() );
+    codecs["deflate"].reset(              new ChunkedDeflateCodec( false, Z_DEFAULT_COMPRESSION ) );
+    codecs["deflate-fast"].reset(         new ChunkedDeflateCodec( false, Z_BEST_SPEED ) );
+    codecs["shuffle-deflate"].reset(      new ChunkedDeflateCodec( true,  Z_DEFAULT_COMPRESSION ) );
+    codecs["shuffle-deflate-fast"].reset( new ChunkedDeflateCodec( true,  Z_BEST_SPEED ) );
+    return codecs;
+  }();
+
+  return registry;
+}
+
+} // namespace
+
+
+//______________________________________________________________________
+//
+const VariableCodec *
+VariableCodec::find( const std::string & mode )
+{
+  if (mode == "" || mode == "none") {
+    return nullptr;
+  }
+
+  auto & registry = getRegistry();
+  auto   iter     = registry.find( mode );
+
+  if (iter == registry.end()) {
+    SCI_THROW( InvalidCompressionMode( mode, "", __FILE__, __LINE__ ) );
+  }
+  return iter->second.get();
+}
+
+//______________________________________________________________________
+// Not synchronized with find(); register codecs during problem setup.
+void
+VariableCodec::registerCodec( const std::string & mode, VariableCodec * codec )
+{
+  getRegistry()[mode].reset( codec );
+}
+
+//______________________________________________________________________
+//
+void
+VariableCodec::setNumThreads( int numThreads )
+{
+  s_numThreads = std::max( 1, numThreads );
+}
+
+//______________________________________________________________________
+//
+int
+VariableCodec::getNumThreads()
+{
+  return s_numThreads;
+}
@@ -0,0 +1,102 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef CORE_GRID_VARIABLES_VARIABLECODEC_H
+#define CORE_GRID_VARIABLES_VARIABLECODEC_H
+
+#include <Core/Grid/Variables/Variable.h>
+
+#include <string>
+#include <vector>
+
+namespace Uintah {
+
+  /**************************************
+
+     CLASS
+       VariableCodec
+
+       Compression of the bytes Variable::emit writes for a variable.
+
+     DESCRIPTION
+       A codec is selected by the compression mode of a label, set
+       with <DataArchiver><compression> or <save compression="...">,
+       and recorded per variable in the pxxxxx.xml file so that
+       Variable::read finds the same codec again. Codecs are looked
+       up by name, so a new one is added with registerCodec().
+
+       Built in:
+         gzip                  - one zlib stream, the original format.
+         deflate               - zlib in independent 1 MB chunks.
+         deflate-fast          - as deflate at the fastest zlib level.
+         shuffle-deflate       - chunks byte-shuffled by the width of
+                                 the variable's scalars before deflate,
+                                 which groups the slowly varying sign
+                                 and exponent bytes of doubles.
+         shuffle-deflate-fast  - both.
+
+       The chunks of the chunked codecs are compressed and
+       decompressed on up to getNumThreads() OpenMP threads.
+
+  ****************************************/
+
+  class VariableCodec {
+
+  public:
+
+    virtual ~VariableCodec() {}
+
+    // The codec for a compression mode, nullptr for "" and "none".
+    // Throws InvalidCompressionMode for an unknown mode.
+    static const VariableCodec * find( const std::string & mode );
+
+    // Makes 'codec' available as 'mode'; the registry owns it.
+    static void registerCodec( const std::string & mode, VariableCodec * codec );
+
+    // Threads a single variable is (de)compressed with, default 1.
+    static void setNumThreads( int numThreads );
+    static int  getNumThreads();
+
+    // Compresses the concatenated segments (rawSize bytes of scalars
+    // elementSize bytes wide) into 'compressed'. Returns false, with
+    // 'compressed' empty, if the result would not be smaller.
+    virtual bool compress( const std::vector<Variable::EmitSegment> & segments
+                         ,       size_t                               rawSize
+                         ,       size_t                               elementSize
+                         ,       std::string                        & compressed
+                         ) const = 0;
+
+    // Inverse of compress(). 'swapBytes' and 'nByteMode' describe the
+    // machine that wrote the data.
+    virtual void decompress( const char        * compressed
+                           ,       size_t        compressedSize
+                           ,       bool          swapBytes
+                           ,       int           nByteMode
+                           ,       std::string & uncompressed
+                           ) const = 0;
+  };
+
+} // namespace Uintah
+
+#endif // CORE_GRID_VARIABLES_VARIABLECODEC_H
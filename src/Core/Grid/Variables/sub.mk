@@ -42,6 +42,7 @@ SRCS += \
         $(SRCDIR)/ComputeSet.cc                 \
         $(SRCDIR)/ComputeSet_special.cc         \
         $(SRCDIR)/GridVariableBase.cc           \
+        $(SRCDIR)/HostMemoryPool.cc             \
         $(SRCDIR)/LocallyComputedPatchVarMap.cc \
         $(SRCDIR)/ParticleSubset.cc             \
         $(SRCDIR)/ParticleVariableBase.cc       \
@@ -58,7 +59,8 @@ SRCS += \
         $(SRCDIR)/Utils.cc                      \
         $(SRCDIR)/ugc_templates.cc              \
         $(SRCDIR)/VarLabel.cc                   \
-        $(SRCDIR)/Variable.cc                   
+        $(SRCDIR)/Variable.cc                   \
+        $(SRCDIR)/VariableCodec.cc
 
 #HAVE_PIDX
 ifeq ($(HAVE_PIDX),yes)
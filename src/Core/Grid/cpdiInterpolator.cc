@@ -66,6 +66,36 @@ int cpdiInterpolator::findCellAndWeights(const Point& pos,
                                             vector<IntVector>& ni, 
                                             vector<double>& S,
                                             const Matrix3& size)
+{
+  return findCellAndWeights(pos, &ni[0], &S[0], size, 1);
+}
+
+//______________________________________________________________________
+//  Batched version.  The lcrit scaling branches per particle, so this does
+//  not vectorize across particles, but it writes straight into the block
+//  with no vectors or virtual calls per particle.
+int cpdiInterpolator::findCellsAndWeights(const int n,
+                                          const Point* pos,
+                                          const Matrix3* psize,
+                                          IntVector* ni,
+                                          double* S)
+{
+  // Every particle fills all 64 rows
+  int rows = 0;
+  for (int p = 0; p < n; p++) {
+    int NN = findCellAndWeights(pos[p], ni + p, S + p, psize[p], n);
+    rows = max(rows, NN);
+  }
+  return rows;
+}
+
+//______________________________________________________________________
+//
+int cpdiInterpolator::findCellAndWeights(const Point& pos,
+                                         IntVector* ni,
+                                         double* S,
+                                         const Matrix3& size,
+                                         const int stride)
 {
   Point cellpos = d_patch->getLevel()->positionToIndex(Point(pos));
 
@@ -201,14 +231,14 @@ int cpdiInterpolator::findCellAndWeights(const Point& pos,
     iy = Floor(current_corner_pos.y());
     iz = Floor(current_corner_pos.z());
 
-    ni[i8]  = IntVector(ix  , iy  , iz  ); // x1    , y1    , z1
-    ni[i81] = IntVector(ix+1, iy  , iz  ); // x1+r1x, y1    , z1
-    ni[i82] = IntVector(ix+1, iy+1, iz  ); // x1+r1x, y1+r2y, z1
-    ni[i83] = IntVector(ix  , iy+1, iz  ); // x1    , y1+r2y, z1
-    ni[i84] = IntVector(ix  , iy  , iz+1); // x1    , y1    , z1+r3z
-    ni[i85] = IntVector(ix+1, iy  , iz+1); // x1+r1x, y1    , z1+r3z
-    ni[i86] = IntVector(ix+1, iy+1, iz+1); // x1+r1x, y1+r2y, z1+r3z
-    ni[i87] = IntVector(ix  , iy+1, iz+1); // x1    , y1+r2y, z1+r3z
+    ni[i8*stride]  = IntVector(ix  , iy  , iz  ); // x1    , y1    , z1
+    ni[i81*stride] = IntVector(ix+1, iy  , iz  ); // x1+r1x, y1    , z1
+    ni[i82*stride] = IntVector(ix+1, iy+1, iz  ); // x1+r1x, y1+r2y, z1
+    ni[i83*stride] = IntVector(ix  , iy+1, iz  ); // x1    , y1+r2y, z1
+    ni[i84*stride] = IntVector(ix  , iy  , iz+1); // x1    , y1    , z1+r3z
+    ni[i85*stride] = IntVector(ix+1, iy  , iz+1); // x1+r1x, y1    , z1+r3z
+    ni[i86*stride] = IntVector(ix+1, iy+1, iz+1); // x1+r1x, y1+r2y, z1+r3z
+    ni[i87*stride] = IntVector(ix  , iy+1, iz+1); // x1    , y1+r2y, z1+r3z
 
     fx = current_corner_pos.x()-ix;
     fy = current_corner_pos.y()-iy;
@@ -226,14 +256,14 @@ int cpdiInterpolator::findCellAndWeights(const Point& pos,
     phi[6] = fx *fy *fz;  // x1+r1x, y1+r2y, z1+r3z
     phi[7] = fx1*fy *fz;  // x1    , y1+r2y, z1+r3z
 
-    S[i8]  = one_over_8*phi[0];
-    S[i81] = one_over_8*phi[1];
-    S[i82] = one_over_8*phi[2];
-    S[i83] = one_over_8*phi[3];
-    S[i84] = one_over_8*phi[4];
-    S[i85] = one_over_8*phi[5];
-    S[i86] = one_over_8*phi[6];
-    S[i87] = one_over_8*phi[7];
+    S[i8*stride]  = one_over_8*phi[0];
+    S[i81*stride] = one_over_8*phi[1];
+    S[i82*stride] = one_over_8*phi[2];
+    S[i83*stride] = one_over_8*phi[3];
+    S[i84*stride] = one_over_8*phi[4];
+    S[i85*stride] = one_over_8*phi[5];
+    S[i86*stride] = one_over_8*phi[6];
+    S[i87*stride] = one_over_8*phi[7];
   }
   return 64;
 }
@@ -43,6 +43,17 @@ namespace Uintah {
     virtual int findCellAndWeights(const Point& p,vector<IntVector>& ni, 
                                     vector<double>& S, const Matrix3& size);
 
+    // The radial weighting lives in the per-particle call above, so don't
+    // inherit the batched fast path
+    virtual int findCellsAndWeights(const int n,
+                                    const Point* pos,
+                                    const Matrix3* psize,
+                                    IntVector* ni,
+                                    double* S)
+    {
+      return ParticleInterpolator::findCellsAndWeights(n, pos, psize, ni, S);
+    }
+
     virtual int findCellAndShapeDerivatives(const Point& pos,
                                              vector<IntVector>& ni,
                                              vector<Vector>& d_S,
@@ -68,6 +68,56 @@ int fastCpdiInterpolator::findCellAndWeights(const Point& pos,
                                             vector<IntVector>& ni, 
                                             vector<double>& S,
                                             const Matrix3& size)
+{
+  return findCellAndWeights(pos, &ni[0], &S[0], size, 1);
+}
+
+//______________________________________________________________________
+//  Zero rows [first, d_size) of particle p in a block of n
+void fastCpdiInterpolator::zeroRows(const int p, const int first, const int n,
+                                    IntVector* ni, double* S)
+{
+  for (int k = first; k < d_size; k++) {
+    ni[k*n + p] = ni[p];
+    S[k*n + p]  = 0.0;
+  }
+}
+
+//______________________________________________________________________
+//  Batched version.  The lcrit scaling branches per particle, so this does
+//  not vectorize across particles, but it writes straight into the block
+//  with no vectors or virtual calls per particle.
+int fastCpdiInterpolator::findCellsAndWeights(const int n,
+                                              const Point* pos,
+                                              const Matrix3* psize,
+                                              IntVector* ni,
+                                              double* S)
+{
+  // The hashed path only fills the 27 rows it can reach.  Once a particle
+  // falls back to cpdi (64 rows) every other particle gets the rest zeroed.
+  int rows = 0;
+  for (int p = 0; p < n; p++) {
+    int NN = findCellAndWeights(pos[p], ni + p, S + p, psize[p], n);
+    if (NN > 27 && rows <= 27) {
+      for (int q = 0; q < p; q++) {
+        zeroRows(q, 27, n, ni, S);
+      }
+    }
+    else if (NN <= 27 && rows > 27) {
+      zeroRows(p, 27, n, ni, S);
+    }
+    rows = max(rows, NN);
+  }
+  return rows;
+}
+
+//______________________________________________________________________
+//
+int fastCpdiInterpolator::findCellAndWeights(const Point& pos,
+                                             IntVector* ni,
+                                             double* S,
+                                             const Matrix3& size,
+                                             const int stride)
 {
   Point cellpos = d_patch->getLevel()->positionToIndex(Point(pos));
 
@@ -221,17 +271,16 @@ int fastCpdiInterpolator::findCellAndWeights(const Point& pos,
   // If the particle spans more than two cells, the hash table below fails
   // so revert to the regular cpdiInterpolator
   if(maxX-minX>1 || maxY-minY>1 || maxZ-minZ>1){
-    ParticleInterpolator* interp;
-    interp = scinew cpdiInterpolator(d_patch,d_lcrit);
-    int NN = interp->findCellAndWeights(pos, ni, S, size);
-    delete interp;
-    return NN;
+    cpdiInterpolator interp(d_patch,d_lcrit);
+    return interp.findCellAndWeights(pos, ni, S, size, stride);
   } else {
     // Initialize Values
     IntVector niVec = IntVector(minX,minY,minZ);
-    for(int i = 0; i < 64; i++) {
-      S[i]      = 0.0;
-      ni[i]     = niVec;  // this must be set after minimum indicies are found
+    // A batched call only needs the rows the hash below can reach
+    const int nrows = (stride == 1) ? 64 : 27;
+    for(int i = 0; i < nrows; i++) {
+      S[i*stride]  = 0.0;
+      ni[i*stride] = niVec;  // this must be set after minimum indicies are found
                           //  or index out of bound error will occur
     }
 
@@ -287,8 +336,8 @@ int fastCpdiInterpolator::findCellAndWeights(const Point& pos,
             hashMax=max(hash, hashMax);
             phi  = phiX * phiY * phiZ;
           
-            ni[hash]        = IntVector(curX,curY,iz[i]+jz);
-            S[hash]        += one_over_8  * phi;
+            ni[hash*stride]        = IntVector(curX,curY,iz[i]+jz);
+            S[hash*stride]        += one_over_8  * phi;
           } // z for
         } // y for
       } // x for
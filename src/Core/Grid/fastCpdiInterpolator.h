@@ -66,6 +66,16 @@ namespace Uintah {
     virtual int findCellAndWeights(const Point& p,std::vector<IntVector>& ni,
                                    std::vector<double>& S, const Matrix3& size);
 
+    // Same as above, writing node k to ni[k*stride] and S[k*stride]
+    int findCellAndWeights(const Point& p, IntVector* ni, double* S,
+                           const Matrix3& size, const int stride);
+
+    virtual int findCellsAndWeights(const int n,
+                                    const Point* pos,
+                                    const Matrix3* psize,
+                                    IntVector* ni,
+                                    double* S);
+
     virtual int findCellAndShapeDerivatives(const Point& pos,
                                             std::vector<IntVector>& ni,
                                             std::vector<Vector>& d_S,
@@ -84,6 +94,9 @@ namespace Uintah {
     }
     
   private:
+    void zeroRows(const int p, const int first, const int n,
+                  IntVector* ni, double* S);
+
     const Patch* d_patch;
     int d_size;
     double d_lcrit;
@@ -53,17 +53,20 @@ struct Sentinel {
 
 struct AllocBin;
 
+struct ThreadCache;
+
 
 struct Tag {
-  AllocBin   * bin;
-  const char * tag;
+  AllocBin    * bin;
+  const char  * tag;
 #ifdef USE_TAG_LINENUM
-  int          linenum;
+  int           linenum;
 #endif
-  Tag        * next;
-  Tag        * prev;
-  OSHunk     * hunk;
-  size_t       reqsize;
+  Tag         * next;
+  Tag         * prev;
+  OSHunk      * hunk;
+  ThreadCache * cache;    // owning thread cache while on a per-thread inuse list, else nullptr
+  size_t        reqsize;
 };
 
 
@@ -79,6 +82,39 @@ struct AllocBin {
 };
 
 
+//------------------------------------------------------------------------------
+// Per-thread front end for the small bins.  Free objects are moved between the
+// central AllocBin and a CacheBin in batches; objects handed out from a cache
+// stay on that cache's inuse list until freed, so the tag accounting, audits and
+// dumps can still see every live object.  Objects checked out to a cache (free
+// or inuse) are counted in the central bin's ninuse.
+//------------------------------------------------------------------------------
+struct CacheBin {
+  Tag    * free;      // singly linked
+  Tag    * inuse;     // doubly linked
+  int      nfree;
+  size_t   nalloc;    // not yet folded into the central bin
+  size_t   nfreed;
+};
+
+
+struct ThreadCache {
+  CacheBin    * bins;
+  ThreadCache * next;
+  ThreadCache * prev;
+
+  // Not yet folded into the Allocator totals...
+  size_t nalloc;
+  size_t nfree;
+  size_t sizealloc;
+  size_t sizefree;
+
+  // Only contended when another thread frees an object from this cache,
+  // or when the allocator walks the caches for statistics.
+  Uintah::MasterLock m_lock{};
+};
+
+
 struct Allocator {
 
   void lock();
@@ -107,6 +143,22 @@ struct Allocator {
 
   size_t obj_maxsize( Tag* );
 
+  ThreadCache* get_thread_cache();
+
+  Tag* alloc_cached( size_t size, const char* tag, int linenum );
+
+  bool free_cached( Tag*, AllocBin* );
+
+  void refill_cache( ThreadCache*, int bin );
+
+  void drain_cache( ThreadCache*, int bin, int keep );
+
+  void fold_cache_stats( ThreadCache* );
+
+  void fold_thread_caches();
+
+  void release_thread_cache( ThreadCache* );
+
 
   int      strict;
   int      lazy;
@@ -139,6 +191,11 @@ struct Allocator {
 
   bool dying;
 
+  // Thread caches for the small bins (default allocator only)...
+  int           use_thread_cache;
+  ThreadCache * thread_caches;
+  ThreadCache * spare_thread_caches;
+
   Uintah::MasterLock m_lock{};
 
 };
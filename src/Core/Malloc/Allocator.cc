@@ -64,6 +64,9 @@ static const int s_allocator_align = 16;
 // irix64 KCC stuff
 #  include <strings.h>
 #  include <cstdio>
+#  include <new>
+
+#  include <pthread.h>
 
 // NOTE(boulos): On Darwin systems, even if it's not a 64-bit build the
 // compiler will generate warnings (so we use %lu for that case as well)
@@ -116,6 +119,12 @@ namespace Uintah {
 // Objects bigger than this can't be allocated
 #define MAX_ALLOCSIZE        (1024*1024*1024)
 
+// Per-thread small bin caches - objects are moved to/from the central bins
+// TCACHE_BATCH at a time, and a cache bin is drained back down to TCACHE_BATCH
+// once it holds more than TCACHE_MAX free objects
+#define TCACHE_BATCH         32
+#define TCACHE_MAX           (2*TCACHE_BATCH)
+
 static bool do_shutdown          = false;
 static int  mallocStatsAppendNum = -1;
 
@@ -140,7 +149,8 @@ inline size_t Allocator::obj_maxsize( Tag* t )
 static
 void
 account_bin( Allocator * a
-           , AllocBin  * bin
+           , Tag       * free_list
+           , Tag       * inuse_list
            , FILE      * out
            , size_t    & bytes_overhead
            , size_t    & bytes_free
@@ -149,12 +159,12 @@ account_bin( Allocator * a
            )
 {
   Tag* p = nullptr;
-  for (p = bin->free; p != nullptr; p = p->next) {
+  for (p = free_list; p != nullptr; p = p->next) {
     bytes_overhead += OVERHEAD;
     bytes_free += a->obj_maxsize(p);
   }
 
-  for (p = bin->inuse; p != nullptr; p = p->next) {
+  for (p = inuse_list; p != nullptr; p = p->next) {
     bytes_overhead += OVERHEAD;
     bytes_inuse += p->reqsize;
     bytes_fragmented += a->obj_maxsize(p) - p->reqsize;
@@ -169,6 +179,31 @@ account_bin( Allocator * a
   }
 }
 
+//______________________________________________________________________________
+// Objects parked in, or handed out from, the per-thread caches.
+// The allocator lock must be held.
+static
+void
+account_thread_caches( Allocator * a
+                     , FILE      * out
+                     , size_t    & bytes_overhead
+                     , size_t    & bytes_free
+                     , size_t    & bytes_fragmented
+                     , size_t    & bytes_inuse
+                     )
+{
+  for (ThreadCache* tc = a->thread_caches; tc != nullptr; tc = tc->next) {
+    tc->m_lock.lock();
+    {
+      for (int i = 0; i < NSMALL_BINS; i++) {
+        account_bin(a, tc->bins[i].free, tc->bins[i].inuse, out, bytes_overhead, bytes_free, bytes_fragmented, bytes_inuse);
+      }
+      bytes_overhead += sizeof(ThreadCache) + NSMALL_BINS * sizeof(CacheBin);
+    }
+    tc->m_lock.unlock();
+  }
+}
+
 //______________________________________________________________________________
 //
 static
@@ -204,18 +239,22 @@ shutdown()
     // Just in case...
     a->lock();
     {
+      a->fold_thread_caches();
+
       fprintf(a->stats_out, "Unfreed objects:\n");
       // Full accounting - go through each bin...
       size_t bytes_overhead = 0, bytes_free = 0, bytes_fragmented = 0, bytes_inuse = 0, bytes_inhunks = 0;
       for (int i = 0; i < NSMALL_BINS; i++) {
-        account_bin(a, &a->small_bins[i], a->stats_out, bytes_overhead, bytes_free, bytes_fragmented, bytes_inuse);
+        account_bin(a, a->small_bins[i].free, a->small_bins[i].inuse, a->stats_out, bytes_overhead, bytes_free, bytes_fragmented, bytes_inuse);
       }
 
       for (int i = 0; i < NMEDIUM_BINS; i++) {
-        account_bin(a, &a->medium_bins[i], a->stats_out, bytes_overhead, bytes_free, bytes_fragmented, bytes_inuse);
+        account_bin(a, a->medium_bins[i].free, a->medium_bins[i].inuse, a->stats_out, bytes_overhead, bytes_free, bytes_fragmented, bytes_inuse);
       }
 
-      account_bin(a, &a->big_bin, a->stats_out, bytes_overhead, bytes_free, bytes_fragmented, bytes_inuse);
+      account_bin(a, a->big_bin.free, a->big_bin.inuse, a->stats_out, bytes_overhead, bytes_free, bytes_fragmented, bytes_inuse);
+
+      account_thread_caches(a, a->stats_out, bytes_overhead, bytes_free, bytes_fragmented, bytes_inuse);
 
       // Count hunks...
       for (OSHunk* hunk = a->hunks; hunk != nullptr; hunk = hunk->next) {
@@ -440,6 +479,16 @@ MakeAllocator()
     a->lazy = 0;
   }
 
+  // Per-thread small bin caches are on unless explicitly turned off
+  if (getenv("MALLOC_NO_THREAD_CACHE")) {
+    a->use_thread_cache = 0;
+  }
+  else {
+    a->use_thread_cache = 1;
+  }
+  a->thread_caches       = nullptr;
+  a->spare_thread_caches = nullptr;
+
   // Initialize stats...
   a->nmmap = 1;
   a->sizemmap = size + sizeof(OSHunk);
@@ -522,49 +571,55 @@ Allocator::alloc( size_t size
 #endif
 
   Tag* obj = nullptr;
-  lock();
-  {
-    if (!obj_bin->free) {
-      fill_bin(obj_bin);
-    }
+  if (size <= SMALL_THRESHOLD && use_thread_cache) {
+    obj = alloc_cached(size, tag, linenum);
+  }
 
-    obj = obj_bin->free;
-    obj_bin->free = obj->next;
-    if (obj_bin->free) {
-      obj_bin->free->prev = nullptr;
-    }
+  if (!obj) {
+    lock();
+    {
+      if (!obj_bin->free) {
+        fill_bin(obj_bin);
+      }
 
-    // Tell the hunk that we are using this one...
-    obj->hunk->ninuse++;
-    obj->tag = tag;
+      obj = obj_bin->free;
+      obj_bin->free = obj->next;
+      if (obj_bin->free) {
+        obj_bin->free->prev = nullptr;
+      }
+
+      // Tell the hunk that we are using this one...
+      obj->hunk->ninuse++;
+      obj->tag = tag;
 #ifdef USE_TAG_LINENUM
-    obj->linenum = linenum;
+      obj->linenum = linenum;
 #endif
-    obj->next = obj_bin->inuse;
-    if (obj_bin->inuse) {
-      obj_bin->inuse->prev = obj;
-    }
+      obj->next = obj_bin->inuse;
+      if (obj_bin->inuse) {
+        obj_bin->inuse->prev = obj;
+      }
 
-    obj->prev = nullptr;
-    obj_bin->inuse = obj;
-    obj->reqsize = size;
-    obj_bin->ninuse++;
+      obj->prev = nullptr;
+      obj_bin->inuse = obj;
+      obj->reqsize = size;
+      obj_bin->ninuse++;
 
-    nalloc++;
-    sizealloc += size;
-    size_t bytes_inuse = sizealloc - sizefree;
+      nalloc++;
+      sizealloc += size;
+      size_t bytes_inuse = sizealloc - sizefree;
 
-    if (sizealloc < sizefree) {
-      bytes_inuse = 0;
-    }
+      if (sizealloc < sizefree) {
+        bytes_inuse = 0;
+      }
 
-    if (bytes_inuse > highwater_alloc) {
-      highwater_alloc = bytes_inuse;
-    }
+      if (bytes_inuse > highwater_alloc) {
+        highwater_alloc = bytes_inuse;
+      }
 
-    obj_bin->nalloc++;
+      obj_bin->nalloc++;
+    }
+    unlock(); // Safe to unlock now
   }
-  unlock(); // Safe to unlock now
 
   // Make sure that it is still cleared out...
   if (!lazy) {
@@ -676,6 +731,7 @@ Allocator::alloc_big(       size_t   size
     obj->prev = nullptr;
     big_bin.free = obj;
     obj->hunk = hunk;
+    obj->cache = nullptr;
     big_bin.ntotal++;
 
     // Fill in sentinel info...
@@ -841,6 +897,7 @@ Allocator::memalign(size_t alignment, size_t size, const char* ctag)
   tag->bin = 0;
   tag->next = tag->prev = (Tag*)addr;
   tag->hunk = 0;
+  tag->cache = nullptr;
   tag->reqsize = size;
   tag->tag = ctag;
 #  ifdef USE_TAG_LINENUM
@@ -852,6 +909,32 @@ Allocator::memalign(size_t alignment, size_t size, const char* ctag)
   return m;
 }
 
+//______________________________________________________________________________
+//
+static inline
+void
+mark_free( Allocator* a, Tag* obj )
+{
+  // Setup the new sentinels...
+  char* data = (char*)obj;
+  data += sizeof(Tag);
+  Sentinel* sent1 = (Sentinel*)data;
+  data += sizeof(Sentinel);
+  char* d = (char*)data;
+  data += a->obj_maxsize(obj);
+  Sentinel* sent2 = (Sentinel*)data;
+
+  sent1->first_word = sent1->second_word = sent2->first_word = sent2->second_word = SENT_VAL_FREE;
+
+  if (a->strict) {
+    // Fill in the data region with markers.
+    unsigned int i = 0xffff5a5a;
+    for (unsigned int* p = (unsigned int*)d; p < (unsigned int*)sent2; p++) {
+      *p++ = i;
+    }
+  }
+}
+
 //______________________________________________________________________________
 //
 void Allocator::free( void* dobj )
@@ -887,6 +970,10 @@ void Allocator::free( void* dobj )
 
   AllocBin* obj_bin = get_bin(obj->bin->maxsize);
 
+  if (obj->cache && free_cached(obj, obj_bin)) {
+    return;
+  }
+
   lock();
   nfree++;
   sizefree += obj->reqsize;
@@ -922,24 +1009,448 @@ void Allocator::free( void* dobj )
     obj->prev = nullptr;
     obj_bin->free = obj;
 
-    // Setup the new sentinels...
-    char* data = (char*)obj;
-    data += sizeof(Tag);
-    Sentinel* sent1 = (Sentinel*)data;
-    data += sizeof(Sentinel);
-    char* d = (char*)data;
-    data += obj_maxsize(obj);
-    Sentinel* sent2 = (Sentinel*)data;
+    mark_free(this, obj);
+  }
+  unlock();
+}
 
-    sent1->first_word = sent1->second_word = sent2->first_word = sent2->second_word = SENT_VAL_FREE;
+//______________________________________________________________________________
+//
+// Per-thread small bin caches.
+//
+// Lock order is always the allocator lock before a ThreadCache lock; a thread
+// holding its own cache lock never takes the allocator lock.  ThreadCache
+// structures are carved out of the allocator's hunks and recycled through
+// spare_thread_caches, so a stale Tag::cache pointer is always safe to lock.
+//
+static thread_local ThreadCache * t_thread_cache          = nullptr;
+static thread_local bool          t_thread_cache_released = false;
+static              pthread_key_t s_thread_cache_key;
+static              bool          s_thread_cache_key_valid = false;
 
-    if (strict) {
-      // Fill in the data region with markers.
-      unsigned int i = 0xffff5a5a;
-      for (unsigned int* p = (unsigned int*)d; p < (unsigned int*)sent2; p++) {
-        *p++ = i;
+//______________________________________________________________________________
+//
+static void
+thread_cache_exit( void* tc )
+{
+  t_thread_cache          = nullptr;
+  t_thread_cache_released = true;
+  default_allocator->release_thread_cache((ThreadCache*)tc);
+}
+
+//______________________________________________________________________________
+//
+ThreadCache*
+Allocator::get_thread_cache()
+{
+  if (this != default_allocator) {
+    return nullptr;
+  }
+  if (t_thread_cache || t_thread_cache_released) {
+    return t_thread_cache;
+  }
+
+  ThreadCache* tc = nullptr;
+  lock();
+  {
+    if (!s_thread_cache_key_valid) {
+      if (pthread_key_create(&s_thread_cache_key, thread_cache_exit) != 0) {
+        use_thread_cache = 0;
+        unlock();
+        return nullptr;
+      }
+      s_thread_cache_key_valid = true;
+    }
+
+    tc = spare_thread_caches;
+    if (tc) {
+      spare_thread_caches = tc->next;
+    }
+    else {
+      OSHunk* hunk;
+      void* p;
+      get_hunk(sizeof(ThreadCache) + NSMALL_BINS * sizeof(CacheBin), hunk, p);
+      tc = new (p) ThreadCache;
+      tc->bins = (CacheBin*)(tc + 1);
+    }
+
+    for (int i = 0; i < NSMALL_BINS; i++) {
+      CacheBin* cb = &tc->bins[i];
+      cb->free   = nullptr;
+      cb->inuse  = nullptr;
+      cb->nfree  = 0;
+      cb->nalloc = 0;
+      cb->nfreed = 0;
+    }
+    tc->nalloc = tc->nfree = tc->sizealloc = tc->sizefree = 0;
+
+    tc->prev = nullptr;
+    tc->next = thread_caches;
+    if (thread_caches) {
+      thread_caches->prev = tc;
+    }
+    thread_caches = tc;
+  }
+  unlock();
+
+  // Set before pthread_setspecific, which may itself call malloc
+  t_thread_cache = tc;
+  pthread_setspecific(s_thread_cache_key, tc);
+
+  return tc;
+}
+
+//______________________________________________________________________________
+//
+Tag*
+Allocator::alloc_cached( size_t size, const char* tag, int linenum )
+{
+  ThreadCache* tc = get_thread_cache();
+  if (!tc) {
+    return nullptr;
+  }
+
+  int bin = (int)SMALL_BIN(size);
+  CacheBin* cb = &tc->bins[bin];
+
+  // Only this thread ever adds to or takes from its own free lists
+  if (!cb->free) {
+    refill_cache(tc, bin);
+  }
+
+  Tag* obj = nullptr;
+  tc->m_lock.lock();
+  {
+    obj = cb->free;
+    cb->free = obj->next;
+    cb->nfree--;
+
+    obj->cache = tc;
+    obj->tag = tag;
+#ifdef USE_TAG_LINENUM
+    obj->linenum = linenum;
+#endif
+    obj->reqsize = size;
+    obj->prev = nullptr;
+    obj->next = cb->inuse;
+    if (cb->inuse) {
+      cb->inuse->prev = obj;
+    }
+    cb->inuse = obj;
+
+    cb->nalloc++;
+    tc->nalloc++;
+    tc->sizealloc += size;
+  }
+  tc->m_lock.unlock();
+
+  return obj;
+}
+
+//______________________________________________________________________________
+// Returns false if the object has been handed back to the central inuse list
+// (its thread exited), in which case the caller frees it the normal way.
+bool
+Allocator::free_cached( Tag* obj, AllocBin* obj_bin )
+{
+  // This thread's cache is looked up first: on a thread's first use it takes
+  // the allocator lock, which must not be taken while holding a cache lock.
+  ThreadCache* tc = get_thread_cache();
+
+  // Unlink it from the inuse list of the cache it was allocated from.  The owner
+  // may exit and hand its objects back to the central bin before we get its lock...
+  ThreadCache* owner = obj->cache;
+  for (;;) {
+    owner->m_lock.lock();
+    if (obj->cache == owner) {
+      break;
+    }
+    owner->m_lock.unlock();
+    owner = obj->cache;
+    if (!owner) {
+      return false;
+    }
+  }
+
+  int bin = (int)(obj_bin - small_bins);
+  CacheBin* ocb = &owner->bins[bin];
+  if (obj->next) {
+    obj->next->prev = obj->prev;
+  }
+  if (obj->prev) {
+    obj->prev->next = obj->next;
+  }
+  else {
+    ocb->inuse = obj->next;
+  }
+  obj->cache = nullptr;
+
+  size_t reqsize = obj->reqsize;
+  mark_free(this, obj);
+
+  // Park it in this thread's cache...
+  CacheBin*    cb = nullptr;
+  int nfree_cached = 0;
+  if (tc == owner) {
+    // The common case - freed by the thread that allocated it
+    cb = ocb;
+    obj->next = cb->free;
+    cb->free = obj;
+    nfree_cached = ++cb->nfree;
+    cb->nfreed++;
+    tc->nfree++;
+    tc->sizefree += reqsize;
+    owner->m_lock.unlock();
+
+    if (nfree_cached > TCACHE_MAX) {
+      drain_cache(tc, bin, TCACHE_BATCH);
+    }
+    return true;
+  }
+  owner->m_lock.unlock();
+
+  if (!tc) {
+    // ... unless this thread is exiting, then straight back to the central bin
+    lock();
+    {
+      nfree++;
+      sizefree += reqsize;
+      obj_bin->nfree++;
+      obj_bin->ninuse--;
+      obj->next = obj_bin->free;
+      if (obj_bin->free) {
+        obj_bin->free->prev = obj;
       }
+      obj->prev = nullptr;
+      obj_bin->free = obj;
     }
+    unlock();
+    return true;
+  }
+
+  cb = &tc->bins[bin];
+  tc->m_lock.lock();
+  {
+    obj->next = cb->free;
+    cb->free = obj;
+    nfree_cached = ++cb->nfree;
+    cb->nfreed++;
+    tc->nfree++;
+    tc->sizefree += reqsize;
+  }
+  tc->m_lock.unlock();
+
+  if (nfree_cached > TCACHE_MAX) {
+    drain_cache(tc, bin, TCACHE_BATCH);
+  }
+
+  return true;
+}
+
+//______________________________________________________________________________
+//
+void
+Allocator::refill_cache( ThreadCache* tc, int bin )
+{
+  AllocBin* obj_bin = &small_bins[bin];
+
+  Tag* head = nullptr;
+  Tag* tail = nullptr;
+  int  n    = 0;
+  lock();
+  {
+    fold_cache_stats(tc);
+
+    while (n < TCACHE_BATCH) {
+      if (!obj_bin->free) {
+        if (n > 0) {
+          break;
+        }
+        fill_bin(obj_bin);
+      }
+
+      Tag* obj = obj_bin->free;
+      obj_bin->free = obj->next;
+      if (obj_bin->free) {
+        obj_bin->free->prev = nullptr;
+      }
+
+      // Tell the hunk that we are using this one...
+      obj->hunk->ninuse++;
+      obj->next = head;
+      head = obj;
+      if (!tail) {
+        tail = obj;
+      }
+      n++;
+    }
+    obj_bin->ninuse += n;
+  }
+  unlock();
+
+  CacheBin* cb = &tc->bins[bin];
+  tc->m_lock.lock();
+  {
+    tail->next = cb->free;
+    cb->free = head;
+    cb->nfree += n;
+  }
+  tc->m_lock.unlock();
+}
+
+//______________________________________________________________________________
+// Hand all but the first "keep" free objects of a cache bin back to the central bin
+void
+Allocator::drain_cache( ThreadCache* tc, int bin, int keep )
+{
+  CacheBin* cb = &tc->bins[bin];
+
+  Tag* head = nullptr;
+  int  n    = 0;
+  tc->m_lock.lock();
+  {
+    if (keep == 0) {
+      head = cb->free;
+      cb->free = nullptr;
+    }
+    else {
+      Tag* last = cb->free;
+      for (int i = 1; i < keep && last; i++) {
+        last = last->next;
+      }
+      if (last) {
+        head = last->next;
+        last->next = nullptr;
+      }
+    }
+    n = (head) ? cb->nfree - keep : 0;
+    cb->nfree -= n;
+  }
+  tc->m_lock.unlock();
+
+  if (!head) {
+    return;
+  }
+
+  AllocBin* obj_bin = &small_bins[bin];
+  lock();
+  {
+    fold_cache_stats(tc);
+
+    while (head) {
+      Tag* next = head->next;
+      head->next = obj_bin->free;
+      if (obj_bin->free) {
+        obj_bin->free->prev = head;
+      }
+      head->prev = nullptr;
+      obj_bin->free = head;
+      head = next;
+    }
+    obj_bin->ninuse -= n;
+  }
+  unlock();
+}
+
+//______________________________________________________________________________
+// Fold the statistics a thread cache has accumulated into the allocator
+// totals.  The allocator lock must be held.
+void
+Allocator::fold_cache_stats( ThreadCache* tc )
+{
+  tc->m_lock.lock();
+  {
+    nalloc    += tc->nalloc;
+    sizealloc += tc->sizealloc;
+    nfree     += tc->nfree;
+    sizefree  += tc->sizefree;
+    tc->nalloc = tc->nfree = tc->sizealloc = tc->sizefree = 0;
+
+    for (int i = 0; i < NSMALL_BINS; i++) {
+      CacheBin* cb = &tc->bins[i];
+      small_bins[i].nalloc += cb->nalloc;
+      small_bins[i].nfree  += cb->nfreed;
+      cb->nalloc = cb->nfreed = 0;
+    }
+  }
+  tc->m_lock.unlock();
+
+  // The high water mark is only as fine grained as the folds for cached objects
+  size_t bytes_inuse = (sizealloc < sizefree) ? 0 : sizealloc - sizefree;
+  if (bytes_inuse > highwater_alloc) {
+    highwater_alloc = bytes_inuse;
+  }
+}
+
+//______________________________________________________________________________
+// The allocator lock must be held.
+void
+Allocator::fold_thread_caches()
+{
+  for (ThreadCache* tc = thread_caches; tc != nullptr; tc = tc->next) {
+    fold_cache_stats(tc);
+  }
+}
+
+//______________________________________________________________________________
+// Called when a thread exits: its free objects go back to the central free
+// lists, and its live objects to the central inuse lists.
+void
+Allocator::release_thread_cache( ThreadCache* tc )
+{
+  lock();
+  {
+    fold_cache_stats(tc);
+
+    tc->m_lock.lock();
+    {
+      for (int i = 0; i < NSMALL_BINS; i++) {
+        AllocBin* obj_bin = &small_bins[i];
+        CacheBin* cb      = &tc->bins[i];
+
+        for (Tag* obj = cb->free; obj != nullptr;) {
+          Tag* next = obj->next;
+          obj->next = obj_bin->free;
+          if (obj_bin->free) {
+            obj_bin->free->prev = obj;
+          }
+          obj->prev = nullptr;
+          obj_bin->free = obj;
+          obj = next;
+        }
+        obj_bin->ninuse -= cb->nfree;
+
+        for (Tag* obj = cb->inuse; obj != nullptr;) {
+          Tag* next = obj->next;
+          obj->cache = nullptr;
+          obj->next = obj_bin->inuse;
+          if (obj_bin->inuse) {
+            obj_bin->inuse->prev = obj;
+          }
+          obj->prev = nullptr;
+          obj_bin->inuse = obj;
+          obj = next;
+        }
+
+        cb->free  = nullptr;
+        cb->inuse = nullptr;
+        cb->nfree = 0;
+      }
+    }
+    tc->m_lock.unlock();
+
+    if (tc->prev) {
+      tc->prev->next = tc->next;
+    }
+    else {
+      thread_caches = tc->next;
+    }
+    if (tc->next) {
+      tc->next->prev = tc->prev;
+    }
+    tc->prev = nullptr;
+    tc->next = spare_thread_caches;
+    spare_thread_caches = tc;
   }
   unlock();
 }
@@ -976,6 +1487,7 @@ void Allocator::fill_bin( AllocBin* bin )
       t->prev = 0;
       bin->free = t;
       t->hunk = hunk;
+      t->cache = nullptr;
       p = (void*)((char*)p + tsize);
       char* data = (char*)t;
       data += sizeof(Tag);
@@ -1241,6 +1753,8 @@ GetGlobalStats( Allocator * a
 
   a->lock();
   {
+    a->fold_thread_caches();
+
     nalloc = a->nalloc;
     sizealloc = a->sizealloc;
     nfree = a->nfree;
@@ -1256,14 +1770,16 @@ GetGlobalStats( Allocator * a
     // Full accounting - go through each bin...
     bytes_overhead = bytes_free = bytes_fragmented = bytes_inuse = bytes_inhunks = 0;
     for (int i = 0; i < NSMALL_BINS; i++) {
-      account_bin(a, &a->small_bins[i],nullptr, bytes_overhead, bytes_free, bytes_fragmented, bytes_inuse);
+      account_bin(a, a->small_bins[i].free, a->small_bins[i].inuse, nullptr, bytes_overhead, bytes_free, bytes_fragmented, bytes_inuse);
     }
 
     for (int i = 0; i < NMEDIUM_BINS; i++) {
-      account_bin(a, &a->medium_bins[i], nullptr, bytes_overhead, bytes_free, bytes_fragmented, bytes_inuse);
+      account_bin(a, a->medium_bins[i].free, a->medium_bins[i].inuse, nullptr, bytes_overhead, bytes_free, bytes_fragmented, bytes_inuse);
     }
 
-    account_bin(a, &a->big_bin, nullptr, bytes_overhead, bytes_free, bytes_fragmented, bytes_inuse);
+    account_bin(a, a->big_bin.free, a->big_bin.inuse, nullptr, bytes_overhead, bytes_free, bytes_fragmented, bytes_inuse);
+
+    account_thread_caches(a, nullptr, bytes_overhead, bytes_free, bytes_fragmented, bytes_inuse);
 
     // Count hunks...
     for (OSHunk* hunk = a->hunks; hunk != nullptr; hunk = hunk->next) {
@@ -1313,6 +1829,8 @@ GetGlobalStats( Allocator * a
 
   a->lock();
   {
+    a->fold_thread_caches();
+
     nalloc = a->nalloc;
     sizealloc = a->sizealloc;
     nfree = a->nfree;
@@ -1361,6 +1879,8 @@ GetBinStats( Allocator * a
 
   a->lock();
   {
+    a->fold_thread_caches();
+
     minsize=bin->minsize;
     maxsize=bin->maxsize;
     nalloc=bin->nalloc;
@@ -1383,16 +1903,16 @@ DefaultAllocator()
 //______________________________________________________________________________
 //
 static void
-audit_bin( Allocator* a, AllocBin* bin )
+audit_bin( Allocator* a, Tag* free_list, Tag* inuse_list, bool check_free_links = true )
 {
   Tag* p;
-  for (p = bin->free; p != nullptr; p = p->next) {
-    if (p->next && p->next->prev != p) {
+  for (p = free_list; p != nullptr; p = p->next) {
+    if (check_free_links && p->next && p->next->prev != p) {
       AllocError("Free list confused");
     }
     a->audit(p, OBJFREE);
   }
-  for (p = bin->inuse; p != nullptr; p = p->next) {
+  for (p = inuse_list; p != nullptr; p = p->next) {
     if (p->next && p->next->prev != p) {
       AllocError("Inuse list confused");
     }
@@ -1408,14 +1928,23 @@ AuditAllocator( Allocator* a )
   a->lock();
   {
     for (int i = 0; i < NSMALL_BINS; i++) {
-      audit_bin(a, &a->small_bins[i]);
+      audit_bin(a, a->small_bins[i].free, a->small_bins[i].inuse);
     }
 
     for (int i = 0; i < NMEDIUM_BINS; i++) {
-      audit_bin(a, &a->medium_bins[i]);
+      audit_bin(a, a->medium_bins[i].free, a->medium_bins[i].inuse);
     }
 
-    audit_bin(a, &a->big_bin);
+    audit_bin(a, a->big_bin.free, a->big_bin.inuse);
+
+    // Thread cache free lists are only singly linked...
+    for (ThreadCache* tc = a->thread_caches; tc != nullptr; tc = tc->next) {
+      tc->m_lock.lock();
+      for (int i = 0; i < NSMALL_BINS; i++) {
+        audit_bin(a, tc->bins[i].free, tc->bins[i].inuse, false);
+      }
+      tc->m_lock.unlock();
+    }
   }
   a->unlock();
 }
@@ -1431,11 +1960,11 @@ void AuditDefaultAllocator()
 //
 static void
 dump_bin( Allocator *
-        , AllocBin  * bin
+        , Tag       * inuse_list
         , FILE      * fp
         )
 {
-  for (Tag* p = bin->inuse; p != nullptr; p = p->next) {
+  for (Tag* p = inuse_list; p != nullptr; p = p->next) {
 #  ifdef USE_TAG_LINENUM
     fprintf(fp, "%p " UCONV " %s:%d\n", (p + sizeof(Tag) + sizeof(Sentinel)), (SIZET)p->reqsize, p->tag, p->linenum);
 #  else
@@ -1465,14 +1994,22 @@ DumpAllocator( Allocator* a, const char* filename )
   a->lock();
   {
     for (int i = 0; i < NSMALL_BINS; i++) {
-      dump_bin(a, &a->small_bins[i], fp);
+      dump_bin(a, a->small_bins[i].inuse, fp);
     }
 
     for (int i = 0; i < NMEDIUM_BINS; i++) {
-      dump_bin(a, &a->medium_bins[i], fp);
+      dump_bin(a, a->medium_bins[i].inuse, fp);
     }
 
-    dump_bin(a, &a->big_bin, fp);
+    dump_bin(a, a->big_bin.inuse, fp);
+
+    for (ThreadCache* tc = a->thread_caches; tc != nullptr; tc = tc->next) {
+      tc->m_lock.lock();
+      for (int i = 0; i < NSMALL_BINS; i++) {
+        dump_bin(a, tc->bins[i].inuse, fp);
+      }
+      tc->m_lock.unlock();
+    }
   }
   a->unlock();
 
@@ -74,12 +74,26 @@ BufferInfo::add( void         * startbuf
                , MPI_Datatype   datatype
                , bool           free_datatype
                )
+{
+  add( startbuf, count, datatype, free_datatype, Window() );
+}
+
+//_____________________________________________________________________________
+//
+void
+BufferInfo::add( void         * startbuf
+               , int            count
+               , MPI_Datatype   datatype
+               , bool           free_datatype
+               , const Window & window
+               )
 {
   ASSERT( !m_have_datatype );
   m_start_bufs.push_back( startbuf );
   m_counts.push_back( count );
   m_datatypes.push_back( datatype );
   m_free_datatypes.push_back( free_datatype );
+  m_windows.push_back( window );
 }
 
 //_____________________________________________________________________________
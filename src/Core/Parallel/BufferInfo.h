@@ -67,6 +67,18 @@ class BufferInfo {
 
   public:
 
+    // Describes a region made of equally strided contiguous rows (e.g. an Array3 window),
+    // so that PackBufferInfo can pack it with one memcpy per row instead of MPI_Pack.
+    struct Window {
+      int  m_row_bytes{0};    // 0 means "not a window", the entry is packed with MPI_Pack
+      int  m_num_y{0};
+      int  m_num_z{0};
+      long m_stride_y{0};     // in bytes
+      long m_stride_z{0};     // in bytes
+
+      long bytes() const { return static_cast<long>(m_row_bytes) * m_num_y * m_num_z; }
+    };
+
     BufferInfo(){};
 
     virtual ~BufferInfo() noexcept(false);
@@ -84,6 +96,13 @@ class BufferInfo {
             , bool           free_datatype
             );
 
+    void add( void         * startbuf
+            , int            count
+            , MPI_Datatype   datatype
+            , bool           free_datatype
+            , const Window & window
+            );
+
     void addSendlist( RefCounted * );
 
     Sendlist* takeSendlist();
@@ -96,6 +115,7 @@ class BufferInfo {
     std::vector<int>            m_counts;
     std::vector<MPI_Datatype>   m_datatypes;
     std::vector<bool>           m_free_datatypes;
+    std::vector<Window>         m_windows;
 
     void*          m_buffer{nullptr};
     int            m_count{0};
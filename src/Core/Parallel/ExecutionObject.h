@@ -51,6 +51,21 @@ namespace Uintah {
 
 class UintahParams;
 
+// How the OpenMP back-end of the Uintah parallel loops (LoopExecution.hpp) walks a BlockRange.
+// Flat linearizes the range and recovers i,j,k per cell, Tiled hands each thread whole
+// tile_i x tile_j x tile_k tiles with a contiguous inner i-loop.  A tile size <= 0 spans
+// the whole range in that direction.
+struct LoopTiling {
+
+  enum Strategy {
+      Flat
+    , Tiled
+  };
+
+  Strategy strategy{Flat};
+  int      tile[3]{0, 4, 4};
+};
+
 template <typename ExecSpace, typename MemSpace>
 class ExecutionObject {
 public:
@@ -109,12 +124,21 @@ public:
     this->cuda_blocks_per_loop = CudaBlocksPerLoop;
   }
 
+  const LoopTiling & getLoopTiling() const {
+    return m_loop_tiling;
+  }
+
+  void setLoopTiling(const LoopTiling & loopTiling) {
+    m_loop_tiling = loopTiling;
+  }
+
   //void getTempTaskSpaceFromPool(void** ptr, unsigned int size) const {}
 private:
   std::vector<void*> m_streams;
   int deviceID{0};
   int cuda_threads_per_block{-1};
   int cuda_blocks_per_loop{-1};
+  LoopTiling m_loop_tiling{};
 };
 
 } // end namespace Uintah
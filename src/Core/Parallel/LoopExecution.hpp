@@ -308,6 +308,56 @@ struct int_3
 
 }; // end struct int_3
 
+// Splits a BlockRange into tiles for LoopTiling::Tiled execution.  Tiles are numbered i-fastest,
+// so consecutive tiles (and a thread's static chunk of them) stay close in memory, and each tile
+// is walked k, j, i with a contiguous inner i-loop the compiler can vectorize.
+class TiledRange
+{
+public:
+
+  TiledRange( BlockRange const & r, LoopTiling const & tiling )
+  {
+    for (int d = 0; d < 3; ++d) {
+      m_begin[d] = r.begin(d);
+      m_end[d]   = r.end(d);
+      const int extent = m_end[d] - m_begin[d];
+      m_tile[d]  = (tiling.tile[d] > 0 && tiling.tile[d] < extent) ? tiling.tile[d] : (extent > 0 ? extent : 1);
+      m_ntiles[d] = extent > 0 ? (extent + m_tile[d] - 1) / m_tile[d] : 0;
+    }
+  }
+
+  int size() const { return m_ntiles[0] * m_ntiles[1] * m_ntiles[2]; }
+
+  // bounds [lo, hi) of tile n
+  void tile( const int n, int lo[3], int hi[3] ) const
+  {
+    const int t[3] = { n % m_ntiles[0], (n / m_ntiles[0]) % m_ntiles[1], n / (m_ntiles[0] * m_ntiles[1]) };
+    for (int d = 0; d < 3; ++d) {
+      lo[d] = m_begin[d] + t[d] * m_tile[d];
+      hi[d] = min(lo[d] + m_tile[d], m_end[d]);
+    }
+  }
+
+  // walks tile n, calling f(i,j,k)
+  template <typename Functor>
+  void for_each( const int n, const Functor & f ) const
+  {
+    int lo[3], hi[3];
+    tile(n, lo, hi);
+    for (int k = lo[2]; k < hi[2]; ++k) {
+    for (int j = lo[1]; j < hi[1]; ++j) {
+    for (int i = lo[0]; i < hi[0]; ++i) {
+      f(i, j, k);
+    }}}
+  }
+
+private:
+  int m_begin[3];
+  int m_end[3];
+  int m_tile[3];
+  int m_ntiles[3];
+};
+
 //----------------------------------------------------------------------------
 // Start parallel loops
 //----------------------------------------------------------------------------
@@ -328,6 +378,14 @@ parallel_for( ExecutionObject<ExecSpace, MemSpace>& execObj, BlockRange const &
   const unsigned int rbegin2 = r.begin(2);
   const unsigned int numItems = (i_size > 0 ? i_size : 1) * (j_size > 0 ? j_size : 1) * (k_size > 0 ? k_size : 1);
 
+  if (execObj.getLoopTiling().strategy == LoopTiling::Tiled) {
+    const TiledRange tiles(r, execObj.getLoopTiling());
+    Kokkos::parallel_for( Kokkos::RangePolicy<Kokkos::OpenMP, int>(0, tiles.size()), [&, tiles](int n) {
+      tiles.for_each(n, functor);
+    });
+    return;
+  }
+
   Kokkos::parallel_for( Kokkos::RangePolicy<Kokkos::OpenMP, int>(0, numItems).set_chunk_size(1), [&, i_size, j_size, k_size, rbegin0, rbegin1, rbegin2](int n) {
     const int k = n / (j_size * i_size) + rbegin2;
     const int j = (n / i_size) % j_size + rbegin1;
@@ -576,6 +634,20 @@ parallel_reduce_sum(ExecutionObject<ExecSpace, MemSpace>& execObj, BlockRange co
 
   const unsigned int numItems = (i_size > 0 ? i_size : 1) * (j_size > 0 ? j_size : 1) * (k_size > 0 ? k_size : 1);
 
+  if (execObj.getLoopTiling().strategy == LoopTiling::Tiled) {
+    const TiledRange tiles(r, execObj.getLoopTiling());
+    Kokkos::parallel_reduce( Kokkos::RangePolicy<Kokkos::OpenMP, int>(0, tiles.size()), [&, tiles](const int& n, ReductionType & tmp) {
+      ReductionType tile_sum = 0;
+      tiles.for_each(n, [&](int i, int j, int k) {
+        ReductionType tmp2 = 0;
+        functor( i, j, k, tmp2 );
+        tile_sum += tmp2;
+      });
+      tmp += tile_sum;
+    }, red);
+    return;
+  }
+
   Kokkos::parallel_reduce( Kokkos::RangePolicy<Kokkos::OpenMP, int>(0, numItems).set_chunk_size(1), [&, i_size, j_size, k_size, rbegin0, rbegin1, rbegin2](const int& n, ReductionType & tmp) {
     const int k = n / (j_size * i_size) + rbegin2;
     const int j = (n / i_size) % j_size + rbegin1;
@@ -751,6 +823,20 @@ parallel_reduce_min( ExecutionObject<ExecSpace, MemSpace>& execObj,
   const int jb = r.begin(1); const int je = r.end(1);
   const int kb = r.begin(2); const int ke = r.end(2);
 
+  if (execObj.getLoopTiling().strategy == LoopTiling::Tiled) {
+    const TiledRange tiles(r, execObj.getLoopTiling());
+    Kokkos::parallel_reduce( Kokkos::RangePolicy<Kokkos::OpenMP, int>(0, tiles.size()), [=](int n, ReductionType & tmp1) {
+      ReductionType tmp2;
+      tiles.for_each(n, [&](int i, int j, int k) {
+        functor(i,j,k,tmp2);
+        tmp1=min(tmp2,tmp1);
+      });
+    }, Kokkos::Min<ReductionType>(tmp0));
+
+    red = min(tmp0,red);
+    return;
+  }
+
   // Manual approach
   Kokkos::parallel_reduce( Kokkos::RangePolicy<Kokkos::OpenMP, int>(kb, ke).set_chunk_size(1), [=](int k, ReductionType & tmp1) {
     ReductionType tmp2;
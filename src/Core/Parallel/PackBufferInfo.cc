@@ -25,14 +25,117 @@
 #include <Core/Parallel/PackBufferInfo.h>
 #include <Core/Exceptions/InternalError.h>
 #include <Core/Malloc/Allocator.h>
+#include <Core/Parallel/MasterLock.h>
 #include <Core/Parallel/Parallel.h>
 #include <Core/Util/Assert.h>
 #include <Core/Util/RefCounted.h>
 
 using namespace Uintah;
 
+#include <algorithm>
 #include <iostream>
+#include <mutex>
 #include <string.h>
+#include <vector>
+
+
+namespace {
+
+  // Size-class pool backing PackedBuffer, 4 classes per power of two so at most
+  // 25% of a buffer is unused. Requests above g_max_pooled_bytes are allocated
+  // at their size and freed on release. Each class keeps at most
+  // g_max_buffers_per_class free buffers and all classes together at most
+  // g_max_retained_bytes; buffers released beyond that are freed.
+  const int    g_classes_per_octave_log2 = 2;
+  const int    g_min_pooled_bytes        = 1 << 10;          // 1 KB
+  const int    g_max_pooled_bytes        = 1 << 22;          // 4 MB
+  const int    g_max_buffers_per_class   = 64;
+  const size_t g_max_retained_bytes      = size_t(256) << 20;
+
+  const int    g_num_classes = (22 + 1) << g_classes_per_octave_log2;
+
+  Uintah::MasterLock g_pool_mutex{};
+  size_t             g_retained_bytes{0};
+
+  // never destroyed, buffers may still be released during static destruction
+  std::vector<std::vector<char*>> & freeLists()
+  {
+    static std::vector<std::vector<char*>> * free_lists = new std::vector<std::vector<char*>>(g_num_classes);
+    return *free_lists;
+  }
+
+  // Rounds bytes up to its size class, -1 if it is not pooled.
+  int sizeClass( int bytes, int & class_bytes )
+  {
+    class_bytes = bytes;
+    if (bytes > g_max_pooled_bytes) {
+      return -1;
+    }
+    const unsigned int request  = std::max(bytes, g_min_pooled_bytes);
+    const int          msb      = 31 - __builtin_clz(request - 1);
+    const int          shift    = msb - g_classes_per_octave_log2;
+    const unsigned int mantissa = ((request - 1) >> shift) + 1;  // (4, 8]
+
+    class_bytes = static_cast<int>(mantissa << shift);
+    return (msb << g_classes_per_octave_log2) + static_cast<int>(mantissa) - (1 << g_classes_per_octave_log2) - 1;
+  }
+
+  char* poolAllocate( int bytes )
+  {
+    int class_bytes;
+    const int c = sizeClass(bytes, class_bytes);
+
+    if (c >= 0) {
+      std::lock_guard<Uintah::MasterLock> pool_guard(g_pool_mutex);
+      std::vector<char*> & free_list = freeLists()[c];
+      if (!free_list.empty()) {
+        char* buffer = free_list.back();
+        free_list.pop_back();
+        g_retained_bytes -= class_bytes;
+        return buffer;
+      }
+    }
+    return scinew char[class_bytes];
+  }
+
+  void poolRelease( char * buffer, int bytes )
+  {
+    int class_bytes;
+    const int c = sizeClass(bytes, class_bytes);
+
+    if (c >= 0) {
+      std::lock_guard<Uintah::MasterLock> pool_guard(g_pool_mutex);
+      std::vector<char*> & free_list = freeLists()[c];
+      if (static_cast<int>(free_list.size()) < g_max_buffers_per_class && g_retained_bytes + class_bytes <= g_max_retained_bytes) {
+        free_list.push_back(buffer);
+        g_retained_bytes += class_bytes;
+        return;
+      }
+    }
+    delete[] buffer;
+  }
+
+}
+
+
+std::atomic<int64_t> PackBufferInfo::s_packed_bytes{0};
+
+
+//_____________________________________________________________________________
+//
+PackedBuffer::PackedBuffer( int bytes )
+  : m_buffer((void*)poolAllocate(bytes))
+  , m_buffer_size(bytes)
+{
+}
+
+//_____________________________________________________________________________
+//
+PackedBuffer::~PackedBuffer()
+{
+  poolRelease((char*)m_buffer, m_buffer_size);
+  m_buffer = nullptr;
+}
 
 
 //_____________________________________________________________________________
@@ -60,14 +163,7 @@ PackBufferInfo::get_type( void         *& out_buf
 {
   ASSERT(count() > 0);
   if (!m_have_datatype) {
-    int packed_size;
-    int total_packed_size = 0;
-    for (unsigned int i = 0; i < m_start_bufs.size(); i++) {
-      if (m_counts[i] > 0) {
-        Uintah::MPI::Pack_size(m_counts[i], m_datatypes[i], comm, &packed_size);
-        total_packed_size += packed_size;
-      }
-    }
+    int total_packed_size = packedSize(comm);
 
     m_packed_buffer = scinew PackedBuffer(total_packed_size);
     m_packed_buffer->addReference();
@@ -83,6 +179,41 @@ PackBufferInfo::get_type( void         *& out_buf
   out_datatype = m_datatype;
 }
 
+//_____________________________________________________________________________
+//
+int
+PackBufferInfo::packedSize( MPI_Comm comm ) const
+{
+  int packed_size;
+  int total_packed_size = 0;
+  for (unsigned int i = 0; i < m_start_bufs.size(); i++) {
+    if (m_windows[i].m_row_bytes > 0) {
+      total_packed_size += m_windows[i].bytes();
+    }
+    else if (m_counts[i] > 0) {
+      Uintah::MPI::Pack_size(m_counts[i], m_datatypes[i], comm, &packed_size);
+      total_packed_size += packed_size;
+    }
+  }
+  return total_packed_size;
+}
+
+//_____________________________________________________________________________
+//
+void
+PackBufferInfo::usePackedBuffer( PackedBuffer * packed_buffer )
+{
+  ASSERT(!m_have_datatype);
+
+  m_packed_buffer = packed_buffer;
+  m_packed_buffer->addReference();
+
+  m_datatype = MPI_PACKED;
+  m_count = m_packed_buffer->getBufSize();
+  m_buffer = m_packed_buffer->getBuffer();
+  m_have_datatype = true;
+}
+
 //_____________________________________________________________________________
 //
 void
@@ -102,17 +233,33 @@ PackBufferInfo::pack( MPI_Comm comm, int & out_count )
 {
   ASSERT(m_have_datatype);
 
+  PackTimer pack_timer;
+
   int position = 0;
   int bufsize = m_packed_buffer->getBufSize();
   //for each buffer
   for (unsigned int i = 0; i < m_start_bufs.size(); i++) {
     //pack into a contiguous buffer
-    if (m_counts[i] > 0) {
+    const Window & w = m_windows[i];
+    if (w.m_row_bytes > 0) {
+      // strided window: one memcpy per contiguous row
+      char* dst = (char*)m_buffer + position;
+      const char* src_z = (const char*)m_start_bufs[i];
+      for (int k = 0; k < w.m_num_z; ++k, src_z += w.m_stride_z) {
+        const char* src = src_z;
+        for (int j = 0; j < w.m_num_y; ++j, src += w.m_stride_y, dst += w.m_row_bytes) {
+          memcpy(dst, src, w.m_row_bytes);
+        }
+      }
+      position += w.bytes();
+    }
+    else if (m_counts[i] > 0) {
       Uintah::MPI::Pack(m_start_bufs[i], m_counts[i], m_datatypes[i], m_buffer, bufsize, &position, comm);
     }
   }
 
   out_count = position;
+  s_packed_bytes.fetch_add(position, std::memory_order_relaxed);
 
   // When it is all packed, only the buffer necessarily needs to be kept around until after it is sent.
   delete m_send_list;
@@ -127,11 +274,25 @@ PackBufferInfo::unpack( MPI_Comm comm, MPI_Status & status )
 {
   ASSERT(m_have_datatype);
 
+  UnpackTimer unpack_timer;
+
   unsigned long bufsize = m_packed_buffer->getBufSize();
 
   int position = 0;
   for (unsigned int i = 0; i < m_start_bufs.size(); i++) {
-    if (m_counts[i] > 0) {
+    const Window & w = m_windows[i];
+    if (w.m_row_bytes > 0) {
+      const char* src = (const char*)m_buffer + position;
+      char* dst_z = (char*)m_start_bufs[i];
+      for (int k = 0; k < w.m_num_z; ++k, dst_z += w.m_stride_z) {
+        char* dst = dst_z;
+        for (int j = 0; j < w.m_num_y; ++j, dst += w.m_stride_y, src += w.m_row_bytes) {
+          memcpy(dst, src, w.m_row_bytes);
+        }
+      }
+      position += w.bytes();
+    }
+    else if (m_counts[i] > 0) {
       Uintah::MPI::Unpack(m_buffer, bufsize, &position, m_start_bufs[i], m_counts[i], m_datatypes[i], comm);
     }
   }
@@ -30,20 +30,24 @@
 #include <Core/Parallel/ProcessorGroup.h>
 #include <Core/Parallel/UintahMPI.h>
 #include <Core/Util/RefCounted.h>
+#include <Core/Util/Timers/Timers.hpp>
+
+#include <atomic>
+#include <cstdint>
 
 namespace Uintah {
 
 
+// Contiguous message buffer. Storage comes from a size-class pool (4 classes per
+// power of two, up to 4 MB, at most 256 MB retained) and is recycled when the
+// buffer is deleted, so steady-state halo exchanges do not malloc/free per message.
 class PackedBuffer : public RefCounted {
 
 public:
   
-  PackedBuffer(int bytes) : m_buffer((void*)(scinew char[bytes])), m_buffer_size(bytes) {}
+  PackedBuffer(int bytes);
 
-  ~PackedBuffer() {
-    delete[] (char*)m_buffer;
-    m_buffer = nullptr;
-  }
+  ~PackedBuffer();
 
   void * getBuffer() { return m_buffer; }
 
@@ -74,10 +78,26 @@ class PackBufferInfo : public BufferInfo {
                  , MPI_Datatype  &
                  );
 
+    // total MPI_Pack_size of all added buffers
+    int packedSize( MPI_Comm comm ) const;
+
+    // Pack into / unpack from a caller-owned buffer (e.g. a persistent one) of exactly
+    // packedSize() bytes instead of allocating one in get_type()
+    void usePackedBuffer( PackedBuffer * packed_buffer );
+
     void pack( MPI_Comm comm, int & out_count );
 
     void unpack( MPI_Comm comm, MPI_Status & status );
 
+    // Pack/unpack timers and packed byte counts, reported through RuntimeStats (TaskStats)
+    struct PackTag   {};
+    struct UnpackTag {};
+    using PackTimer   = Timers::ThreadTrip< PackTag >;
+    using UnpackTimer = Timers::ThreadTrip< UnpackTag >;
+
+    static int64_t packedBytes()      { return s_packed_bytes.load(std::memory_order_relaxed); }
+    static void    resetPackedBytes() { s_packed_bytes.store(0, std::memory_order_relaxed); }
+
     // PackBufferInfo is to be an AfterCommuncationHandler object for the
     // MPI_CommunicationRecord template in MPIScheduler.cc.  After receive
     // requests have finished, then it needs to unpack what got received.
@@ -92,6 +112,8 @@ class PackBufferInfo : public BufferInfo {
     // disable copy and assignment
     PackedBuffer * m_packed_buffer{nullptr};
 
+    static std::atomic<int64_t> s_packed_bytes;
+
     // eliminate copy, assignment and move
     PackBufferInfo( const PackBufferInfo & )            = delete;
     PackBufferInfo& operator=( const PackBufferInfo & ) = delete;
@@ -0,0 +1,181 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#ifndef CORE_PARALLEL_SHARDEDPRIORITYQUEUE_HPP
+#define CORE_PARALLEL_SHARDEDPRIORITYQUEUE_HPP
+
+#include <Core/Parallel/MasterLock.h>
+
+#include <atomic>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace Uintah {
+
+//______________________________________________________________________
+//
+// A relaxed, concurrent priority queue of pointers.
+//
+// Values are spread over a number of independently locked shards, each a
+// std::priority_queue ordered by Compare (same semantics as for
+// std::priority_queue: Compare(a, b) == true means b has priority over a).
+// pop() samples two shards and takes from the one whose top has the higher
+// priority, so concurrent threads rarely contend on the same lock while the
+// returned value is still close to the global top. With a single shard the
+// ordering is exact.
+//
+// The top of each shard is mirrored in an atomic so shards can be compared
+// without locking, hence T must be a pointer type.
+//
+template <typename T, typename Compare>
+class ShardedPriorityQueue
+{
+
+public:
+
+  explicit ShardedPriorityQueue( int num_shards = 1 )
+    : m_shards( num_shards > 0 ? num_shards : 1 )
+  {}
+
+  void push( T value )
+  {
+    Shard & shard = m_shards[pick()];
+
+    std::lock_guard<Uintah::MasterLock> shard_guard(shard.m_lock);
+    shard.m_heap.push(value);
+    shard.m_top.store(shard.m_heap.top(), std::memory_order_release);
+    m_size.fetch_add(1, std::memory_order_seq_cst);
+  }
+
+  // returns nullptr when the queue is (momentarily) empty
+  T pop()
+  {
+    const int num_shards = static_cast<int>(m_shards.size());
+
+    while (m_size.load(std::memory_order_seq_cst) > 0) {
+
+      int i = pick();
+      int j = (num_shards > 1) ? pick() : i;
+
+      T ti = m_shards[i].m_top.load(std::memory_order_acquire);
+      T tj = m_shards[j].m_top.load(std::memory_order_acquire);
+
+      int choice = -1;
+      if (ti != nullptr && tj != nullptr) {
+        choice = m_compare(ti, tj) ? j : i;
+      }
+      else if (ti != nullptr) {
+        choice = i;
+      }
+      else if (tj != nullptr) {
+        choice = j;
+      }
+
+      T value = (choice >= 0) ? tryPop(m_shards[choice]) : nullptr;
+
+      // both samples missed, sweep every shard before sampling again
+      for (int k = 0; value == nullptr && k < num_shards; ++k) {
+        value = tryPop(m_shards[k]);
+      }
+
+      if (value != nullptr) {
+        return value;
+      }
+    }
+
+    return nullptr;
+  }
+
+  int size() const
+  {
+    return m_size.load(std::memory_order_seq_cst);
+  }
+
+  bool empty() const
+  {
+    return size() == 0;
+  }
+
+  // not thread safe, call between timesteps only
+  void clear()
+  {
+    for (auto & shard : m_shards) {
+      shard.m_heap = heap_type();
+      shard.m_top.store(nullptr, std::memory_order_relaxed);
+    }
+    m_size.store(0, std::memory_order_seq_cst);
+  }
+
+
+private:
+
+  using heap_type = std::priority_queue<T, std::vector<T>, Compare>;
+
+  struct Shard {
+    Uintah::MasterLock m_lock{};
+    heap_type          m_heap{};
+    std::atomic<T>     m_top{nullptr};
+  };
+
+  T tryPop( Shard & shard )
+  {
+    if (shard.m_top.load(std::memory_order_acquire) == nullptr) {
+      return nullptr;
+    }
+
+    std::lock_guard<Uintah::MasterLock> shard_guard(shard.m_lock);
+    if (shard.m_heap.empty()) {
+      return nullptr;
+    }
+
+    T value = shard.m_heap.top();
+    shard.m_heap.pop();
+    shard.m_top.store(shard.m_heap.empty() ? nullptr : shard.m_heap.top(), std::memory_order_release);
+    m_size.fetch_sub(1, std::memory_order_seq_cst);
+
+    return value;
+  }
+
+  int pick() const
+  {
+    static thread_local std::minstd_rand t_engine{ std::random_device{}() };
+    return static_cast<int>(t_engine() % m_shards.size());
+  }
+
+  // eliminate copy, assignment and move
+  ShardedPriorityQueue( const ShardedPriorityQueue & )            = delete;
+  ShardedPriorityQueue& operator=( const ShardedPriorityQueue & ) = delete;
+  ShardedPriorityQueue( ShardedPriorityQueue && )                 = delete;
+  ShardedPriorityQueue& operator=( ShardedPriorityQueue && )      = delete;
+
+  std::vector<Shard>  m_shards;
+  std::atomic<int>    m_size{0};
+  Compare             m_compare{};
+
+};
+
+} // end namespace Uintah
+
+#endif // end CORE_PARALLEL_SHARDEDPRIORITYQUEUE_HPP
@@ -39,6 +39,7 @@
 #define UINTAH_HOMEBREW_UINTAH_PARAMS_HPP
 
 #include <Core/Grid/TaskStatus.h>
+#include <Core/Parallel/ExecutionObject.h>
 
 #include <sci_defs/cuda_defs.h>
 
@@ -101,6 +102,14 @@ public:
     return m_streams.size();
   }
 
+  const LoopTiling & getLoopTiling() const {
+    return m_loop_tiling;
+  }
+
+  void setLoopTiling(const LoopTiling & loopTiling) {
+    m_loop_tiling = loopTiling;
+  }
+
 private:
 
   void * oldTaskGpuDW{nullptr};
@@ -111,6 +120,8 @@ private:
 
   std::vector<void*> m_streams;
 
+  LoopTiling m_loop_tiling{};
+
 };
 
 } //namespace Uintah
@@ -65,6 +65,7 @@
 
 #include <Core/Exceptions/Exception.h>
 #include <Core/Exceptions/ProblemSetupException.h>
+#include <Core/Grid/Variables/GridVariableBase.h>
 #include <Core/Parallel/MasterLock.h>
 #include <Core/Parallel/ProcessorGroup.h>
 #include <Core/Util/DebugStream.h>
@@ -998,6 +999,7 @@ int main( int argc, char *argv[], char *env[] )
   }
   
   Uintah::TypeDescription::deleteAll();
+  Uintah::GridVariableBase::freeMPIWindowTypes();
 
   /*
    * Finalize MPI
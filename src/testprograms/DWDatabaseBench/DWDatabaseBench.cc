@@ -0,0 +1,139 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+// Measures DWDatabase put/get/exists throughput versus thread count.
+// Each thread works on its own patches, as concurrent tasks on different patches do.
+//
+// usage: DWDatabaseBench [max threads] [patches] [labels] [iterations]
+
+#include <CCA/Components/Schedulers/OnDemandDataWarehouse.h>
+
+#include <Core/Grid/Grid.h>
+#include <Core/Grid/Level.h>
+#include <Core/Grid/Variables/CCVariable.h>
+#include <Core/Grid/Variables/GridIterator.h>
+#include <Core/Grid/Variables/VarLabel.h>
+#include <Core/Util/Timers/Timers.hpp>
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace Uintah;
+
+int main( int argc, char** argv )
+{
+  const int max_threads = (argc > 1) ? std::atoi(argv[1]) : static_cast<int>(std::thread::hardware_concurrency());
+  const int num_patches = (argc > 2) ? std::atoi(argv[2]) : 64;
+  const int num_labels  = (argc > 3) ? std::atoi(argv[3]) : 16;
+  const int iterations  = (argc > 4) ? std::atoi(argv[4]) : 200;
+
+  // a single level with num_patches 1x1x1 patches along x
+  Grid grid;
+  grid.addLevel(Point(0, 0, 0), Vector(1, 1, 1));
+  LevelP level = grid.getLevel(0);
+
+  std::vector<const Patch*> patches;
+  for (int i = 0; i < num_patches; ++i) {
+    IntVector low(i, 0, 0);
+    IntVector high(i + 1, 1, 1);
+    level->addPatch(low, high, low, high, &grid);
+    patches.push_back(level->getPatch(i));
+  }
+
+  std::vector<VarLabel*> labels;
+  for (int i = 0; i < num_labels; ++i) {
+    std::ostringstream name;
+    name << "DWDatabaseBench_" << i;
+    labels.push_back(VarLabel::create(name.str(), CCVariable<double>::getTypeDescription()));
+  }
+
+  // all keys are known up front, as they are after the task graph is compiled
+  KeyDatabase<Patch> keyDB;
+  for (auto label : labels) {
+    for (auto patch : patches) {
+      keyDB.insert(label, 0, patch);
+    }
+  }
+  keyDB.freeze();
+
+  CCVariable<double> var;
+  var.allocate(IntVector(0, 0, 0), IntVector(1, 1, 1));
+
+  std::cout << std::setw(8) << "threads" << std::setw(16) << "ops/sec" << std::setw(12) << "speedup" << "\n";
+
+  double serial_rate = 0.0;
+  for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+
+    DWDatabase<Patch> varDB;
+    varDB.doReserve(&keyDB);
+
+    auto worker = [&]( int tid ) {
+      for (int iter = 0; iter < iterations; ++iter) {
+        for (int p = tid; p < num_patches; p += num_threads) {
+          for (auto label : labels) {
+            varDB.put(label, 0, patches[p], var.clone(), false, true);
+            if (varDB.exists(label, 0, patches[p])) {
+              CCVariable<double> tmp;
+              varDB.get(label, 0, patches[p], tmp);
+            }
+          }
+        }
+      }
+    };
+
+    Timers::Simple timer;
+    timer.start();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+      threads.emplace_back(worker, t);
+    }
+    for (auto & thread : threads) {
+      thread.join();
+    }
+
+    timer.stop();
+
+    // put + exists + get per (patch, label, iteration)
+    const double ops  = 3.0 * iterations * num_patches * num_labels;
+    const double rate = ops / timer().seconds();
+    if (num_threads == 1) {
+      serial_rate = rate;
+    }
+
+    std::cout << std::setw(8) << num_threads << std::setw(16) << std::fixed << std::setprecision(0) << rate
+              << std::setw(12) << std::setprecision(2) << rate / serial_rate << "\n";
+  }
+
+  for (auto label : labels) {
+    VarLabel::destroy(label);
+  }
+
+  return 0;
+}
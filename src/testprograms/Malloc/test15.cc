@@ -0,0 +1,194 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+//
+// Multi-threaded malloc/free stress test.  Each thread keeps a window of live
+// small objects and, every so often, swaps one with a shared slot so objects
+// are also freed by threads other than the one that allocated them.  Reports
+// throughput for 1, 2, 4, ... 64 threads (or up to argv[1] threads).
+//
+// Also checks that a thread whose first allocator call is a free of another
+// thread's object does not deadlock.
+//
+// Run with MALLOC_NO_THREAD_CACHE set to compare against the single lock path.
+//
+
+#include <Core/Malloc/Allocator.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int s_window      = 64;
+const int s_num_shared  = 256;
+const int s_ops_per_thr = 400000;
+
+std::atomic<void*> s_shared[s_num_shared];
+
+void
+worker( int id )
+{
+  void*    live[s_window] = {};
+  unsigned seed           = 12345u + 7919u * id;
+
+  for (int i = 0; i < s_ops_per_thr; i++) {
+    seed = seed * 1103515245u + 12345u;
+    int    slot = (seed >> 8) % s_window;
+    size_t size = 8 + (seed >> 16) % 497;   // the small bins
+
+    free(live[slot]);
+    live[slot] = malloc(size);
+    memset(live[slot], id, size);
+
+    // Hand every 16th object to whoever comes next...
+    if ((i & 15) == 0) {
+      int   shared = (seed >> 4) % s_num_shared;
+      void* other  = s_shared[shared].exchange(live[slot]);
+      live[slot] = other;
+    }
+  }
+
+  for (int slot = 0; slot < s_window; slot++) {
+    free(live[slot]);
+  }
+}
+
+double
+run( int nthreads )
+{
+  auto start = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < nthreads; t++) {
+    threads.emplace_back(worker, t);
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  for (int i = 0; i < s_num_shared; i++) {
+    free(s_shared[i].exchange(nullptr));
+  }
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+//______________________________________________________________________________
+// Fresh threads whose very first allocator call frees an object owned by the
+// main thread's cache, while the main thread keeps refilling and draining that
+// cache.  Hangs if a thread's cache is set up while it holds another's lock.
+void
+first_call_is_remote_free( int round )
+{
+  const int nthreads   = 16;
+  const int per_thread = 256;
+
+  std::vector<void*> objects(nthreads * per_thread);
+  for (auto& obj : objects) {
+    obj = malloc(64);
+  }
+
+  std::atomic<bool> go(false);
+  std::atomic<int>  done(0);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < nthreads; t++) {
+    threads.emplace_back([&, t]() {
+      while (!go.load()) {
+      }
+      for (int i = 0; i < per_thread; i++) {
+        free(objects[t * per_thread + i]);
+      }
+      done++;
+    });
+  }
+
+  go = true;
+  void* churn[s_window] = {};
+  for (int i = 0; done.load() < nthreads; i++) {
+    int slot = i % s_window;
+    free(churn[slot]);
+    churn[slot] = malloc(8 + (i * 37 + round) % 497);
+  }
+
+  for (auto& t : threads) {
+    t.join();
+  }
+  for (int slot = 0; slot < s_window; slot++) {
+    free(churn[slot]);
+  }
+
+}
+
+} // namespace
+
+
+int
+main( int argc, char** argv )
+{
+  int max_threads = (argc > 1) ? atoi(argv[1]) : 64;
+
+  for (int i = 0; i < s_num_shared; i++) {
+    s_shared[i] = nullptr;
+  }
+
+  for (int round = 0; round < 64; round++) {
+    first_call_is_remote_free(round);
+  }
+  printf("first call remote free: ok\n");
+
+  printf("%8s %12s %16s %12s\n", "threads", "seconds", "malloc+free/s", "speedup");
+
+  double base = 0.0;
+  for (int nthreads = 1; nthreads <= max_threads; nthreads *= 2) {
+    double secs = run(nthreads);
+    double rate = (double)nthreads * s_ops_per_thr / secs;
+    if (nthreads == 1) {
+      base = rate;
+    }
+    printf("%8d %12.4f %16.0f %12.2f\n", nthreads, secs, rate, rate / base);
+  }
+
+#if !defined( DISABLE_SCI_MALLOC )
+  // The free and inuse lists, including the thread caches, must still audit clean
+  Uintah::AuditAllocator(Uintah::default_allocator);
+
+  size_t nalloc, sizealloc, nfree, sizefree, nfillbin, nmmap, sizemmap, nmunmap, sizemunmap, highwater_alloc, highwater_mmap;
+  Uintah::GetGlobalStats(Uintah::default_allocator, nalloc, sizealloc, nfree, sizefree, nfillbin,
+                         nmmap, sizemmap, nmunmap, sizemunmap, highwater_alloc, highwater_mmap);
+
+  printf("alloc: %lu calls, free: %lu calls, fillbin: %lu calls, highwater alloc: %lu bytes\n",
+         (unsigned long)nalloc, (unsigned long)nfree, (unsigned long)nfillbin, (unsigned long)highwater_alloc);
+#endif
+
+  return 0;
+}
@@ -0,0 +1,395 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+// Compares the OpenMP loop execution strategies of LoopExecution.hpp on synthetic stencil kernels
+// shaped like the Arches scalar and pressure RHS, mass and CFL loops. They are not the Arches
+// kernels themselves, so the numbers only show how the strategies compare on that shape of loop:
+//   serial - the UintahSpaces::CPU k,j,i loop
+//   flat   - the linearized range with i,j,k recovered per cell, chunk size 1 (the LoopTiling::Flat path)
+//   tiled  - whole tiles per thread with a contiguous inner i-loop (the LoopTiling::Tiled path)
+// In a Kokkos build the flat and tiled loops are the Kokkos::OpenMP parallel_for / parallel_reduce_sum /
+// parallel_reduce_min of LoopExecution.hpp. Otherwise, as those back-ends need Kokkos, they are
+// reproduced with plain OpenMP, and without OpenMP everything runs on one thread.
+//
+// usage: StencilTilingBench [patch cells per side] [iterations] [tile i] [tile j] [tile k]
+
+#include <Core/Grid/Variables/Array3.h>
+#include <Core/Parallel/LoopExecution.hpp>
+#include <Core/Util/Timers/Timers.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#ifdef _OPENMP
+#  include <omp.h>
+#endif
+
+using namespace Uintah;
+
+namespace {
+
+#if defined(UINTAH_ENABLE_KOKKOS)
+
+template <typename Functor>
+void
+loop_for( LoopTiling const & tiling, BlockRange const & r, const Functor & functor )
+{
+  ExecutionObject<Kokkos::OpenMP, Kokkos::HostSpace> execObj;
+  execObj.setLoopTiling(tiling);
+  parallel_for(execObj, r, functor);
+}
+
+template <typename Functor>
+double
+loop_reduce_sum( LoopTiling const & tiling, BlockRange const & r, const Functor & functor )
+{
+  ExecutionObject<Kokkos::OpenMP, Kokkos::HostSpace> execObj;
+  execObj.setLoopTiling(tiling);
+  double sum = 0.0;
+  parallel_reduce_sum(execObj, r, functor, sum);
+  return sum;
+}
+
+template <typename Functor>
+double
+loop_reduce_min( LoopTiling const & tiling, BlockRange const & r, const Functor & functor )
+{
+  ExecutionObject<Kokkos::OpenMP, Kokkos::HostSpace> execObj;
+  execObj.setLoopTiling(tiling);
+  double result = 1.e300;
+  parallel_reduce_min(execObj, r, functor, result);
+  return result;
+}
+
+#else
+
+template <typename Functor>
+void
+loop_for( LoopTiling const & tiling, BlockRange const & r, const Functor & functor )
+{
+  if (tiling.strategy == LoopTiling::Tiled) {
+    const TiledRange tiles(r, tiling);
+    const int numTiles = tiles.size();
+
+#pragma omp parallel for schedule(static)
+    for (int n = 0; n < numTiles; ++n) {
+      tiles.for_each(n, functor);
+    }
+    return;
+  }
+
+  const int i_size = r.end(0) - r.begin(0);
+  const int j_size = r.end(1) - r.begin(1);
+  const int k_size = r.end(2) - r.begin(2);
+  const int numItems = i_size * j_size * k_size;
+
+#pragma omp parallel for schedule(static, 1)
+  for (int n = 0; n < numItems; ++n) {
+    const int k = n / (j_size * i_size) + r.begin(2);
+    const int j = (n / i_size) % j_size + r.begin(1);
+    const int i = n % i_size + r.begin(0);
+    functor(i, j, k);
+  }
+}
+
+template <typename Functor>
+double
+loop_reduce_sum( LoopTiling const & tiling, BlockRange const & r, const Functor & functor )
+{
+  double sum = 0.0;
+
+  if (tiling.strategy == LoopTiling::Tiled) {
+    const TiledRange tiles(r, tiling);
+    const int numTiles = tiles.size();
+
+#pragma omp parallel for schedule(static) reduction(+:sum)
+    for (int n = 0; n < numTiles; ++n) {
+      double tile_sum = 0.0;
+      tiles.for_each(n, [&](int i, int j, int k) {
+        double tmp = 0.0;
+        functor(i, j, k, tmp);
+        tile_sum += tmp;
+      });
+      sum += tile_sum;
+    }
+    return sum;
+  }
+
+  const int i_size = r.end(0) - r.begin(0);
+  const int j_size = r.end(1) - r.begin(1);
+  const int k_size = r.end(2) - r.begin(2);
+  const int numItems = i_size * j_size * k_size;
+
+#pragma omp parallel for schedule(static, 1) reduction(+:sum)
+  for (int n = 0; n < numItems; ++n) {
+    const int k = n / (j_size * i_size) + r.begin(2);
+    const int j = (n / i_size) % j_size + r.begin(1);
+    const int i = n % i_size + r.begin(0);
+    double tmp = 0.0;
+    functor(i, j, k, tmp);
+    sum += tmp;
+  }
+  return sum;
+}
+
+template <typename Functor>
+double
+loop_reduce_min( LoopTiling const & tiling, BlockRange const & r, const Functor & functor )
+{
+  double result = 1.e300;
+
+  if (tiling.strategy == LoopTiling::Tiled) {
+    const TiledRange tiles(r, tiling);
+    const int numTiles = tiles.size();
+
+#pragma omp parallel for schedule(static) reduction(min:result)
+    for (int n = 0; n < numTiles; ++n) {
+      tiles.for_each(n, [&](int i, int j, int k) {
+        double tmp;
+        functor(i, j, k, tmp);
+        result = min(tmp, result);
+      });
+    }
+    return result;
+  }
+
+  const int i_size = r.end(0) - r.begin(0);
+  const int j_size = r.end(1) - r.begin(1);
+  const int k_size = r.end(2) - r.begin(2);
+  const int numItems = i_size * j_size * k_size;
+
+#pragma omp parallel for schedule(static, 1) reduction(min:result)
+  for (int n = 0; n < numItems; ++n) {
+    const int k = n / (j_size * i_size) + r.begin(2);
+    const int j = (n / i_size) % j_size + r.begin(1);
+    const int i = n % i_size + r.begin(0);
+    double tmp;
+    functor(i, j, k, tmp);
+    result = min(tmp, result);
+  }
+  return result;
+}
+
+#endif
+
+void
+report( const std::string & kernel, const char * strategy, double seconds, double serial_seconds, long cells, int iterations )
+{
+  std::cout << std::setw(20) << kernel << std::setw(8) << strategy
+            << std::setw(16) << std::setprecision(4) << (cells * iterations) / seconds * 1.e-6
+            << std::setw(12) << std::setprecision(3) << serial_seconds / seconds << "\n";
+}
+
+int
+runBench( int argc, char** argv )
+{
+  const int n          = (argc > 1) ? std::atoi(argv[1]) : 64;
+  const int iterations = (argc > 2) ? std::atoi(argv[2]) : 20;
+
+  LoopTiling flat;
+  flat.strategy = LoopTiling::Flat;
+
+  LoopTiling tiling;
+  tiling.strategy = LoopTiling::Tiled;
+  tiling.tile[0]  = (argc > 3) ? std::atoi(argv[3]) : 0;
+  tiling.tile[1]  = (argc > 4) ? std::atoi(argv[4]) : 4;
+  tiling.tile[2]  = (argc > 5) ? std::atoi(argv[5]) : 4;
+
+  // one patch with a single layer of ghost cells
+  const IntVector low(-1, -1, -1);
+  const IntVector high(n + 1, n + 1, n + 1);
+  BlockRange range(IntVector(0, 0, 0), IntVector(n, n, n));
+  const long cells = static_cast<long>(n) * n * n;
+
+  Array3<double> phi(low, high), rhs(low, high), rho(low, high);
+  Array3<double> uVel(low, high), vVel(low, high), wVel(low, high);
+  for (int k = low.z(); k < high.z(); ++k) {
+  for (int j = low.y(); j < high.y(); ++j) {
+  for (int i = low.x(); i < high.x(); ++i) {
+    phi(i, j, k)  = std::sin(0.1 * i) * std::cos(0.1 * j) + 0.01 * k;
+    rho(i, j, k)  = 1.0 + 0.001 * (i + j + k);
+    uVel(i, j, k) = 1.0 + 0.01 * i;
+    vVel(i, j, k) = 0.5 - 0.01 * j;
+    wVel(i, j, k) = 0.25 + 0.001 * k;
+  }}}
+
+  const double dx = 1.0 / n;
+  const double D  = 1.e-3;
+  const double vol = dx * dx * dx;
+
+  // scalar diffusion, as in the Arches scalar RHS
+  auto diffusion = [&](int i, int j, int k) {
+    rhs(i, j, k) = D / (dx * dx) * (  phi(i + 1, j, k) + phi(i - 1, j, k)
+                                    + phi(i, j + 1, k) + phi(i, j - 1, k)
+                                    + phi(i, j, k + 1) + phi(i, j, k - 1)
+                                    - 6.0 * phi(i, j, k) );
+  };
+
+  // divergence of the face momentum, as in the Arches pressure RHS
+  auto pressureRHS = [&](int i, int j, int k) {
+    rhs(i, j, k) = dx * dx * (  0.5 * (rho(i + 1, j, k) + rho(i, j, k)) * uVel(i + 1, j, k) - 0.5 * (rho(i, j, k) + rho(i - 1, j, k)) * uVel(i, j, k)
+                              + 0.5 * (rho(i, j + 1, k) + rho(i, j, k)) * vVel(i, j + 1, k) - 0.5 * (rho(i, j, k) + rho(i, j - 1, k)) * vVel(i, j, k)
+                              + 0.5 * (rho(i, j, k + 1) + rho(i, j, k)) * wVel(i, j, k + 1) - 0.5 * (rho(i, j, k) + rho(i, j, k - 1)) * wVel(i, j, k) );
+  };
+
+  // total mass, parallel_reduce_sum
+  auto mass = [&](int i, int j, int k, double & m) {
+    m += rho(i, j, k) * vol;
+  };
+
+  // convective time step, parallel_reduce_min
+  auto cfl = [&](int i, int j, int k, double & dt) {
+    dt = dx / (std::abs(uVel(i, j, k)) + std::abs(vVel(i, j, k)) + std::abs(wVel(i, j, k)) + 1.e-16);
+  };
+
+#ifdef _OPENMP
+  const int threads = omp_get_max_threads();
+#else
+  const int threads = 1;
+#endif
+
+  std::cout << "patch " << n << "^3, " << threads << " threads, tile size "
+            << IntVector(tiling.tile[0], tiling.tile[1], tiling.tile[2]) << "\n";
+  std::cout << std::setw(20) << "kernel" << std::setw(8) << "loop" << std::setw(16) << "Mcells/sec" << std::setw(12) << "speedup" << "\n";
+
+  ExecutionObject<UintahSpaces::CPU, UintahSpaces::HostSpace> execObj;
+  Timers::Simple timer;
+
+  // parallel_for kernels
+  auto bench_for = [&](const std::string & name, auto & kernel) {
+    timer.reset(true);
+    for (int it = 0; it < iterations; ++it) {
+      parallel_for(execObj, range, kernel);
+    }
+    timer.stop();
+    const double serial = timer().seconds();
+    report(name, "serial", serial, serial, cells, iterations);
+
+    timer.reset(true);
+    for (int it = 0; it < iterations; ++it) {
+      loop_for(flat, range, kernel);
+    }
+    timer.stop();
+    report(name, "flat", timer().seconds(), serial, cells, iterations);
+
+    timer.reset(true);
+    for (int it = 0; it < iterations; ++it) {
+      loop_for(tiling, range, kernel);
+    }
+    timer.stop();
+    report(name, "tiled", timer().seconds(), serial, cells, iterations);
+  };
+
+  bench_for("scalar diffusion", diffusion);
+  bench_for("pressure rhs", pressureRHS);
+
+  // parallel_reduce_sum
+  {
+    double serial_sum = 0.0, flat_sum = 0.0, tiled_sum = 0.0;
+
+    timer.reset(true);
+    for (int it = 0; it < iterations; ++it) {
+      serial_sum = 0.0;
+      parallel_reduce_sum(execObj, range, mass, serial_sum);
+    }
+    timer.stop();
+    const double serial = timer().seconds();
+    report("mass (sum)", "serial", serial, serial, cells, iterations);
+
+    timer.reset(true);
+    for (int it = 0; it < iterations; ++it) {
+      flat_sum = loop_reduce_sum(flat, range, mass);
+    }
+    timer.stop();
+    report("mass (sum)", "flat", timer().seconds(), serial, cells, iterations);
+
+    timer.reset(true);
+    for (int it = 0; it < iterations; ++it) {
+      tiled_sum = loop_reduce_sum(tiling, range, mass);
+    }
+    timer.stop();
+    report("mass (sum)", "tiled", timer().seconds(), serial, cells, iterations);
+
+    if (std::abs(flat_sum - serial_sum) > 1.e-8 * std::abs(serial_sum) || std::abs(tiled_sum - serial_sum) > 1.e-8 * std::abs(serial_sum)) {
+      std::cerr << "ERROR: reduce_sum mismatch " << serial_sum << " " << flat_sum << " " << tiled_sum << "\n";
+      return 1;
+    }
+  }
+
+  // parallel_reduce_min
+  {
+    double serial_min = 1.e300, flat_min = 0.0, tiled_min = 0.0;
+
+    timer.reset(true);
+    for (int it = 0; it < iterations; ++it) {
+      serial_min = 1.e300;
+      parallel_reduce_min(execObj, range, cfl, serial_min);
+    }
+    timer.stop();
+    const double serial = timer().seconds();
+    report("cfl dt (min)", "serial", serial, serial, cells, iterations);
+
+    timer.reset(true);
+    for (int it = 0; it < iterations; ++it) {
+      flat_min = loop_reduce_min(flat, range, cfl);
+    }
+    timer.stop();
+    report("cfl dt (min)", "flat", timer().seconds(), serial, cells, iterations);
+
+    timer.reset(true);
+    for (int it = 0; it < iterations; ++it) {
+      tiled_min = loop_reduce_min(tiling, range, cfl);
+    }
+    timer.stop();
+    report("cfl dt (min)", "tiled", timer().seconds(), serial, cells, iterations);
+
+    if (flat_min != serial_min || tiled_min != serial_min) {
+      std::cerr << "ERROR: reduce_min mismatch " << serial_min << " " << flat_min << " " << tiled_min << "\n";
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+}
+
+int main( int argc, char** argv )
+{
+#if defined(UINTAH_ENABLE_KOKKOS)
+  Kokkos::initialize(argc, argv);
+#endif
+
+  const int status = runBench(argc, argv);
+
+#if defined(UINTAH_ENABLE_KOKKOS)
+  Kokkos::finalize();
+#endif
+
+  return status;
+}
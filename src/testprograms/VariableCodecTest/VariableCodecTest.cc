@@ -0,0 +1,152 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+// Round trips data through the chunked deflate codecs: chunks that span
+// several emit segments, a trailing partial element with shuffle, data
+// smaller than one chunk, and a header in the other byte order.
+//
+// usage: VariableCodecTest [threads]
+
+#include <Core/Grid/Variables/VariableCodec.h>
+#include <Core/Util/Endian.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace Uintah;
+
+namespace {
+
+// Slowly varying doubles compress well, as field data does.
+std::string makeData( size_t size )
+{
+  std::string data( size, '\0' );
+  const size_t n = size / sizeof(double);
+  for (size_t i = 0; i < n; ++i) {
+    double value = 1.0 + std::sin( i * 1.0e-4 );
+    memcpy( &data[i * sizeof(double)], &value, sizeof(double) );
+  }
+  for (size_t i = n * sizeof(double); i < size; ++i) {
+    data[i] = (char)i;
+  }
+  return data;
+}
+
+// Rewrites the header of a compressed stream in the other byte order,
+// as it would have been written on a machine of the other endianness.
+void swapHeader( std::string & compressed )
+{
+  uint64_t rawSize;
+  uint32_t fields[3];
+  memcpy( &rawSize, &compressed[0],               sizeof(rawSize) );
+  memcpy( fields,   &compressed[sizeof(rawSize)], sizeof(fields) );
+  const uint32_t numChunks = fields[2];
+
+  swapbytes( rawSize );
+  for (uint32_t & field : fields) {
+    swapbytes( field );
+  }
+  memcpy( &compressed[0],               &rawSize, sizeof(rawSize) );
+  memcpy( &compressed[sizeof(rawSize)], fields,   sizeof(fields) );
+
+  size_t pos = sizeof(rawSize) + sizeof(fields);
+  for (uint32_t c = 0; c < numChunks; ++c, pos += sizeof(uint64_t)) {
+    uint64_t chunkBytes;
+    memcpy( &chunkBytes, &compressed[pos], sizeof(chunkBytes) );
+    swapbytes( chunkBytes );
+    memcpy( &compressed[pos], &chunkBytes, sizeof(chunkBytes) );
+  }
+}
+
+// Compresses 'data' handed over in pieces of 'segmentSize' bytes and
+// checks that decompressing gives it back.
+bool roundTrip( const std::string & name
+              , const std::string & mode
+              , const std::string & data
+              ,       size_t        segmentSize
+              ,       size_t        elementSize
+              ,       bool          swapped
+              )
+{
+  const VariableCodec * codec = VariableCodec::find( mode );
+
+  std::vector<Variable::EmitSegment> segments;
+  for (size_t pos = 0; pos < data.size(); pos += segmentSize) {
+    segments.push_back( { data.data() + pos, std::min( segmentSize, data.size() - pos ) } );
+  }
+
+  std::string compressed;
+  if (!codec->compress( segments, data.size(), elementSize, compressed )) {
+    std::cout << name << ": FAILED, not compressed\n";
+    return false;
+  }
+
+  if (swapped) {
+    swapHeader( compressed );
+  }
+
+  std::string uncompressed;
+  codec->decompress( compressed.data(), compressed.size(), swapped, sizeof(void*) * 8, uncompressed );
+
+  const bool passed = ( uncompressed == data );
+  std::cout << name << ": " << ( passed ? "passed" : "FAILED" ) << " (" << data.size() << " -> " << compressed.size() << " bytes)\n";
+  return passed;
+}
+
+} // namespace
+
+int main( int argc, char** argv )
+{
+  const int threads = (argc > 1) ? std::atoi(argv[1]) : 4;
+  VariableCodec::setNumThreads( threads );
+
+  const size_t MB = 1 << 20;
+  bool passed = true;
+
+  // 3.5 chunks handed over as 300 kB segments, so chunks start and end inside segments
+  const std::string large = makeData( 3 * MB + MB / 2 );
+  passed &= roundTrip( "deflate, segments across chunks",         "deflate",         large, 300000, 8, false );
+  passed &= roundTrip( "shuffle-deflate, segments across chunks", "shuffle-deflate", large, 300000, 8, false );
+
+  // the shuffled chunk size is a multiple of 12 and the data ends 5 bytes into an element
+  const std::string ragged = makeData( 2 * MB + 12 * 1000 + 5 );
+  passed &= roundTrip( "shuffle-deflate, trailing partial element", "shuffle-deflate", ragged, 1 << 16, 12, false );
+
+  const std::string small = makeData( 10000 + 3 );
+  passed &= roundTrip( "deflate, smaller than a chunk",         "deflate",              small, small.size(), 8, false );
+  passed &= roundTrip( "shuffle-deflate, smaller than a chunk", "shuffle-deflate-fast", small, 1000,         8, false );
+
+  passed &= roundTrip( "shuffle-deflate, swapped header", "shuffle-deflate", large, 300000, 8, true );
+  passed &= roundTrip( "deflate-fast, swapped header",    "deflate-fast",    small, 4096,   8, true );
+
+  std::cout << ( passed ? "All tests passed\n" : "Some tests FAILED\n" );
+  return passed ? 0 : 1;
+}
@@ -41,7 +41,10 @@ SUBDIRS := \
         $(SRCDIR)/RegionTest              \
         $(SRCDIR)/CubeRootTest            \
         $(SRCDIR)/SFCTest                 \
-        $(SRCDIR)/PatchBVH
+        $(SRCDIR)/PatchBVH                \
+        $(SRCDIR)/DWDatabaseBench         \
+        $(SRCDIR)/StencilTilingBench      \
+        $(SRCDIR)/VariableCodecTest
 
 include $(SCIRUN_SCRIPTS)/recurse.mk
 